@@ -1,12 +1,16 @@
 #ifndef GRAPH_ANALYSIS_ALGORITHMS_HPP
 #define GRAPH_ANALYSIS_ALGORITHMS_HPP
 
+#include <vector>
+#include <stdexcept>
 #include "SharedPtr.hpp"
 
 namespace graph_analysis {
 
 class SubGraph;
 class BaseGraph;
+class Vertex;
+class Edge;
 
 /**
   * \brief Interface definition for a collection of standard algorithms
@@ -14,6 +18,8 @@ class BaseGraph;
 class Algorithms
 {
 public:
+    typedef function1<double, shared_ptr<Edge> > EdgeWeightFunction;
+
     virtual ~Algorithms() {}
 
     /**
@@ -30,6 +36,31 @@ public:
       * Test if a graph is connected
       */
     virtual bool isConnected() const { throw std::runtime_error("graph_analysis::Algorithms::isConnected has not been implemented"); }
+
+    /**
+      * Compute the length of the shortest paths from the source to all
+      * vertices (Dijkstra)
+      * \param edgeWeightFunction weight of an edge, which has to be non-negative
+      * \throw std::invalid_argument if an edge has a negative weight
+      * \return distances indexed by vertex id, where unreachable vertices
+      * have an infinite distance
+      */
+    virtual std::vector<double> computeShortestPathDistances(const shared_ptr<Vertex>& source, const EdgeWeightFunction& edgeWeightFunction) const { (void) source; (void) edgeWeightFunction; throw std::runtime_error("graph_analysis::Algorithms::computeShortestPathDistances has not been implemented"); }
+
+    /**
+      * Identify the strongly connected components
+      * \return list of components, where each component is the list of its
+      * vertices
+      */
+    virtual std::vector< std::vector< shared_ptr<Vertex> > > identifyStronglyConnectedComponents() const { throw std::runtime_error("graph_analysis::Algorithms::identifyStronglyConnectedComponents has not been implemented"); }
+
+    /**
+      * Order the vertices topologically, i.e. the source of each edge comes
+      * before its target
+      * \throw std::runtime_error if the graph contains a cycle
+      * \return vertices in topological order
+      */
+    virtual std::vector< shared_ptr<Vertex> > topologicalSort() const { throw std::runtime_error("graph_analysis::Algorithms::topologicalSort has not been implemented"); }
 };
 
 } // end namespace graph_analysis
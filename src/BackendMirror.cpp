@@ -0,0 +1,128 @@
+#include "BackendMirror.hpp"
+
+namespace graph_analysis {
+
+BackendMirror::Ptr BackendMirror::getInstance(const BaseGraph::Ptr& graph, BaseGraph::ImplementationType type)
+{
+    BackendMirror::Ptr mirror(new BackendMirror(graph, type));
+    graph->addObserver(mirror);
+    return mirror;
+}
+
+BackendMirror::BackendMirror(const BaseGraph::Ptr& graph, BaseGraph::ImplementationType type)
+    : mpGraph(graph)
+    , mImplementationType(type)
+    , mOutdated(true)
+{
+    if(isIncremental())
+    {
+        mpMirror = BaseGraph::getInstance(type);
+        mpMirror->addVertices(graph->getAllVertices());
+        mpMirror->addEdges(graph->getAllEdges());
+        mOutdated = false;
+    }
+}
+
+BackendMirror::~BackendMirror()
+{}
+
+bool BackendMirror::isIncremental() const
+{
+    return mImplementationType != BaseGraph::CSR_DIRECTED_GRAPH;
+}
+
+const BaseGraph::Ptr& BackendMirror::getMirror()
+{
+    if(mOutdated)
+    {
+        BaseGraph::Ptr graph = mpGraph.lock();
+        if(!graph)
+        {
+            throw std::runtime_error("graph_analysis::BackendMirror::getMirror: observed graph does not exist anymore");
+        }
+        // Release the outdated mirror first, so that the vertices and edges
+        // do not hold on to its associations
+        mpMirror.reset();
+        mpMirror = graph->freeze();
+        mOutdated = false;
+    }
+    return mpMirror;
+}
+
+void BackendMirror::notify(const Vertex::Ptr& vertex, const EventType& event, const GraphId& origin)
+{
+    if(!isIncremental())
+    {
+        mOutdated = true;
+        return;
+    }
+
+    switch(event)
+    {
+        case EVENT_TYPE_ADDED:
+            mpMirror->addVertex(vertex);
+            break;
+        case EVENT_TYPE_REMOVED:
+            mpMirror->removeVertex(vertex);
+            break;
+    }
+}
+
+void BackendMirror::notify(const Edge::Ptr& edge, const EventType& event, const GraphId& origin)
+{
+    if(!isIncremental())
+    {
+        mOutdated = true;
+        return;
+    }
+
+    switch(event)
+    {
+        case EVENT_TYPE_ADDED:
+            mpMirror->addEdge(edge);
+            break;
+        case EVENT_TYPE_REMOVED:
+            mpMirror->removeEdge(edge);
+            break;
+    }
+}
+
+void BackendMirror::notify(const std::vector<Vertex::Ptr>& vertices, const EventType& event, const GraphId& origin)
+{
+    if(!isIncremental())
+    {
+        mOutdated = true;
+        return;
+    }
+
+    switch(event)
+    {
+        case EVENT_TYPE_ADDED:
+            mpMirror->addVertices(vertices);
+            break;
+        case EVENT_TYPE_REMOVED:
+            mpMirror->removeVertices(vertices);
+            break;
+    }
+}
+
+void BackendMirror::notify(const std::vector<Edge::Ptr>& edges, const EventType& event, const GraphId& origin)
+{
+    if(!isIncremental())
+    {
+        mOutdated = true;
+        return;
+    }
+
+    switch(event)
+    {
+        case EVENT_TYPE_ADDED:
+            mpMirror->addEdges(edges);
+            break;
+        case EVENT_TYPE_REMOVED:
+            mpMirror->removeEdges(edges);
+            break;
+    }
+}
+
+} // end namespace graph_analysis
@@ -0,0 +1,86 @@
+#ifndef GRAPH_ANALYSIS_BACKEND_MIRROR_HPP
+#define GRAPH_ANALYSIS_BACKEND_MIRROR_HPP
+
+#include "BaseGraph.hpp"
+#include "BaseGraphObserver.hpp"
+
+namespace graph_analysis {
+
+/**
+ * \brief Shadow of a graph in another backend implementation
+ * \details The mirror contains the same vertices and edges as the observed
+ * graph, but stores them in the given backend, so that algorithms which are
+ * only available for a particular backend (e.g. algorithms::MinCostFlow for
+ * lemon) can be applied without converting the graph for each call.
+ * The mirror registers itself as observer of the graph: modifiable backends
+ * are updated incrementally, while a read-only (CSR) mirror is rebuilt on the
+ * next access after the graph has changed.
+ * The mirror itself must not be modified by the user.
+ *
+ * \verbatim
+ * Usage:
+ *
+ * BackendMirror::Ptr mirror = BackendMirror::getInstance(graph, BaseGraph::LEMON_DIRECTED_GRAPH);
+ * // modify graph vertices and edges
+ * algorithms::MinCostFlow minCostFlow(mirror->getMirror());
+ * ...
+ * graph->removeObserver(mirror);
+ *
+ * \endverbatim
+ */
+class BackendMirror : public BaseGraphObserver
+{
+public:
+    typedef shared_ptr<BackendMirror> Ptr;
+
+    /**
+     * Create a mirror of the graph and register it as observer of the graph
+     * \param graph Graph to mirror, which must not be modified concurrently
+     * while the mirror is created
+     * \param type Implementation type of the mirror
+     */
+    static BackendMirror::Ptr getInstance(const BaseGraph::Ptr& graph, BaseGraph::ImplementationType type);
+
+    virtual ~BackendMirror();
+
+    /**
+     * Get the mirror, which reflects the current state of the observed graph
+     * \throw std::runtime_error if a read-only mirror has to be rebuilt but
+     * the observed graph no longer exists
+     */
+    const BaseGraph::Ptr& getMirror();
+
+    /**
+     * Get the implementation type of the mirror
+     */
+    BaseGraph::ImplementationType getImplementationType() const { return mImplementationType; }
+
+    virtual void notify(const Vertex::Ptr& vertex, const EventType& event,
+                        const GraphId& origin);
+    virtual void notify(const Edge::Ptr& edge, const EventType& event,
+                        const GraphId& origin);
+    virtual void notify(const std::vector<Vertex::Ptr>& vertices, const EventType& event,
+                        const GraphId& origin);
+    virtual void notify(const std::vector<Edge::Ptr>& edges, const EventType& event,
+                        const GraphId& origin);
+
+protected:
+    BackendMirror(const BaseGraph::Ptr& graph, BaseGraph::ImplementationType type);
+
+    /**
+     * Check whether the mirror is updated incrementally, otherwise it is
+     * rebuilt after each modification of the observed graph
+     */
+    bool isIncremental() const;
+
+private:
+    /// Observed graph, not owned since the graph holds its observers
+    weak_ptr<BaseGraph> mpGraph;
+    BaseGraph::ImplementationType mImplementationType;
+    BaseGraph::Ptr mpMirror;
+    /// Whether a read-only mirror has to be rebuilt
+    bool mOutdated;
+};
+
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_BACKEND_MIRROR_HPP
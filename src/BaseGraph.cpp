@@ -1,19 +1,28 @@
 #include "BaseGraph.hpp"
 #include <base-logging/Logging.hpp>
+#include <algorithm>
 #include <sstream>
+#include <unordered_set>
 #include "boost_graph/DirectedGraph.hpp"
 #include "lemon/Graph.hpp"
 #include "snap/DirectedGraph.hpp"
+#include "csr/DirectedGraph.hpp"
+#include "compressed/DirectedGraph.hpp"
+#include "mapped/DirectedGraph.hpp"
 #include "MapInitializer.hpp"
+#include "utils/Parallel.hpp"
 
 namespace graph_analysis {
 
-GraphId BaseGraph::msId = 0;
+std::atomic<GraphId> BaseGraph::msId(0);
 
 std::map<BaseGraph::ImplementationType, std::string> BaseGraph::ImplementationTypeTxt = InitMap<BaseGraph::ImplementationType, std::string>
     (BOOST_DIRECTED_GRAPH, "boost_graph::DirectedGraph")
     (LEMON_DIRECTED_GRAPH, "lemon::DirectedGraph")
     (SNAP_DIRECTED_GRAPH, "snap::DirectedGraph")
+    (CSR_DIRECTED_GRAPH, "csr::DirectedGraph")
+    (COMPRESSED_DIRECTED_GRAPH, "compressed::DirectedGraph")
+    (MAPPED_DIRECTED_GRAPH, "mapped::DirectedGraph")
     ;
 
 BaseGraph::BaseGraph(ImplementationType type, bool directed)
@@ -34,6 +43,12 @@ BaseGraph::Ptr BaseGraph::getInstance(ImplementationType type)
            return BaseGraph::Ptr(new graph_analysis::lemon::DirectedGraph());
        case SNAP_DIRECTED_GRAPH:
            return BaseGraph::Ptr(new graph_analysis::snap::DirectedGraph());
+       case CSR_DIRECTED_GRAPH:
+           return BaseGraph::Ptr(new graph_analysis::csr::DirectedGraph());
+       case COMPRESSED_DIRECTED_GRAPH:
+           return BaseGraph::Ptr(new graph_analysis::compressed::DirectedGraph());
+       case MAPPED_DIRECTED_GRAPH:
+           return BaseGraph::Ptr(new graph_analysis::mapped::DirectedGraph());
        default:
            std::stringstream ss;
            ss << type;
@@ -85,52 +100,147 @@ void BaseGraph::notifyAll(const TransactionType& event)
     }
 }
 
-void BaseGraph::transactionEvent( TransactionType eventType )
+void BaseGraph::notifyAll(const IdRemapping& remapping)
 {
-   notifyAll( eventType );
+    std::set<BaseGraphObserver::Ptr>::const_iterator it;
+
+    // Call every registered observer
+    for(it = mObservers.begin(); it != mObservers.end(); ++it)
+    {
+        (*it)->notify(remapping, getId());
+    }
 }
 
-BaseGraph::Ptr BaseGraph::clone() const
+void BaseGraph::notifyAll(const std::vector<Vertex::Ptr>& vertices, const EventType& event)
 {
-    std::map<Vertex::Ptr, Vertex::Ptr> current2Clone;
+    if(vertices.empty())
+    {
+        return;
+    }
 
-    BaseGraph::Ptr g_clone = this->newInstance();
-    VertexIterator::Ptr vertexIterator = getVertexIterator();
-    while(vertexIterator->next())
+    std::set<BaseGraphObserver::Ptr>::const_iterator it;
+
+    // Call every registered observer
+    for(it = mObservers.begin(); it != mObservers.end(); ++it)
     {
-        Vertex::Ptr v = vertexIterator->current();
-        Vertex::Ptr v_clone = v->clone();
+        (*it)->notify(vertices, event, getId());
+    }
+}
 
-        g_clone->addVertex(v_clone);
-        current2Clone[v] = v_clone;
+void BaseGraph::notifyAll(const std::vector<Edge::Ptr>& edges, const EventType& event)
+{
+    if(edges.empty())
+    {
+        return;
     }
 
-    EdgeIterator::Ptr edgeIterator = getEdgeIterator();
-    while(edgeIterator->next())
+    std::set<BaseGraphObserver::Ptr>::const_iterator it;
+
+    // Call every registered observer
+    for(it = mObservers.begin(); it != mObservers.end(); ++it)
     {
-        Edge::Ptr e = edgeIterator->current();
-        Edge::Ptr e_clone = e->clone();
-        std::map<Vertex::Ptr, Vertex::Ptr>::const_iterator vit;
+        (*it)->notify(edges, event, getId());
+    }
+}
+
+void BaseGraph::transactionEvent( TransactionType eventType )
+{
+   notifyAll( eventType );
+}
+
+BaseGraph::Ptr BaseGraph::clone(bool concurrent) const
+{
+    std::vector<Vertex::Ptr> vertices = getAllVertices();
+    std::vector<Edge::Ptr> edges = getAllEdges();
+
+    // Map the ids of the vertices in this graph to the position of their
+    // clone
+    std::vector<size_t> id2Clone(getVertexIdUpperBound(), vertices.size());
+    std::vector<Vertex::Ptr> vertexClones(vertices.size());
+    // a single chunk is processed by the calling thread
+    size_t minChunkSize = concurrent ? 1024 : std::max<size_t>(1, std::max(vertices.size(), edges.size()));
+    utils::Parallel::forEachChunk(vertices.size(), [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; ++i)
+        {
+            vertexClones[i] = vertices[i]->clone();
+            id2Clone[ getVertexId(vertices[i]) ] = i;
+        }
+    }, minChunkSize);
 
-        vit = current2Clone.find(e->getSourceVertex());
-        if(vit != current2Clone.end())
+    std::vector<Edge::Ptr> edgeClones(edges.size());
+    utils::Parallel::forEachChunk(edges.size(), [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; ++i)
         {
-            e_clone->setSourceVertex(vit->second);
-        } else {
-            throw std::runtime_error("graph_analysis::BaseGraph::clone: could not find mapped source vertex -- internal error");
+            const Edge::Ptr& e = edges[i];
+            Edge::Ptr e_clone = e->clone();
+
+            size_t sourceIndex = id2Clone.at( getVertexId(e->getSourceVertex()) );
+            if(sourceIndex == vertices.size())
+            {
+                throw std::runtime_error("graph_analysis::BaseGraph::clone: could not find mapped source vertex -- internal error");
+            }
+            e_clone->setSourceVertex(vertexClones[sourceIndex]);
+
+            size_t targetIndex = id2Clone.at( getVertexId(e->getTargetVertex()) );
+            if(targetIndex == vertices.size())
+            {
+                throw std::runtime_error("graph_analysis::BaseGraph::clone: could not find mapped target vertex -- internal error");
+            }
+            e_clone->setTargetVertex(vertexClones[targetIndex]);
+
+            edgeClones[i] = e_clone;
         }
+    }, minChunkSize);
+
+    BaseGraph::Ptr g_clone = this->newInstance();
+    g_clone->addVertices(vertexClones);
+    g_clone->addEdges(edgeClones);
+    return g_clone;
+}
 
-        vit = current2Clone.find(e->getTargetVertex());
-        if(vit != current2Clone.end())
+BaseGraph::Ptr BaseGraph::freeze() const
+{
+    return BaseGraph::Ptr(new graph_analysis::csr::DirectedGraph(*this));
+}
+
+BaseGraph::Ptr BaseGraph::freeze(const std::vector<Vertex::Ptr>& vertexOrder) const
+{
+    return BaseGraph::Ptr(new graph_analysis::csr::DirectedGraph(*this, vertexOrder));
+}
+
+BaseGraph::Ptr BaseGraph::snapshot() const
+{
+    uint64_t version;
+    shared_ptr<csr::DirectedGraph::Structure> structure;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mVersionControl.mutex);
+        version = mVersionControl.version;
+        if(mVersionControl.snapshot && mVersionControl.snapshotVersion == version)
         {
-            e_clone->setTargetVertex(vit->second);
-        } else {
-            throw std::runtime_error("graph_analysis::BaseGraph::clone: could not find mapped target vertex -- internal error");
+            return mVersionControl.snapshot;
         }
-        g_clone->addEdge(e_clone);
+        structure = make_shared<csr::DirectedGraph::Structure>(*this, getAllVertices());
     }
 
-    return g_clone;
+    // The arrays and the id index are built without blocking modifications
+    BaseGraph::Ptr snapshot(new graph_analysis::csr::DirectedGraph(*structure, true));
+    structure.reset();
+
+    std::lock_guard<std::recursive_mutex> lock(mVersionControl.mutex);
+    if(mVersionControl.snapshot && mVersionControl.snapshotVersion >= version)
+    {
+        // Another reader has built this (or a newer) version meanwhile
+        if(mVersionControl.snapshotVersion == version)
+        {
+            return mVersionControl.snapshot;
+        }
+        return snapshot;
+    }
+    mVersionControl.snapshot = snapshot;
+    mVersionControl.snapshotVersion = version;
+    return snapshot;
 }
 
 BaseGraph::Ptr BaseGraph::cloneEdges() const
@@ -165,12 +275,14 @@ SubGraph::Ptr BaseGraph::getSubGraph(const Ptr& graph)
 
 GraphElementId BaseGraph::addVertex(const Vertex::Ptr& vertex)
 {
+    ModificationLock lock(mVersionControl);
     if(vertex->associated(getId()) )
     {
         throw std::runtime_error("BaseGraph: vertex already exists in this graph");
     }
 
     GraphElementId vertexId = addVertexInternal(vertex);
+    mVersionControl.vertexClassIndex.insert(*vertex, vertexId);
 
     // Call observers
     notifyAll(vertex, EVENT_TYPE_ADDED);
@@ -180,10 +292,12 @@ GraphElementId BaseGraph::addVertex(const Vertex::Ptr& vertex)
 
 void BaseGraph::removeVertex(const Vertex::Ptr& vertex)
 {
+    ModificationLock lock(mVersionControl);
     if(!vertex->associated(getId()) )
     {
         throw std::runtime_error("BaseGraph: vertex cannot be removed, since it does not exist in this graph");
     }
+    removeFromIndices(vertex);
     removeVertexInternal(vertex);
     vertex->disassociate(getId());
 
@@ -193,6 +307,7 @@ void BaseGraph::removeVertex(const Vertex::Ptr& vertex)
 
 GraphElementId BaseGraph::addEdge(const Edge::Ptr& edge)
 {
+    ModificationLock lock(mVersionControl);
     if(edge->associated(getId()))
     {
         throw std::runtime_error("BaseGraph: edge '" + edge->toString() +
@@ -234,6 +349,8 @@ GraphElementId BaseGraph::addEdge(const Edge::Ptr& edge)
     try {
         GraphElementId retVal =
             addEdgeInternal(edge, getVertexId(source), getVertexId(target));
+        mVersionControl.edgeClassIndex.insert(*edge, retVal);
+        mVersionControl.edgeIndex.insert(getVertexId(source), getVertexId(target), retVal);
 
         // Call observers
         notifyAll(edge, EVENT_TYPE_ADDED);
@@ -248,10 +365,12 @@ GraphElementId BaseGraph::addEdge(const Edge::Ptr& edge)
 
 void BaseGraph::removeEdge(const Edge::Ptr& edge)
 {
+    ModificationLock lock(mVersionControl);
     if(!edge->associated(getId()) )
     {
         throw std::runtime_error("BaseGraph: edge cannot be removed, since it does not exist in this graph");
     }
+    removeFromIndices(edge);
     removeEdgeInternal(edge);
     edge->disassociate(getId());
 
@@ -259,7 +378,363 @@ void BaseGraph::removeEdge(const Edge::Ptr& edge)
     notifyAll(edge, EVENT_TYPE_REMOVED);
 }
 
+void BaseGraph::reserve(size_t numberOfVertices, size_t numberOfEdges)
+{
+    std::lock_guard<std::recursive_mutex> lock(mVersionControl.mutex);
+    reserveInternal(numberOfVertices, numberOfEdges);
+}
+
+IdRemapping BaseGraph::compact()
+{
+    ModificationLock lock(mVersionControl);
+    IdRemapping remapping = compactInternal();
+    applyRemapping(remapping);
+    return remapping;
+}
+
+void BaseGraph::applyRemapping(const IdRemapping& remapping)
+{
+    if(!remapping.empty())
+    {
+        mVersionControl.vertexClassIndex.invalidate();
+        mVersionControl.edgeClassIndex.invalidate();
+        mVersionControl.edgeIndex.invalidate();
+        notifyAll(remapping);
+    }
+}
+
+BaseGraph::ElementRetention::ElementRetention(const BaseGraph& graph)
+    : mGraph(graph)
+{
+    mGraph.retainElements(true);
+}
+
+BaseGraph::ElementRetention::~ElementRetention()
+{
+    mGraph.retainElements(false);
+}
+
+double BaseGraph::getHoleRatio() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mVersionControl.mutex);
+    double slots = getVertexIdUpperBound() + getEdgeIdUpperBound();
+    if(slots == 0)
+    {
+        return 0.0;
+    }
+    return 1.0 - (getVertexCount() + getEdgeCount())/slots;
+}
+
+size_t BaseGraph::defragment(double holeRatioThreshold)
+{
+    ModificationLock lock(mVersionControl);
+    if(holeRatioThreshold > 0 && getHoleRatio() < holeRatioThreshold)
+    {
+        return 0;
+    }
+
+    size_t storageSize = getStorageSize();
+    applyRemapping( defragmentInternal() );
+    size_t defragmentedStorageSize = getStorageSize();
+    return storageSize > defragmentedStorageSize ? storageSize - defragmentedStorageSize : 0;
+}
+
+std::vector<GraphElementId> BaseGraph::addVertices(const std::vector<Vertex::Ptr>& vertices)
+{
+    ModificationLock lock(mVersionControl);
+    std::unordered_set<Vertex::Ptr> knownVertices;
+    std::vector<Vertex::Ptr>::const_iterator cit = vertices.begin();
+    for(; cit != vertices.end(); ++cit)
+    {
+        if((*cit)->associated(getId()) || !knownVertices.insert(*cit).second)
+        {
+            throw std::runtime_error("BaseGraph: vertex '" + (*cit)->toString() +
+                                     "' already exists in this graph");
+        }
+    }
+
+    reserveInternal(vertices.size(), 0);
+    std::vector<GraphElementId> vertexIds = addVerticesInternal(vertices);
+    for(size_t i = 0; i < vertices.size(); ++i)
+    {
+        mVersionControl.vertexClassIndex.insert(*vertices[i], vertexIds[i]);
+    }
+
+    // Call observers
+    notifyAll(vertices, EVENT_TYPE_ADDED);
+
+    return vertexIds;
+}
+
+std::vector<GraphElementId> BaseGraph::addEdges(const std::vector<Edge::Ptr>& edges)
+{
+    ModificationLock lock(mVersionControl);
+    std::vector<Vertex::Ptr> newVertices;
+    std::unordered_set<Vertex::Ptr> knownVertices;
+    std::unordered_set<Edge::Ptr> knownEdges;
+
+    std::vector<Edge::Ptr>::const_iterator cit = edges.begin();
+    for(; cit != edges.end(); ++cit)
+    {
+        const Edge::Ptr& edge = *cit;
+        if(edge->associated(getId()) || !knownEdges.insert(edge).second)
+        {
+            throw std::runtime_error("BaseGraph: edge '" + edge->toString() +
+                                     "' already exists in this graph");
+        }
+
+        Vertex::Ptr source = edge->getSourceVertex();
+        Vertex::Ptr target = edge->getTargetVertex();
+        if(!source)
+        {
+            throw std::runtime_error("BaseGraph: cannot add edge '" +
+                                     edge->toString() +
+                                     "' since it has no source vertex specified");
+        } else if(!target)
+        {
+            throw std::runtime_error("BaseGraph: cannot add edge '" +
+                                     edge->toString() +
+                                     "' since it has no target vertex specified");
+        }
+
+        if(!source->associated(getId()) && knownVertices.insert(source).second)
+        {
+            newVertices.push_back(source);
+        }
+        if(!target->associated(getId()) && knownVertices.insert(target).second)
+        {
+            newVertices.push_back(target);
+        }
+    }
+
+    reserveInternal(newVertices.size(), edges.size());
+    if(!newVertices.empty())
+    {
+        std::vector<GraphElementId> vertexIds = addVerticesInternal(newVertices);
+        for(size_t i = 0; i < newVertices.size(); ++i)
+        {
+            mVersionControl.vertexClassIndex.insert(*newVertices[i], vertexIds[i]);
+        }
+        notifyAll(newVertices, EVENT_TYPE_ADDED);
+    }
+
+    std::vector<GraphElementId> sourceVertexIds;
+    std::vector<GraphElementId> targetVertexIds;
+    sourceVertexIds.reserve(edges.size());
+    targetVertexIds.reserve(edges.size());
+    for(cit = edges.begin(); cit != edges.end(); ++cit)
+    {
+        sourceVertexIds.push_back( getVertexId((*cit)->getSourceVertex()) );
+        targetVertexIds.push_back( getVertexId((*cit)->getTargetVertex()) );
+    }
+
+    try {
+        std::vector<GraphElementId> edgeIds =
+            addEdgesInternal(edges, sourceVertexIds, targetVertexIds);
+        for(size_t i = 0; i < edges.size(); ++i)
+        {
+            mVersionControl.edgeClassIndex.insert(*edges[i], edgeIds[i]);
+            mVersionControl.edgeIndex.insert(sourceVertexIds[i], targetVertexIds[i], edgeIds[i]);
+        }
+
+        // Call observers
+        notifyAll(edges, EVENT_TYPE_ADDED);
+
+        return edgeIds;
+    } catch(...)
+    {
+        for(cit = edges.begin(); cit != edges.end(); ++cit)
+        {
+            (*cit)->disassociate(getId());
+        }
+        throw;
+    }
+}
+
+void BaseGraph::removeVertices(const std::vector<Vertex::Ptr>& vertices)
+{
+    ModificationLock lock(mVersionControl);
+    std::vector<Edge::Ptr> incidentEdges;
+    std::unordered_set<Edge::Ptr> knownEdges;
+    std::unordered_set<Vertex::Ptr> knownVertices;
+
+    std::vector<Vertex::Ptr>::const_iterator cit = vertices.begin();
+    for(; cit != vertices.end(); ++cit)
+    {
+        if(!(*cit)->associated(getId()))
+        {
+            throw std::runtime_error("BaseGraph: vertex cannot be removed, since it does not exist in this graph");
+        }
+        if(!knownVertices.insert(*cit).second)
+        {
+            throw std::runtime_error("BaseGraph: vertex '" + (*cit)->toString() +
+                                     "' cannot be removed twice");
+        }
+    }
+
+    for(cit = vertices.begin(); cit != vertices.end(); ++cit)
+    {
+        EdgeIterator::Ptr edgeIt = getEdgeIterator(*cit);
+        while(edgeIt->next())
+        {
+            const Edge::Ptr& edge = edgeIt->current();
+            if(knownEdges.insert(edge).second)
+            {
+                incidentEdges.push_back(edge);
+            }
+        }
+    }
+
+    removeEdges(incidentEdges);
+    removeUnconnectedVertices(vertices);
+}
+
+void BaseGraph::removeUnconnectedVertices(const std::vector<Vertex::Ptr>& vertices)
+{
+    std::vector<Vertex::Ptr>::const_iterator cit = vertices.begin();
+    for(; cit != vertices.end(); ++cit)
+    {
+        removeFromIndices(*cit);
+    }
+
+    removeVerticesInternal(vertices);
+
+    for(cit = vertices.begin(); cit != vertices.end(); ++cit)
+    {
+        (*cit)->disassociate(getId());
+    }
+
+    // Call observers
+    notifyAll(vertices, EVENT_TYPE_REMOVED);
+}
+
+void BaseGraph::removeEdges(const std::vector<Edge::Ptr>& edges)
+{
+    ModificationLock lock(mVersionControl);
+    std::unordered_set<Edge::Ptr> knownEdges;
+    std::vector<Edge::Ptr>::const_iterator cit = edges.begin();
+    for(; cit != edges.end(); ++cit)
+    {
+        if(!(*cit)->associated(getId()))
+        {
+            throw std::runtime_error("BaseGraph: edge cannot be removed, since it does not exist in this graph");
+        }
+        if(!knownEdges.insert(*cit).second)
+        {
+            throw std::runtime_error("BaseGraph: edge '" + (*cit)->toString() +
+                                     "' cannot be removed twice");
+        }
+    }
+
+    for(cit = edges.begin(); cit != edges.end(); ++cit)
+    {
+        removeFromIndices(*cit);
+    }
+
+    removeEdgesInternal(edges);
+
+    for(cit = edges.begin(); cit != edges.end(); ++cit)
+    {
+        (*cit)->disassociate(getId());
+    }
+
+    // Call observers
+    notifyAll(edges, EVENT_TYPE_REMOVED);
+}
+
+std::vector<GraphElementId> BaseGraph::addVerticesInternal(const std::vector<Vertex::Ptr>& vertices)
+{
+    std::vector<GraphElementId> vertexIds;
+    vertexIds.reserve(vertices.size());
+
+    std::vector<Vertex::Ptr>::const_iterator cit = vertices.begin();
+    for(; cit != vertices.end(); ++cit)
+    {
+        vertexIds.push_back( addVertexInternal(*cit) );
+    }
+    return vertexIds;
+}
+
+void BaseGraph::removeVerticesInternal(const std::vector<Vertex::Ptr>& vertices)
+{
+    std::vector<Vertex::Ptr>::const_iterator cit = vertices.begin();
+    for(; cit != vertices.end(); ++cit)
+    {
+        removeVertexInternal(*cit);
+    }
+}
+
+std::vector<GraphElementId> BaseGraph::addEdgesInternal(const std::vector<Edge::Ptr>& edges, const std::vector<GraphElementId>& sourceVertexIds, const std::vector<GraphElementId>& targetVertexIds)
+{
+    std::vector<GraphElementId> edgeIds;
+    edgeIds.reserve(edges.size());
+
+    for(size_t i = 0; i < edges.size(); ++i)
+    {
+        edgeIds.push_back( addEdgeInternal(edges[i], sourceVertexIds[i], targetVertexIds[i]) );
+    }
+    return edgeIds;
+}
+
+void BaseGraph::removeEdgesInternal(const std::vector<Edge::Ptr>& edges)
+{
+    std::vector<Edge::Ptr>::const_iterator cit = edges.begin();
+    for(; cit != edges.end(); ++cit)
+    {
+        removeEdgeInternal(*cit);
+    }
+}
+
 std::vector<Edge::Ptr> BaseGraph::getEdges(const Vertex::Ptr& source, const Vertex::Ptr& target) const
+{
+    {
+        std::lock_guard<std::recursive_mutex> lock(mVersionControl.mutex);
+        if(mVersionControl.edgeIndex.isEnabled())
+        {
+            const EdgeIndex& index = getEdgeIndex();
+            GraphElementId sourceId = getVertexId(source);
+            GraphElementId targetId = getVertexId(target);
+
+            std::vector<Edge::Ptr> edges;
+            const EdgeIndex::Ids* ids = index.find(sourceId, targetId);
+            if(ids)
+            {
+                for(size_t i = 0; i < ids->size(); ++i)
+                {
+                    edges.push_back( getEdge((*ids)[i]) );
+                }
+            }
+
+            if(isUndirected() && sourceId != targetId)
+            {
+                ids = index.find(targetId, sourceId);
+                if(ids)
+                {
+                    for(size_t i = 0; i < ids->size(); ++i)
+                    {
+                        edges.push_back( getEdge((*ids)[i]) );
+                    }
+                }
+            }
+            return edges;
+        }
+    }
+    return getEdgesInternal(source, target);
+}
+
+void BaseGraph::setEdgeIndexEnabled(bool enabled)
+{
+    std::lock_guard<std::recursive_mutex> lock(mVersionControl.mutex);
+    mVersionControl.edgeIndex.setEnabled(enabled);
+}
+
+bool BaseGraph::isEdgeIndexEnabled() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mVersionControl.mutex);
+    return mVersionControl.edgeIndex.isEnabled();
+}
+
+std::vector<Edge::Ptr> BaseGraph::getEdgesInternal(const Vertex::Ptr& source, const Vertex::Ptr& target) const
 {
     std::vector<Edge::Ptr> edges;
     EdgeIterator::Ptr edgeIt;
@@ -290,6 +765,7 @@ std::vector<Edge::Ptr> BaseGraph::getEdges(const Vertex::Ptr& source, const Vert
 
 size_t BaseGraph::removeEdges(const Vertex::Ptr& a, const Vertex::Ptr& b)
 {
+    ModificationLock lock(mVersionControl);
     size_t numberOfEdges = 0;
 
     std::vector<Edge::Ptr> edgesAB = getEdges(a, b);
@@ -336,6 +812,101 @@ std::vector<Edge::Ptr> BaseGraph::getAllEdges() const
     return edges;
 }
 
+const ClassIndex& BaseGraph::getVertexClassIndex() const
+{
+    ClassIndex& index = mVersionControl.vertexClassIndex;
+    if(!index.isValid())
+    {
+        index.setValid();
+        VertexIterator::Ptr vertexIt = getVertexIterator();
+        while(vertexIt->next())
+        {
+            const Vertex::Ptr& vertex = vertexIt->current();
+            index.insert(*vertex, getVertexId(vertex));
+        }
+    }
+    return index;
+}
+
+const ClassIndex& BaseGraph::getEdgeClassIndex() const
+{
+    ClassIndex& index = mVersionControl.edgeClassIndex;
+    if(!index.isValid())
+    {
+        index.setValid();
+        EdgeIterator::Ptr edgeIt = getEdgeIterator();
+        while(edgeIt->next())
+        {
+            const Edge::Ptr& edge = edgeIt->current();
+            index.insert(*edge, getEdgeId(edge));
+        }
+    }
+    return index;
+}
+
+const EdgeIndex& BaseGraph::getEdgeIndex() const
+{
+    EdgeIndex& index = mVersionControl.edgeIndex;
+    if(index.isEnabled() && !index.isValid())
+    {
+        index.setValid();
+        EdgeIterator::Ptr edgeIt = getEdgeIterator();
+        while(edgeIt->next())
+        {
+            const Edge::Ptr& edge = edgeIt->current();
+            index.insert(getVertexId(edge->getSourceVertex()), getVertexId(edge->getTargetVertex()), getEdgeId(edge));
+        }
+    }
+    return index;
+}
+
+void BaseGraph::removeFromIndices(const Vertex::Ptr& vertex)
+{
+    mVersionControl.vertexClassIndex.remove(*vertex, getVertexId(vertex));
+
+    // Incident edges are dropped along with the vertex
+    if(mVersionControl.edgeClassIndex.isValid() || mVersionControl.edgeIndex.isValid())
+    {
+        EdgeIterator::Ptr edgeIt = getEdgeIterator(vertex);
+        while(edgeIt->next())
+        {
+            removeFromIndices(edgeIt->current());
+        }
+    }
+}
+
+void BaseGraph::removeFromIndices(const Edge::Ptr& edge)
+{
+    GraphElementId edgeId = getEdgeId(edge);
+    mVersionControl.edgeClassIndex.remove(*edge, edgeId);
+    if(mVersionControl.edgeIndex.isValid())
+    {
+        mVersionControl.edgeIndex.remove(getVertexId(edge->getSourceVertex()), getVertexId(edge->getTargetVertex()), edgeId);
+    }
+}
+
+GraphElementId BaseGraph::getVertexIdUpperBound() const
+{
+    GraphElementId upperBound = 0;
+    VertexIterator::Ptr vertexIt = getVertexIterator();
+    while(vertexIt->next())
+    {
+        upperBound = std::max(upperBound, getVertexId(vertexIt->current()) + 1);
+    }
+    return upperBound;
+}
+
+GraphElementId BaseGraph::getEdgeIdUpperBound() const
+{
+    GraphElementId upperBound = 0;
+    EdgeIterator::Ptr edgeIt = getEdgeIterator();
+    while(edgeIt->next())
+    {
+        upperBound = std::max(upperBound, getEdgeId(edgeIt->current()) + 1);
+    }
+    return upperBound;
+}
+
 bool BaseGraph::contains(const Edge::Ptr& edge) const
 {
     try {
@@ -361,6 +932,28 @@ bool BaseGraph::contains(const Vertex::Ptr& vertex) const
 /**
  * Apply filters to base graph
  */
+bool BaseGraph::getVertexIdsByClass(std::vector< std::vector<GraphElementId> >& idsByClass) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mVersionControl.mutex);
+    const ClassIndex& classIndex = mVersionControl.vertexClassIndex;
+    if(!classIndex.isValid())
+    {
+        return false;
+    }
+
+    idsByClass.clear();
+    idsByClass.reserve(classIndex.getClasses().size());
+    ClassIndex::Classes::const_iterator cit = classIndex.getClasses().begin();
+    for(; cit != classIndex.getClasses().end(); ++cit)
+    {
+        if(!cit->second.empty())
+        {
+            idsByClass.push_back( std::vector<GraphElementId>(cit->second.begin(), cit->second.end()) );
+        }
+    }
+    return true;
+}
+
 SubGraph::Ptr BaseGraph::applyFilters(const BaseGraph::Ptr& graph, const Filter<Vertex::Ptr>::Ptr& vertexFilter, const Filter<Edge::Ptr>::Ptr& edgeFilter)
 {
     LOG_DEBUG_S << "Applying filters";
@@ -374,27 +967,9 @@ SubGraph::Ptr BaseGraph::applyFilters(const BaseGraph::Ptr& graph, const Filter<
 
 void BaseGraph::clear()
 {
-    while(true)
-    {
-        EdgeIterator::Ptr edgeIterator = getEdgeIterator();
-        if(edgeIterator->next())
-        {
-            removeEdge(edgeIterator->current());
-        } else {
-            break;
-        }
-    }
-
-    while(true)
-    {
-        VertexIterator::Ptr vertexIterator = getVertexIterator();
-        if(vertexIterator->next())
-        {
-            removeVertex(vertexIterator->current());
-        } else {
-            break;
-        }
-    }
+    ModificationLock lock(mVersionControl);
+    removeEdges( getAllEdges() );
+    removeUnconnectedVertices( getAllVertices() );
 }
 
 bool BaseGraph::empty() const
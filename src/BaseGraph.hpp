@@ -2,6 +2,8 @@
 #define GRAPH_ANALYSIS_BASE_GRAPH_HPP
 
 #include <set>
+#include <mutex>
+#include <atomic>
 #include "SharedPtr.hpp"
 #include "EdgeIterator.hpp"
 #include "VertexIterator.hpp"
@@ -11,6 +13,8 @@
 #include "BaseIterable.hpp"
 #include "BaseGraphObserver.hpp"
 #include "HyperEdge.hpp"
+#include "ClassIndex.hpp"
+#include "EdgeIndex.hpp"
 
 /**
  * The main namespace of this library
@@ -28,7 +32,12 @@ class BaseGraph : public enable_shared_from_this<BaseGraph>, public VertexIterab
 {
 
 public:
-    enum ImplementationType { BOOST_DIRECTED_GRAPH, LEMON_DIRECTED_GRAPH, SNAP_DIRECTED_GRAPH, IMPLEMENTATION_TYPE_END };
+    /**
+     * Available graph implementations
+     * IMPLEMENTATION_TYPE_END delimits the implementations which can be
+     * modified, read-only implementations are listed after it
+     */
+    enum ImplementationType { BOOST_DIRECTED_GRAPH, LEMON_DIRECTED_GRAPH, SNAP_DIRECTED_GRAPH, IMPLEMENTATION_TYPE_END, CSR_DIRECTED_GRAPH, COMPRESSED_DIRECTED_GRAPH, MAPPED_DIRECTED_GRAPH };
     static std::map<ImplementationType, std::string> ImplementationTypeTxt;
 
     typedef shared_ptr<BaseGraph> Ptr;
@@ -84,14 +93,72 @@ public:
     /**
      * Clone the graph, i.e. provides a deep copy of this graph so that
      * this graph and the clone do not share any references
+     * \details Vertices and edges are cloned concurrently in chunks (see
+     * utils::Parallel) and added to the clone as a single batch each. The
+     * clone keeps the order of vertices and edges of this graph
+     * \param concurrent If true, Vertex::getClone and Edge::getClone of
+     * different elements are called concurrently, so they must not modify
+     * shared state without synchronization. Use false for element types
+     * which do not support this
      */
-    BaseGraph::Ptr clone() const;
+    BaseGraph::Ptr clone(bool concurrent = true) const;
 
     /**
      * Copy the vertices, but clone the edges of the graph
      */
     BaseGraph::Ptr cloneEdges() const;
 
+    /**
+     * Create a read-only snapshot of this graph in compressed sparse row
+     * format (see csr::DirectedGraph)
+     * The snapshot shares the vertices and edges with this graph, but uses
+     * its own dense vertex and edge ids. Later changes of this graph are not
+     * reflected by the snapshot.
+     * \return pointer to the immutable graph
+     */
+    BaseGraph::Ptr freeze() const;
+
+    /**
+     * Create a read-only snapshot of this graph in compressed sparse row
+     * format, where the vertices are numbered in the given order
+     * \details Numbering vertices which are traversed together close to
+     * each other improves the cache locality of algorithms that run on the
+     * snapshot, see algorithms::VertexOrdering for suitable orders
+     * \param vertexOrder all vertices of this graph, each listed exactly once
+     * \throw std::invalid_argument if vertexOrder is not a permutation of the
+     * vertices of this graph
+     * \return pointer to the immutable graph
+     */
+    BaseGraph::Ptr freeze(const std::vector<Vertex::Ptr>& vertexOrder) const;
+
+    /**
+     * Get a consistent read-only view of the current version of this graph
+     * \details The snapshot is a csr::DirectedGraph, which is reused as long
+     * as the graph does not change. Readers can traverse a snapshot without
+     * any locking while another thread continues to modify this graph.
+     * The snapshot of an outdated version is released, once the last reader
+     * drops its pointer and a newer snapshot has been requested.
+     *
+     * This is a copy-on-read snapshot, not a multi-version graph: the first
+     * request after a modification costs O(V+E) time and memory. Only the
+     * copy of the structure (see csr::DirectedGraph::Structure) blocks
+     * modifications, the csr arrays and the id index are built afterwards.
+     * In turn every modification of this graph acquires a (typically
+     * uncontended) lock.
+     *
+     * In contrast to freeze, vertices and edges are not associated with the
+     * snapshot (since associations of shared elements cannot be
+     * modified concurrently), the snapshot resolves ids via its own index
+     * \return pointer to the immutable graph
+     */
+    BaseGraph::Ptr snapshot() const;
+
+    /**
+     * Get the version of this graph, which is incremented with every
+     * modification
+     */
+    uint64_t getVersion() const { return mVersionControl.version; }
+
     /**
      * Allow to create an instance of the same type of graph
      */
@@ -141,7 +208,7 @@ public:
      * \brief Get the vertex id for this graph
      * \throw std::runtime_error if the vertex is not part of this graph
      */
-    GraphElementId getVertexId(const Vertex::Ptr& vertex) const { (void) vertex; return dynamic_pointer_cast<GraphElement>(vertex)->getId( getId() ); }
+    virtual GraphElementId getVertexId(const Vertex::Ptr& vertex) const { (void) vertex; return dynamic_pointer_cast<GraphElement>(vertex)->getId( getId() ); }
 
     /**
      * \brief Get the vertex by id
@@ -149,6 +216,14 @@ public:
      */
     virtual Vertex::Ptr getVertex(GraphElementId id) const { (void) id; throw std::runtime_error("graph_analysis::BaseGraph::getVertex has not been implemented"); }
 
+    /**
+     * \brief Get an upper bound for the ids of the vertices in this graph
+     * \details All vertex ids are smaller than this bound, so that it can be
+     * used to size id-indexed storage (see PropertyMap.hpp).
+     * The default implementation iterates over all vertices
+     */
+    virtual GraphElementId getVertexIdUpperBound() const;
+
     /**
      * \brief Remove vertex
      * In order to reimplement, call the base function first
@@ -175,6 +250,95 @@ public:
      */
     virtual size_t removeEdges(const Vertex::Ptr& a, const Vertex::Ptr& b);
 
+    /**
+     * \brief Reserve storage for the given number of additional vertices and
+     * edges
+     * \details This is only a hint for the underlying graph implementation,
+     * which allows to avoid reallocations when loading large graphs
+     */
+    void reserve(size_t numberOfVertices, size_t numberOfEdges);
+
+    /**
+     * \brief Renumber vertices and edges to the dense id ranges [0, order)
+     * and [0, size), keeping their relative order
+     * \details Updates the associations of all vertices and edges and
+     * notifies the observers about the remapping. Ids which are stored
+     * outside of the graph, e.g., in subgraphs or property maps, have to be
+     * translated using the remapping.
+     * \return remapping of old to new ids, which is empty if the
+     * implementation does not renumber its ids
+     */
+    IdRemapping compact();
+
+    /**
+     * \brief Get the fraction of the id ranges which is not in use, i.e.
+     * the holes which have been left by removed vertices and edges
+     * \return ratio in [0, 1]
+     */
+    double getHoleRatio() const;
+
+    /**
+     * \brief Get an estimate of the number of bytes which the implementation
+     * uses to store the graph structure
+     * \details Includes the storage which is still occupied by removed
+     * vertices and edges. The default implementation returns 0
+     */
+    virtual size_t getStorageSize() const { return 0; }
+
+    /**
+     * \brief Rebuild the storage of the implementation in iteration order, so
+     * that holes left by removed vertices and edges are reclaimed
+     * \details Vertices and edges are renumbered to dense ids, which is
+     * reported to the observers as with compact. Use the threshold to call
+     * this method periodically during workloads which remove and add many
+     * elements
+     * \param holeRatioThreshold only defragment if the hole ratio (see
+     * getHoleRatio) is at least this threshold
+     * \return number of bytes reclaimed according to getStorageSize, 0 if the
+     * graph has not been defragmented or the implementation cannot release
+     * its storage
+     */
+    size_t defragment(double holeRatioThreshold = 0.0);
+
+    /**
+     * \brief Add a list of vertices
+     * \details Vertices are added as a batch, so that observers receive only
+     * a single notification.
+     * \throws std::runtime_error if a vertex already exists in the graph or
+     * is listed more than once; in this case none of the vertices is added
+     * \return ids of the vertices within this(!) graph instance in the order
+     * of the given list
+     */
+    std::vector<GraphElementId> addVertices(const std::vector<Vertex::Ptr>& vertices);
+
+    /**
+     * \brief Add a list of edges
+     * \details Source and target vertices which are not yet part of the graph
+     * will be added (in a single batch) as well.
+     * \throws std::runtime_error if an edge already exists in the graph, is
+     * listed more than once or misses source or target vertex; in this case
+     * none of the edges is added
+     * \return ids of the edges within this(!) graph instance in the order of
+     * the given list
+     */
+    std::vector<GraphElementId> addEdges(const std::vector<Edge::Ptr>& edges);
+
+    /**
+     * \brief Remove a list of vertices
+     * \details All edges which are incident to these vertices are removed
+     * (and disassociated) as a single batch first
+     * \throws std::runtime_error if a vertex is not part of the graph or is
+     * listed more than once; in this case none of the vertices is removed
+     */
+    void removeVertices(const std::vector<Vertex::Ptr>& vertices);
+
+    /**
+     * \brief Remove a list of edges and disassociate them from this graph
+     * \throws std::runtime_error if an edge is not part of the graph or is
+     * listed more than once; in this case none of the edges is removed
+     */
+    void removeEdges(const std::vector<Edge::Ptr>& edges);
+
     /**
      * Utility function to add a hyper edge (internally handled as vertex)
      * \return id of this element
@@ -203,7 +367,15 @@ public:
      * \brief Get the edge id for this graph
      * \throw std::runtime_error if the edge is not part of this graph
      */
-    GraphElementId getEdgeId(const Edge::Ptr& edge) const { (void) edge; return dynamic_pointer_cast<GraphElement>(edge)->getId( getId() ); }
+    virtual GraphElementId getEdgeId(const Edge::Ptr& edge) const { (void) edge; return dynamic_pointer_cast<GraphElement>(edge)->getId( getId() ); }
+
+    /**
+     * \brief Get an upper bound for the ids of the edges in this graph
+     * \details All edge ids are smaller than this bound, so that it can be
+     * used to size id-indexed storage (see PropertyMap.hpp).
+     * The default implementation iterates over all edges
+     */
+    virtual GraphElementId getEdgeIdUpperBound() const;
 
     /**
      * \brief Get the edge by id
@@ -213,11 +385,30 @@ public:
 
     /**
      * \brief Get edge by given vertices
+     * \details Requires O(1) expected time if the edge index is enabled
+     * \see setEdgeIndexEnabled
      * \return List of edges that start at source and end at target for directed
      * graphs -- for undirected, return all edges
      */
     virtual std::vector<Edge::Ptr> getEdges(const Vertex::Ptr& source, const Vertex::Ptr& target) const;
 
+    /**
+     * \brief Enable or disable the index of edges by their (source, target)
+     * vertex pair
+     * \details The index speeds up getEdges(source, target) and
+     * removeEdges(a, b) for vertices with a high degree at the cost of
+     * memory and of maintaining the index on every modification of the
+     * graph. The index is disabled by default, a copy of the graph keeps
+     * the setting
+     */
+    void setEdgeIndexEnabled(bool enabled);
+
+    /**
+     * Check whether the index of edges by their (source, target) vertex pair
+     * is enabled
+     */
+    bool isEdgeIndexEnabled() const;
+
     /**
      * \brief Get edges by given vertices and return only edges of a given type
      * that end at target
@@ -244,25 +435,81 @@ public:
     /**
      * \brief Get all vertices of a given type
      * Type should be a subclass of vertex
-     * If dynamic_pointer_cast returns null pointer, object is not added
+     * \details The vertices are looked up in a per-class index, so that the
+     * cost is proportional to the number of classes and the number of
+     * returned vertices. The vertices are grouped by class and sorted by id
+     * within a class
      */
     template<typename T>
     std::vector< shared_ptr<T> > getVertices() const
     {
         std::vector< shared_ptr<T> > vertices;
-        VertexIterator::Ptr vertexIt = getVertexIterator();
-        while(vertexIt->next())
+        std::lock_guard<std::recursive_mutex> lock(mVersionControl.mutex);
+        const ClassIndex::Classes& classes = getVertexClassIndex().getClasses();
+        ClassIndex::Classes::const_iterator cit = classes.begin();
+        for(; cit != classes.end(); ++cit)
         {
-            shared_ptr<T> vertex = dynamic_pointer_cast<T>( vertexIt->current() );
-            if(vertex)
+            const ClassIndex::Ids& ids = cit->second;
+            // All elements of one class either are of the requested type or not
+            if(ids.empty() || !dynamic_pointer_cast<T>( getVertex(*ids.begin()) ))
             {
-                vertices.push_back(vertex);
+                continue;
+            }
+
+            ClassIndex::Ids::const_iterator iit = ids.begin();
+            for(; iit != ids.end(); ++iit)
+            {
+                vertices.push_back( dynamic_pointer_cast<T>( getVertex(*iit) ) );
             }
         }
 
         return vertices;
     }
 
+    /**
+     * \brief Get the ids of the vertices grouped by their class
+     * \details Only available once the class index has been built by a typed
+     * query, so that callers which fall back to iterating the vertices do
+     * not pay for building and maintaining the index
+     * \return True if the ids have been retrieved from the class index,
+     * false if the class index is not available
+     */
+    bool getVertexIdsByClass(std::vector< std::vector<GraphElementId> >& idsByClass) const;
+
+    /**
+     * \brief Get all edges of a given type
+     * Type should be a subclass of edge
+     * \details The edges are looked up in a per-class index, so that the
+     * cost is proportional to the number of classes and the number of
+     * returned edges. The edges are grouped by class and sorted by id
+     * within a class
+     */
+    template<typename T>
+    std::vector< shared_ptr<T> > getEdges() const
+    {
+        std::vector< shared_ptr<T> > edges;
+        std::lock_guard<std::recursive_mutex> lock(mVersionControl.mutex);
+        const ClassIndex::Classes& classes = getEdgeClassIndex().getClasses();
+        ClassIndex::Classes::const_iterator cit = classes.begin();
+        for(; cit != classes.end(); ++cit)
+        {
+            const ClassIndex::Ids& ids = cit->second;
+            // All elements of one class either are of the requested type or not
+            if(ids.empty() || !dynamic_pointer_cast<T>( getEdge(*ids.begin()) ))
+            {
+                continue;
+            }
+
+            ClassIndex::Ids::const_iterator iit = ids.begin();
+            for(; iit != ids.end(); ++iit)
+            {
+                edges.push_back( dynamic_pointer_cast<T>( getEdge(*iit) ) );
+            }
+        }
+
+        return edges;
+    }
+
     /**
      * Get the graph id
      * \return id
@@ -361,6 +608,27 @@ public:
      */
     bool isDirected() const { return mDirected; }
 
+    /**
+     * \brief Keeps the vertices and edges, which a graph creates on demand,
+     * alive as long as the retention exists
+     * \details Graphs which hold their vertices and edges ignore it, see
+     * e.g. compressed::DirectedGraph for one which does not. Algorithms which
+     * keep references to vertices or edges beyond the lifetime of an
+     * iterator, such as BFS and DFS, retain the elements while they run
+     */
+    class ElementRetention
+    {
+    public:
+        explicit ElementRetention(const BaseGraph& graph);
+        ~ElementRetention();
+
+    private:
+        ElementRetention(const ElementRetention&);
+        ElementRetention& operator=(const ElementRetention&);
+
+        const BaseGraph& mGraph;
+    };
+
 protected:
 
     /**
@@ -393,6 +661,72 @@ protected:
      */
     virtual void removeEdgeInternal(const Edge::Ptr&) { throw std::runtime_error("BaseGraph::removeEdgeInternal: not implemented"); }
 
+    /**
+     * Reserve storage in the internal graph representation for the given
+     * number of additional vertices and edges
+     * The default implementation does nothing
+     */
+    virtual void reserveInternal(size_t numberOfVertices, size_t numberOfEdges) { (void) numberOfVertices; (void) numberOfEdges; }
+
+    /**
+     * Renumber the ids of the internal graph representation and update the
+     * associations of vertices and edges
+     * The default implementation does nothing and returns an empty remapping
+     * \return remapping of old to new ids
+     */
+    virtual IdRemapping compactInternal() { return IdRemapping(); }
+
+    /**
+     * Rebuild the internal graph representation in iteration order, so that
+     * the storage of removed vertices and edges is reclaimed
+     * The default implementation calls compactInternal
+     * \return remapping of old to new ids
+     */
+    virtual IdRemapping defragmentInternal() { return compactInternal(); }
+
+    /**
+     * Add a list of vertices to the internal graph representation
+     * The default implementation calls addVertexInternal for each vertex
+     * \return Element ids of the vertices within this graph
+     */
+    virtual std::vector<GraphElementId> addVerticesInternal(const std::vector<Vertex::Ptr>& vertices);
+
+    /**
+     * Remove a list of vertices, which have no incident edges anymore, from
+     * the internal graph representation
+     * The default implementation calls removeVertexInternal for each vertex
+     */
+    virtual void removeVerticesInternal(const std::vector<Vertex::Ptr>& vertices);
+
+    /**
+     * Add a list of edges using the ids of source and target vertices on the
+     * internal graph representation
+     * The default implementation calls addEdgeInternal for each edge
+     * \return Element ids of the edges within this graph
+     */
+    virtual std::vector<GraphElementId> addEdgesInternal(const std::vector<Edge::Ptr>& edges, const std::vector<GraphElementId>& sourceVertexIds, const std::vector<GraphElementId>& targetVertexIds);
+
+    /**
+     * Remove a list of edges from the internal graph representation
+     * The default implementation calls removeEdgeInternal for each edge
+     */
+    virtual void removeEdgesInternal(const std::vector<Edge::Ptr>& edges);
+
+    /**
+     * Get the edges from source to target from the internal graph
+     * representation, when the edge index is not enabled
+     * The default implementation scans the in-edges of the target
+     */
+    virtual std::vector<Edge::Ptr> getEdgesInternal(const Vertex::Ptr& source, const Vertex::Ptr& target) const;
+
+    /**
+     * Start (retain is true) or end an ElementRetention, retentions can be
+     * nested
+     * The default implementation does nothing, since the graph holds its
+     * elements
+     */
+    virtual void retainElements(bool retain) const { (void) retain; }
+
     /**
      * Create subgraph of the given baseGraph
      * \param baseGraph BaseGraph that this subgraph is related to
@@ -403,7 +737,7 @@ private:
     /// Id of the graph
     GraphId mId;
     /// General id counter to assign unique graph ids
-    static GraphId msId;
+    static std::atomic<GraphId> msId;
     ImplementationType mImplementationType;
 
     // Graph attribute
@@ -412,10 +746,98 @@ private:
     // The current hook
     std::set<BaseGraphObserver::Ptr> mObservers;
 
+    /**
+     * Serializes modifications and the creation of snapshots
+     * A copy of a graph starts with its own (unlocked) state
+     */
+    struct VersionControl
+    {
+        VersionControl() : version(0), snapshotVersion(0) {}
+        VersionControl(const VersionControl&) : version(0), snapshotVersion(0) {}
+        VersionControl& operator=(const VersionControl&)
+        {
+            ++version;
+            vertexClassIndex.invalidate();
+            edgeClassIndex.invalidate();
+            edgeIndex.invalidate();
+            return *this;
+        }
+
+        std::recursive_mutex mutex;
+        std::atomic<uint64_t> version;
+        BaseGraph::Ptr snapshot;
+        uint64_t snapshotVersion;
+        ClassIndex vertexClassIndex;
+        ClassIndex edgeClassIndex;
+        EdgeIndex edgeIndex;
+    };
+    mutable VersionControl mVersionControl;
+
+    /**
+     * Lock the graph for the scope of a modification and increment the
+     * version
+     */
+    class ModificationLock
+    {
+    public:
+        explicit ModificationLock(VersionControl& versionControl)
+            : mLock(versionControl.mutex)
+        {
+            ++versionControl.version;
+        }
+
+    private:
+        std::lock_guard<std::recursive_mutex> mLock;
+    };
+
+    /**
+     * Get the class index of the vertices, rebuild it if it is not valid
+     * The caller has to hold the lock of the version control
+     */
+    const ClassIndex& getVertexClassIndex() const;
+
+    /**
+     * Get the class index of the edges, rebuild it if it is not valid
+     * The caller has to hold the lock of the version control
+     */
+    const ClassIndex& getEdgeClassIndex() const;
+
+    /**
+     * Get the index of edges by (source, target), rebuild it if it is
+     * enabled but not valid
+     * The caller has to hold the lock of the version control
+     */
+    const EdgeIndex& getEdgeIndex() const;
+
+    /**
+     * Remove the vertex and its incident edges from the indices
+     */
+    void removeFromIndices(const Vertex::Ptr& vertex);
+
+    /**
+     * Remove the edge from the indices
+     */
+    void removeFromIndices(const Edge::Ptr& edge);
+
     // Notification of observers
     void notifyAll(const Vertex::Ptr& vertex, const EventType& event);
     void notifyAll(const Edge::Ptr& edge, const EventType& event);
     void notifyAll(const TransactionType& event);
+    void notifyAll(const IdRemapping& remapping);
+
+    /**
+     * Invalidate the indices and notify the observers after vertices and
+     * edges have been renumbered
+     */
+    void applyRemapping(const IdRemapping& remapping);
+    void notifyAll(const std::vector<Vertex::Ptr>& vertices, const EventType& event);
+    void notifyAll(const std::vector<Edge::Ptr>& edges, const EventType& event);
+
+    /**
+     * Remove vertices, which have no incident edges (anymore), disassociate
+     * and notify observers
+     */
+    void removeUnconnectedVertices(const std::vector<Vertex::Ptr>& vertices);
 };
 
 } // end namespace graph_analysis
@@ -1,8 +1,10 @@
 #ifndef GRAPH_ANALYSIS_BASE_GRAPH_OBSERVER_HPP
 #define GRAPH_ANALYSIS_BASE_GRAPH_OBSERVER_HPP
 
+#include <vector>
 #include "Edge.hpp"
 #include "Vertex.hpp"
+#include "IdRemapping.hpp"
 
 namespace graph_analysis
 {
@@ -52,11 +54,49 @@ public:
         throw std::runtime_error(
             "BaseGraphObserver::notify(Edge) not implemented");
     };
+    /**
+     * Notification about a batch of vertices, e.g., when using
+     * BaseGraph::addVertices
+     * The default implementation forwards each vertex to
+     * notify(const Vertex::Ptr&, ...)
+     */
+    virtual void notify(const std::vector<Vertex::Ptr>& vertices, const EventType& event,
+                        const GraphId& origin)
+    {
+        std::vector<Vertex::Ptr>::const_iterator cit = vertices.begin();
+        for(; cit != vertices.end(); ++cit)
+        {
+            notify(*cit, event, origin);
+        }
+    };
+    /**
+     * Notification about a batch of edges, e.g., when using
+     * BaseGraph::addEdges
+     * The default implementation forwards each edge to
+     * notify(const Edge::Ptr&, ...)
+     */
+    virtual void notify(const std::vector<Edge::Ptr>& edges, const EventType& event,
+                        const GraphId& origin)
+    {
+        std::vector<Edge::Ptr>::const_iterator cit = edges.begin();
+        for(; cit != edges.end(); ++cit)
+        {
+            notify(*cit, event, origin);
+        }
+    };
     virtual void notify( const TransactionType& event, const GraphId& origin )
     {
         // does not need to throw if not implemented
         // this is also to keep backwards compatibility
     };
+    /**
+     * Notification about renumbered vertex and edge ids, see
+     * BaseGraph::compact
+     */
+    virtual void notify( const IdRemapping& remapping, const GraphId& origin )
+    {
+        // does not need to throw if not implemented
+    };
 };
 }
 #endif
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <vector>
+#include "SharedPtr.hpp"
+
 namespace graph_analysis
 {
 
@@ -28,6 +31,44 @@ class BaseIterable
     {
     }
 
+    /*
+     * Number of elements which are retrieved from the underlying iterator
+     * by the first call of nextBatch(), the batch doubles with each full
+     * refill up to MaxBatchSize, so that short loops stay cheap
+     */
+    static const size_t InitialBatchSize = 16;
+    static const size_t MaxBatchSize = 256;
+
+    /*
+     * Elements of the current batch, shared between copies of an Iterator
+     * in the same way the underlying iterator is
+     */
+    struct Batch
+    {
+        Batch()
+            : position(0)
+            , size(0)
+            , elements(InitialBatchSize)
+        {
+        }
+
+        /*
+         * Retrieve the next elements from the underlying iterator
+         */
+        void refill(const T& it)
+        {
+            if (size == elements.size() && size < MaxBatchSize) {
+                elements.resize(2 * size < MaxBatchSize ? 2 * size : static_cast<size_t>(MaxBatchSize));
+            }
+            position = 0;
+            size = it->nextBatch(&elements[0], elements.size());
+        }
+
+        size_t position;
+        size_t size;
+        std::vector<E> elements;
+    };
+
     /*
      * Helper class which provides the actual stl-like pointer.
      * It normally only get's constructed by the BaseIterable class
@@ -36,11 +77,12 @@ class BaseIterable
     class Iterator
     {
        public:
-        Iterator(BaseIterable *parent, T _obj)
+        Iterator(BaseIterable *parent, T _obj, const shared_ptr<Batch>& _batch = shared_ptr<Batch>())
             : parent(parent)
             , obj(_obj)
+            , batch(_batch)
         {
-            if (obj.get() && !obj->current()) {
+            if (obj.get() && (!batch || batch->size == 0)) {
                 obj.reset();
             }
         }
@@ -66,8 +108,11 @@ class BaseIterable
 
         Iterator &operator++()
         {
-            if (!obj->next()) {
-                obj.reset();
+            if (++batch->position == batch->size) {
+                batch->refill(obj);
+                if (batch->size == 0) {
+                    obj.reset();
+                }
             }
             return *this;
         }
@@ -81,26 +126,29 @@ class BaseIterable
 
         E operator*() const
         {
-            return obj->current();
+            return batch->elements[batch->position];
         }
 
        private:
         BaseIterable *parent;
         T obj;
+        shared_ptr<Batch> batch;
     };
 
    public:
     /* Created the Interator which points to the first element
-     * If no element can be generated (e.G. next() from the baseclass false
-     * it returns end() instead
+     * If no element can be generated (e.G. nextBatch() from the baseclass
+     * returns no element) it returns end() instead
      */
     Iterator begin()
     {
         T it = (graph->*func)();
-        if (!it->next()) {
+        shared_ptr<Batch> batch(new Batch());
+        batch->refill(it);
+        if (batch->size == 0) {
             return end();
         }
-        return Iterator(this, it);
+        return Iterator(this, it, batch);
     }
     /*
      * This functions returns a Iterator where the Pointer to the
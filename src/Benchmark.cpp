@@ -1,4 +1,6 @@
 #include <iostream>
+#include <fstream>
+#include <unistd.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/filesystem.hpp>
@@ -8,6 +10,18 @@
 #include "lemon/Graph.hpp"
 #include "snap/Graph.hpp"
 
+/**
+ * Get the resident memory of this process in bytes
+ */
+long getResidentMemory()
+{
+    long pages = 0;
+    long residentPages = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> residentPages;
+    return residentPages * sysconf(_SC_PAGESIZE);
+}
+
 struct Benchmark
 {
     Benchmark(const std::string& _label)
@@ -20,25 +34,35 @@ struct Benchmark
     int numberOfEdges;
 
     numeric::Stats<double> addNodesStats;
+    numeric::Stats<double> addNodesBulkStats;
     numeric::Stats<double> getNodesStats;
     numeric::Stats<double> iterateNodesStats;
     numeric::Stats<double> iterateStlNodesStats;
 
     numeric::Stats<double> addEdgesStats;
+    numeric::Stats<double> addEdgesBulkStats;
     numeric::Stats<double> getEdgesStats;
     numeric::Stats<double> iterateEdgesStats;
     numeric::Stats<double> iterateStlEdgesStats;
 
+    numeric::Stats<double> memoryPerNodeStats;
+    numeric::Stats<double> memoryPerEdgeStats;
+
     const numeric::Stats<double>& getAddNodesStats() const { return addNodesStats; }
+    const numeric::Stats<double>& getAddNodesBulkStats() const { return addNodesBulkStats; }
     const numeric::Stats<double>& getGetNodesStats() const { return getNodesStats; }
     const numeric::Stats<double>& getIterateNodesStats() const { return iterateNodesStats; }
     const numeric::Stats<double>& getIterateStlNodesStats() const { return iterateNodesStats; }
 
     const numeric::Stats<double>& getAddEdgesStats() const { return addEdgesStats; }
+    const numeric::Stats<double>& getAddEdgesBulkStats() const { return addEdgesBulkStats; }
     const numeric::Stats<double>& getGetEdgesStats() const { return getEdgesStats; }
     const numeric::Stats<double>& getIterateEdgesStats() const { return iterateEdgesStats; }
     const numeric::Stats<double>& getIterateStlEdgesStats() const { return iterateStlEdgesStats; }
 
+    const numeric::Stats<double>& getMemoryPerNodeStats() const { return memoryPerNodeStats; }
+    const numeric::Stats<double>& getMemoryPerEdgeStats() const { return memoryPerEdgeStats; }
+
     std::string getReport() const
     {
         std::stringstream ss;
@@ -46,13 +70,17 @@ struct Benchmark
         ss << "    number of nodes:    " << numberOfNodes << std::endl;
         ss << "    number of edges:    " << numberOfEdges << std::endl;
         ss << "    add     (p node):   " << addNodesStats.mean() << " s +/-" << addNodesStats.stdev() << std::endl;
+        ss << "    add bulk (p node):  " << addNodesBulkStats.mean() << "+/-" << addNodesBulkStats.stdev() << " s" << std::endl;
         ss << "    get     (p node):   " << getNodesStats.mean() << "+/-" << getNodesStats.stdev() << " s" << std::endl;
         ss << "    add     (p edge):   " << addEdgesStats.mean() << "+/-" << addEdgesStats.stdev() <<" s" << std::endl;
+        ss << "    add bulk (p edge):  " << addEdgesBulkStats.mean() << "+/-" << addEdgesBulkStats.stdev() << " s" << std::endl;
         ss << "    get edges (p node): " << getEdgesStats.mean() << "+/-" << getEdgesStats.mean() <<" s" << std::endl;
         ss << "    iterate (p node):   " << iterateNodesStats.mean() << "+/-" << iterateNodesStats.stdev() <<" s" << std::endl;
         ss << "    iterate (p edge):   " << iterateEdgesStats.mean() << "+/-" << iterateEdgesStats.stdev() << " s" << std::endl;
         ss << "stl iterate (p node):   " << iterateStlNodesStats.mean() << "+/-" << iterateStlNodesStats.stdev() <<" s" << std::endl;
         ss << "stl iterate (p edge):   " << iterateStlEdgesStats.mean() << "+/-" << iterateStlEdgesStats.stdev() << " s" << std::endl;
+        ss << "    memory  (p node):   " << memoryPerNodeStats.mean() << "+/-" << memoryPerNodeStats.stdev() << " bytes" << std::endl;
+        ss << "    memory  (p edge):   " << memoryPerEdgeStats.mean() << "+/-" << memoryPerEdgeStats.stdev() << " bytes" << std::endl;
         return ss.str();
     }
 
@@ -61,15 +89,20 @@ struct Benchmark
 
         std::ios_base::openmode mode = std::ofstream::out | std::ofstream::app;
         std::ofstream file_addNodes    (getLogFilename(logDir,label,"addNodes").c_str(), mode );
+        std::ofstream file_addNodesBulk(getLogFilename(logDir,label,"addNodesBulk").c_str(), mode );
         std::ofstream file_getNodes    (getLogFilename(logDir,label,"getNodes").c_str(), mode );
         std::ofstream file_iterateNodes(getLogFilename(logDir,label,"iterateNodes").c_str(), mode);
         std::ofstream file_iterateStlNodes(getLogFilename(logDir,label,"iterateStlNodes").c_str(), mode);
 
         std::ofstream file_addEdges    (getLogFilename(logDir,label,"addEdges").c_str(), mode);
+        std::ofstream file_addEdgesBulk(getLogFilename(logDir,label,"addEdgesBulk").c_str(), mode);
         std::ofstream file_getEdges    (getLogFilename(logDir,label,"getEdges").c_str(), mode);
         std::ofstream file_iterateEdges(getLogFilename(logDir,label,"iterateEdges").c_str(), mode);
         std::ofstream file_iterateStlEdges(getLogFilename(logDir,label,"iterateStlEdges").c_str(), mode);
 
+        std::ofstream file_memoryNodes (getLogFilename(logDir,label,"memoryNodes").c_str(), mode);
+        std::ofstream file_memoryEdges (getLogFilename(logDir,label,"memoryEdges").c_str(), mode);
+
         if(addNodesStats.n() > 0)
         {
             file_addNodes << numberOfNodes << " "
@@ -78,6 +111,14 @@ struct Benchmark
                 << std::endl;
         }
 
+        if(addNodesBulkStats.n() > 0)
+        {
+            file_addNodesBulk << numberOfNodes << " "
+                << addNodesBulkStats.mean() << " "
+                << addNodesBulkStats.stdev()
+                << std::endl;
+        }
+
         if(getNodesStats.n() > 0)
         {
             file_getNodes << numberOfNodes << " "
@@ -111,6 +152,14 @@ struct Benchmark
                 << std::endl;
         }
 
+        if(addEdgesBulkStats.n() > 0)
+        {
+            file_addEdgesBulk << numberOfEdges << " "
+                << addEdgesBulkStats.mean() << " "
+                << addEdgesBulkStats.stdev()
+                << std::endl;
+        }
+
         if(getEdgesStats.n() > 0)
         {
             file_getEdges << numberOfEdges << " "
@@ -134,6 +183,22 @@ struct Benchmark
                 << iterateStlEdgesStats.stdev()
                 << std::endl;
         }
+
+        if(memoryPerNodeStats.n() > 0)
+        {
+            file_memoryNodes << numberOfNodes << " "
+                << memoryPerNodeStats.mean() << " "
+                << memoryPerNodeStats.stdev()
+                << std::endl;
+        }
+
+        if(memoryPerEdgeStats.n() > 0)
+        {
+            file_memoryEdges << numberOfEdges << " "
+                << memoryPerEdgeStats.mean() << " "
+                << memoryPerEdgeStats.stdev()
+                << std::endl;
+        }
     }
 
     static std::string getLogFilename(const std::string& dir, const std::string& prefix, const std::string& label)
@@ -178,9 +243,9 @@ int main(int argc, char** argv)
 
     // Library benchmarking
     using namespace graph_analysis;
-    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    for(int type = BaseGraph::BOOST_DIRECTED_GRAPH; type < BaseGraph::IMPLEMENTATION_TYPE_END; ++type)
     {
-        BaseGraph::Ptr graphX = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BaseGraph::Ptr graphX = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(type));
         std::string graphName = graphX->getImplementationTypeName();
 
         for (int s=1; s <= splits; ++s)
@@ -191,7 +256,7 @@ int main(int argc, char** argv)
 
             for(int e = 0; e < epochs; ++e)
             {
-                BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+                BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(type));
 
                 //std::cout << "    -- adding nodes" << std::endl;
                 start = base::Time::now();
@@ -285,6 +350,49 @@ int main(int argc, char** argv)
                 stop = base::Time::now();
                 graphMark.iterateStlEdgesStats.update((stop-start).toSeconds());
 
+                //std::cout << "    -- add nodes and edges (bulk)" << std::endl;
+                BaseGraph::Ptr bulkGraph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(type));
+                // Memory per element includes the element itself and the
+                // storage in the graph
+                long memory = getResidentMemory();
+                std::vector<Vertex::Ptr> vertices;
+                vertices.reserve(graphMark.numberOfNodes);
+                for(int i = 0; i < graphMark.numberOfNodes; ++i)
+                {
+                    vertices.push_back( make_shared<Vertex>() );
+                }
+                start = base::Time::now();
+                bulkGraph->addVertices(vertices);
+                stop = base::Time::now();
+                graphMark.addNodesBulkStats.update((stop-start).toSeconds());
+                if(graphMark.numberOfNodes > 0)
+                {
+                    graphMark.memoryPerNodeStats.update( (getResidentMemory() - memory) / static_cast<double>(graphMark.numberOfNodes) );
+                }
+
+                // Link existing vertices (if available), so that only the
+                // edges account for the memory
+                memory = getResidentMemory();
+                std::vector<Edge::Ptr> edges;
+                edges.reserve(graphMark.numberOfEdges);
+                for(int i = 0; i < graphMark.numberOfEdges; ++i)
+                {
+                    if(vertices.empty())
+                    {
+                        edges.push_back( make_shared<Edge>(make_shared<Vertex>(), make_shared<Vertex>()) );
+                    } else {
+                        edges.push_back( make_shared<Edge>(vertices[i % vertices.size()], vertices[(i + 1) % vertices.size()]) );
+                    }
+                }
+                start = base::Time::now();
+                bulkGraph->addEdges(edges);
+                stop = base::Time::now();
+                graphMark.addEdgesBulkStats.update((stop-start).toSeconds());
+                if(graphMark.numberOfEdges > 0 && !vertices.empty())
+                {
+                    graphMark.memoryPerEdgeStats.update( (getResidentMemory() - memory) / static_cast<double>(graphMark.numberOfEdges) );
+                }
+
             } // epochs
             graphMark.save(logDir);
             benchmarks.push_back(graphMark);
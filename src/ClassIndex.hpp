@@ -0,0 +1,85 @@
+#ifndef GRAPH_ANALYSIS_CLASS_INDEX_HPP
+#define GRAPH_ANALYSIS_CLASS_INDEX_HPP
+
+#include <set>
+#include <typeinfo>
+#include <typeindex>
+#include <unordered_map>
+#include "GraphElement.hpp"
+
+namespace graph_analysis {
+
+/**
+ * \brief Index from the dynamic class of graph elements to their ids
+ * \details The index is only maintained once it has been marked valid, so
+ * that graphs which are never queried by type do not pay for its
+ * maintenance. An invalid index has to be rebuilt by the owner before it is
+ * used.
+ */
+class ClassIndex
+{
+public:
+    typedef std::set<GraphElementId> Ids;
+    typedef std::unordered_map<std::type_index, Ids> Classes;
+
+    ClassIndex()
+        : mValid(false)
+    {}
+
+    /**
+     * Check whether the index reflects the current state of the graph
+     */
+    bool isValid() const { return mValid; }
+
+    /**
+     * Drop all entries and stop maintaining the index until it is rebuilt
+     */
+    void invalidate()
+    {
+        mValid = false;
+        mClasses.clear();
+    }
+
+    /**
+     * Mark the (rebuilt) index as valid
+     */
+    void setValid() { mValid = true; }
+
+    /**
+     * Register the element with the given id
+     */
+    void insert(const GraphElement& element, GraphElementId id)
+    {
+        if(mValid)
+        {
+            mClasses[std::type_index(typeid(element))].insert(id);
+        }
+    }
+
+    /**
+     * Unregister the element with the given id
+     */
+    void remove(const GraphElement& element, GraphElementId id)
+    {
+        if(mValid)
+        {
+            Classes::iterator it = mClasses.find(std::type_index(typeid(element)));
+            if(it != mClasses.end())
+            {
+                it->second.erase(id);
+            }
+        }
+    }
+
+    /**
+     * Get the ids per class
+     */
+    const Classes& getClasses() const { return mClasses; }
+
+private:
+    bool mValid;
+    Classes mClasses;
+};
+
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_CLASS_INDEX_HPP
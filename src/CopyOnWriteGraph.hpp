@@ -0,0 +1,81 @@
+#ifndef GRAPH_ANALYSIS_COPY_ON_WRITE_GRAPH_HPP
+#define GRAPH_ANALYSIS_COPY_ON_WRITE_GRAPH_HPP
+
+#include "BaseGraph.hpp"
+
+namespace graph_analysis {
+
+/**
+ * \brief Typed graph whose underlying raw graph can be shared between copies
+ * \details A copy of the graph shares the raw graph of the original until
+ * either of them is modified. The modifying graph then detaches, i.e. it
+ * continues with a private copy of the raw graph, while the other graph
+ * keeps the original.
+ *
+ * This is a lazy copy of the whole raw graph, not a sharing of individual
+ * blocks: copying a graph still takes O(V+E), since every element has to
+ * be associated with the id of the copy, and the first modification of a
+ * shared graph copies the entire raw graph in O(V+E). Only copies which
+ * are never modified, e.g. to be read or written out, avoid copying the
+ * raw graph.
+ * Implementations have to access the raw graph through raw(), where the
+ * non-const variant detaches and thus has to be used for all modifications.
+ * The raw graph type has to be copy constructible.
+ */
+template<typename T, typename G = BaseGraph>
+class CopyOnWriteGraph : public G
+{
+public:
+    CopyOnWriteGraph(BaseGraph::ImplementationType type, bool directed = true)
+        : G(type, directed)
+        , mpGraph(new T())
+    {}
+
+    virtual ~CopyOnWriteGraph() {}
+
+    typedef T graph_t;
+
+    /**
+     * Return underlying raw graph instance for modification, the raw graph
+     * will be detached from all copies of this graph
+     */
+    graph_t& raw()
+    {
+        if(mpGraph.use_count() > 1)
+        {
+            mpGraph = shared_ptr<graph_t>(new graph_t(*mpGraph));
+            rawDetached();
+        }
+        return *mpGraph;
+    }
+
+    /**
+     * Return underlying raw graph instance, which might be shared with
+     * copies of this graph
+     */
+    const graph_t& raw() const { return *mpGraph; }
+
+    /**
+     * Check if the raw graph is shared with other graphs
+     */
+    bool isRawShared() const { return mpGraph.use_count() > 1; }
+
+protected:
+    /**
+     * Share the raw graph of another graph, to be used when constructing a
+     * copy
+     */
+    void shareRaw(const CopyOnWriteGraph& other) { mpGraph = other.mpGraph; }
+
+    /**
+     * Called after the raw graph has been replaced by a private copy, so that
+     * implementations can update references into the raw graph
+     */
+    virtual void rawDetached() {}
+
+private:
+    shared_ptr<graph_t> mpGraph;
+};
+
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_COPY_ON_WRITE_GRAPH_HPP
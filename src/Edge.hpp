@@ -53,13 +53,19 @@ public:
 
     /**
      * Get the source vertex
+     * \return reference to the source vertex, which remains valid until the
+     * source vertex is changed or the edge is destroyed; callers which keep
+     * the vertex beyond that have to copy the pointer
      */
-    Vertex::Ptr getSourceVertex() const { return mSourceVertex; }
+    const Vertex::Ptr& getSourceVertex() const { return mSourceVertex; }
 
     /**
      * Get the target vertex
+     * \return reference to the target vertex, which remains valid until the
+     * target vertex is changed or the edge is destroyed; callers which keep
+     * the vertex beyond that have to copy the pointer
      */
-    Vertex::Ptr getTargetVertex() const { return mTargetVertex; }
+    const Vertex::Ptr& getTargetVertex() const { return mTargetVertex; }
 
     /**
      * Set the source vertex
@@ -129,6 +135,8 @@ public:
 protected:
     /**
      * Get instance of an edge
+     * BaseGraph::clone calls this function concurrently for different
+     * edges, unless it is asked to clone sequentially
      */
     virtual Edge* getClone() const { return new Edge(*this); }
 
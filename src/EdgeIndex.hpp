@@ -0,0 +1,119 @@
+#ifndef GRAPH_ANALYSIS_EDGE_INDEX_HPP
+#define GRAPH_ANALYSIS_EDGE_INDEX_HPP
+
+#include <vector>
+#include <algorithm>
+#include <boost/unordered_map.hpp>
+#include "GraphElement.hpp"
+
+namespace graph_analysis {
+
+/**
+ * \brief Index from a pair of (source, target) vertex ids to the ids of the
+ * edges between them
+ * \details The index has to be enabled per graph. An enabled index which is
+ * not valid has to be rebuilt by the owner before it is used.
+ */
+class EdgeIndex
+{
+public:
+    typedef std::vector<GraphElementId> Ids;
+
+    EdgeIndex()
+        : mEnabled(false)
+        , mValid(false)
+    {}
+
+    /**
+     * Enable or disable the index, disabling drops all entries
+     */
+    void setEnabled(bool enabled)
+    {
+        mEnabled = enabled;
+        invalidate();
+    }
+
+    bool isEnabled() const { return mEnabled; }
+
+    /**
+     * Check whether the index reflects the current state of the graph
+     */
+    bool isValid() const { return mEnabled && mValid; }
+
+    /**
+     * Drop all entries, so that the index has to be rebuilt
+     */
+    void invalidate()
+    {
+        mValid = false;
+        mEdges.clear();
+    }
+
+    /**
+     * Mark the (rebuilt) index as valid
+     */
+    void setValid() { mValid = mEnabled; }
+
+    /**
+     * Register an edge
+     */
+    void insert(GraphElementId sourceId, GraphElementId targetId, GraphElementId edgeId)
+    {
+        if(isValid())
+        {
+            mEdges[Key(sourceId, targetId)].push_back(edgeId);
+        }
+    }
+
+    /**
+     * Unregister an edge
+     */
+    void remove(GraphElementId sourceId, GraphElementId targetId, GraphElementId edgeId)
+    {
+        if(!isValid())
+        {
+            return;
+        }
+
+        Edges::iterator it = mEdges.find(Key(sourceId, targetId));
+        if(it != mEdges.end())
+        {
+            Ids& ids = it->second;
+            Ids::iterator idIt = std::find(ids.begin(), ids.end(), edgeId);
+            if(idIt != ids.end())
+            {
+                *idIt = ids.back();
+                ids.pop_back();
+            }
+            if(ids.empty())
+            {
+                mEdges.erase(it);
+            }
+        }
+    }
+
+    /**
+     * Get the ids of the edges from source to target
+     * \return ids or null if there is no such edge
+     */
+    const Ids* find(GraphElementId sourceId, GraphElementId targetId) const
+    {
+        Edges::const_iterator cit = mEdges.find(Key(sourceId, targetId));
+        if(cit == mEdges.end())
+        {
+            return NULL;
+        }
+        return &cit->second;
+    }
+
+private:
+    typedef std::pair<GraphElementId, GraphElementId> Key;
+    typedef boost::unordered_map<Key, Ids> Edges;
+
+    bool mEnabled;
+    bool mValid;
+    Edges mEdges;
+};
+
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_EDGE_INDEX_HPP
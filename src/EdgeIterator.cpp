@@ -11,4 +11,23 @@ bool EdgeIterator::skip(const Edge::Ptr& edge) const
     return false;
 }
 
+bool EdgeIterator::skipId(GraphElementId id) const
+{
+    if(mIdSkipFunction)
+    {
+        return mIdSkipFunction(id);
+    }
+    return false;
+}
+
+size_t EdgeIterator::nextBatch(Edge::Ptr* out, size_t max)
+{
+    size_t count = 0;
+    while(count < max && next())
+    {
+        out[count++] = current();
+    }
+    return count;
+}
+
 } // end namespace graph_analysis
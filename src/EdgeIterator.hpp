@@ -19,6 +19,7 @@ class EdgeIterator
 public:
     typedef shared_ptr<EdgeIterator> Ptr;
     typedef function1<bool, const Edge::Ptr&> SkipFunction;
+    typedef function1<bool, GraphElementId> IdSkipFunction;
 
     virtual ~EdgeIterator() {}
 
@@ -29,6 +30,18 @@ public:
      */
     virtual bool next() { throw std::runtime_error("EdgeIterator: next() has not been implemented"); }
 
+    /**
+     * \brief Advance the iterator by up to max items at once
+     * \details Fills the given array with the next (non-skipped) items and
+     * updates current() to the last of them. Implementations which can
+     * access the underlying graph library directly should override this
+     * function to avoid the per-item call of next()
+     * \param out Array with space for at least max items
+     * \param max Maximum number of items to retrieve
+     * \return number of items written to out, 0 if the iterator is exhausted
+     */
+    virtual size_t nextBatch(Edge::Ptr* out, size_t max);
+
     /**
      * Retrieve the current edge this iterator is pointing to
      */
@@ -41,6 +54,14 @@ protected:
      */
     bool skip(const Edge::Ptr& edge) const;
 
+    /**
+     * \brief Check if the edge with the given id should be skipped
+     * \details Allows implementations which create their edges on demand to
+     * skip them before creating them, skip has to be checked as well
+     * \return True if the edge should be skipped, false otherwise
+     */
+    bool skipId(GraphElementId id) const;
+
     /**
      * \brief Set next edge
      * Should be applied by class implementing next()
@@ -53,9 +74,16 @@ protected:
      */
     void setSkipFunction(SkipFunction skipFunction) { mSkipFunction = skipFunction; }
 
+    /**
+     * Allows to set a skip function by id, which has to be consistent with
+     * the skip function
+     */
+    void setIdSkipFunction(IdSkipFunction idSkipFunction) { mIdSkipFunction = idSkipFunction; }
+
 private:
     Edge::Ptr mEdge;
     SkipFunction mSkipFunction;
+    IdSkipFunction mIdSkipFunction;
 };
 
 } // end namespace graph_analysis
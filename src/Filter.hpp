@@ -207,6 +207,37 @@ public:
      */
     virtual bool apply(FilterObject o) const { (void)o; return false; }
 
+    /**
+     * \brief Check whether the main filter(!) only depends on the class of
+     * the target object
+     * \return True, if apply returns the same result for all objects of the
+     * same class, false otherwise
+     */
+    virtual bool isClassFilter() const { return false; }
+
+    /**
+     * \brief Check whether the main filter and all children only depend on
+     * the class of the target object, so that matches has to be evaluated
+     * once per class only
+     */
+    bool dependsOnClassOnly() const
+    {
+        if(!isClassFilter())
+        {
+            return false;
+        }
+
+        typename FilterList::const_iterator cit = mFilters.begin();
+        for(; cit != mFilters.end(); ++cit)
+        {
+            if(!(*cit)->dependsOnClassOnly())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     /**
      * Return Null Filter
      */
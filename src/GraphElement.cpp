@@ -1,66 +1,298 @@
 #include "GraphElement.hpp"
 #include <limits>
+#include <algorithm>
 #include <sstream>
+#include <mutex>
 #include <boost/lexical_cast.hpp>
+#include <boost/unordered_map.hpp>
 
 namespace graph_analysis {
 
-boost::uuids::random_generator GraphElement::msUuidGenerator;
-std::map<GraphElementUuid, function<GraphElement::Ptr()> > GraphElement::msGraphElements;
+const GraphId GraphElementAssociations::InvalidGraphId = std::numeric_limits<GraphId>::max();
+
+const size_t GraphElementAssociations::InlineCapacity;
+
+const GraphElementId* GraphElementAssociations::findSlow(GraphId graph) const
+{
+    for(size_t i = 1; i < InlineCapacity; ++i)
+    {
+        if(mGraphs[i] == graph)
+        {
+            return &mElementIds[i];
+        }
+    }
+
+    std::vector< std::pair<GraphId, GraphElementId> >::const_iterator cit = mSpilled.begin();
+    for(; cit != mSpilled.end(); ++cit)
+    {
+        if(cit->first == graph)
+        {
+            return &cit->second;
+        }
+    }
+    return NULL;
+}
+
+void GraphElementAssociations::set(GraphId graph, GraphElementId elementId)
+{
+    for(size_t i = 0; i < InlineCapacity; ++i)
+    {
+        if(mGraphs[i] == graph || mGraphs[i] == InvalidGraphId)
+        {
+            mGraphs[i] = graph;
+            mElementIds[i] = elementId;
+            return;
+        }
+    }
+
+    std::vector< std::pair<GraphId, GraphElementId> >::iterator it = mSpilled.begin();
+    for(; it != mSpilled.end(); ++it)
+    {
+        if(it->first == graph)
+        {
+            it->second = elementId;
+            return;
+        }
+    }
+    mSpilled.push_back( std::make_pair(graph, elementId) );
+}
+
+void GraphElementAssociations::erase(GraphId graph)
+{
+    for(size_t i = 0; i < InlineCapacity; ++i)
+    {
+        if(mGraphs[i] != graph)
+        {
+            continue;
+        }
+
+        // Keep the inline slots filled from the front: move the following
+        // slots up and refill the last one from the spill vector
+        for(; i + 1 < InlineCapacity; ++i)
+        {
+            mGraphs[i] = mGraphs[i + 1];
+            mElementIds[i] = mElementIds[i + 1];
+        }
+        if(mSpilled.empty())
+        {
+            mGraphs[InlineCapacity - 1] = InvalidGraphId;
+        } else {
+            mGraphs[InlineCapacity - 1] = mSpilled.back().first;
+            mElementIds[InlineCapacity - 1] = mSpilled.back().second;
+            mSpilled.pop_back();
+        }
+        return;
+    }
+
+    std::vector< std::pair<GraphId, GraphElementId> >::iterator it = mSpilled.begin();
+    for(; it != mSpilled.end(); ++it)
+    {
+        if(it->first == graph)
+        {
+            *it = mSpilled.back();
+            mSpilled.pop_back();
+            return;
+        }
+    }
+}
+
+void GraphElementAssociations::clear()
+{
+    clearInline();
+    // release memory
+    std::vector< std::pair<GraphId, GraphElementId> >().swap(mSpilled);
+}
+
+void GraphElementAssociations::clearInline()
+{
+    for(size_t i = 0; i < InlineCapacity; ++i)
+    {
+        mGraphs[i] = InvalidGraphId;
+        mElementIds[i] = 0;
+    }
+}
+
+size_t GraphElementAssociations::size() const
+{
+    size_t size = mSpilled.size();
+    for(size_t i = 0; i < InlineCapacity && mGraphs[i] != InvalidGraphId; ++i)
+    {
+        ++size;
+    }
+    return size;
+}
+
+GraphIdList GraphElementAssociations::getGraphIds() const
+{
+    GraphIdList graphIds;
+    for(size_t i = 0; i < InlineCapacity && mGraphs[i] != InvalidGraphId; ++i)
+    {
+        graphIds.push_back(mGraphs[i]);
+    }
+
+    std::vector< std::pair<GraphId, GraphElementId> >::const_iterator cit = mSpilled.begin();
+    for(; cit != mSpilled.end(); ++cit)
+    {
+        graphIds.push_back(cit->first);
+    }
+    std::sort(graphIds.begin(), graphIds.end());
+    return graphIds;
+}
+
+namespace {
+
+/**
+ * The registry of graph elements is split into shards, each with its own
+ * lock, so that elements can be registered concurrently
+ */
+struct RegistryShard
+{
+    std::mutex mutex;
+    boost::unordered_map<GraphElementUuid, GraphElement::WeakPtr> elements;
+};
+
+const size_t NUMBER_OF_REGISTRY_SHARDS = 64;
+
+RegistryShard& getRegistryShard(const GraphElementUuid& uuid)
+{
+    // Intentionally never released, since elements with static storage
+    // duration might unregister after the destruction of static objects
+    static RegistryShard* shards = new RegistryShard[NUMBER_OF_REGISTRY_SHARDS];
+    return shards[ boost::uuids::hash_value(uuid) % NUMBER_OF_REGISTRY_SHARDS ];
+}
+
+/**
+ * Locks to serialize the lazy uuid generation per element
+ */
+std::mutex& getUuidMutex(const GraphElement* element)
+{
+    static std::mutex* mutexes = new std::mutex[NUMBER_OF_REGISTRY_SHARDS];
+    return mutexes[ (reinterpret_cast<uintptr_t>(element) / sizeof(void*)) % NUMBER_OF_REGISTRY_SHARDS ];
+}
+
+} // end anonymous namespace
 
 GraphElement::GraphElement(const std::string& label)
-    : mUuid(msUuidGenerator())
+    : mUuid(boost::uuids::nil_uuid())
+    , mUuidAssigned(false)
     , mLabel(label)
 {
-    msGraphElements[mUuid] = bind(&GraphElement::getSharedFromThis,this);
+}
+
+GraphElement::GraphElement(const GraphElement& other)
+    : enable_shared_from_this<GraphElement>(other)
+    , mGraphAssociations(other.mGraphAssociations)
+    , mUuid(boost::uuids::nil_uuid())
+    , mUuidAssigned(false)
+    , mLabel(other.mLabel)
+{
+    if(other.mUuidAssigned.load(std::memory_order_acquire))
+    {
+        mUuid = other.mUuid;
+        mUuidAssigned.store(true, std::memory_order_relaxed);
+    }
+}
+
+GraphElement& GraphElement::operator=(const GraphElement& other)
+{
+    if(this != &other)
+    {
+        mGraphAssociations = other.mGraphAssociations;
+        mLabel = other.mLabel;
+        if(other.mUuidAssigned.load(std::memory_order_acquire))
+        {
+            mUuid = other.mUuid;
+            mUuidAssigned.store(true, std::memory_order_release);
+        } else {
+            mUuidAssigned.store(false, std::memory_order_relaxed);
+            mUuid = boost::uuids::nil_uuid();
+        }
+    }
+    return *this;
 }
 
 GraphElement::~GraphElement()
 {
-    msGraphElements.erase(mUuid);
+    if(!mUuidAssigned.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    // Remove the entry only if it does not refer to a living element (with
+    // the same uuid), e.g., when a copy of this element has been destroyed
+    RegistryShard& shard = getRegistryShard(mUuid);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    boost::unordered_map<GraphElementUuid, GraphElement::WeakPtr>::iterator it = shard.elements.find(mUuid);
+    if(it != shard.elements.end() && it->second.expired())
+    {
+        shard.elements.erase(it);
+    }
+}
+
+void GraphElement::assignUuid() const
+{
+    static thread_local boost::uuids::random_generator uuidGenerator;
+
+    std::lock_guard<std::mutex> lock(getUuidMutex(this));
+    if(mUuidAssigned.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    mUuid = uuidGenerator();
+    registerUuid();
+    mUuidAssigned.store(true, std::memory_order_release);
 }
 
-/**
- * Get id of this element within a given graph
- */
-GraphElementId GraphElement::getId(GraphId graphId) const
+void GraphElement::registerUuid() const
 {
-    GraphElementMap::const_iterator cit = mGraphElementMap.find(graphId);
-    if( cit != mGraphElementMap.end())
+    GraphElement::WeakPtr element;
+    try {
+        element = const_cast<GraphElement*>(this)->shared_from_this();
+    } catch(const std::exception& e)
     {
-        return cit->second;
+        // element is not managed by a shared pointer, so it cannot be
+        // retrieved via fromUuid
+        return;
     }
 
+    RegistryShard& shard = getRegistryShard(mUuid);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.elements[mUuid] = element;
+}
+
+void GraphElement::throwNotAssociated(GraphId graphId) const
+{
     std::stringstream ss;
     ss << "GraphElement: this graph element '" << toString() << "' is not part of the given graph (id:" << graphId << ")";
     throw std::runtime_error(ss.str());
 }
 
-
 GraphElement::Ptr GraphElement::fromUuid(const GraphElementUuid& uuid)
 {
-    std::map<GraphElementUuid, function<GraphElement::Ptr()> >::iterator it = msGraphElements.find(uuid);
-    if(it != msGraphElements.end())
+    GraphElement::Ptr element;
+    {
+        RegistryShard& shard = getRegistryShard(uuid);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        boost::unordered_map<GraphElementUuid, GraphElement::WeakPtr>::const_iterator cit = shard.elements.find(uuid);
+        if(cit != shard.elements.end())
+        {
+            element = cit->second.lock();
+        }
+    }
+
+    if(!element)
     {
-        return it->second();
-    } else {
         std::stringstream ss;
         ss << uuid;
         throw std::invalid_argument("graph_analysis::GraphElement::fromUuid:"
                 " could not find graph element with uuid: '" + ss.str() + "'");
     }
+    return element;
 }
 
 GraphIdList GraphElement::getGraphAssociations() const
 {
-    GraphIdList graphList;
-    GraphElementMap::const_iterator cit = mGraphElementMap.begin();
-    for(; cit != mGraphElementMap.end(); ++cit)
-    {
-        graphList.push_back(cit->first);
-    }
-
-    return graphList;
+    return mGraphAssociations.getGraphIds();
 }
 
 std::string GraphElement::toPrefixedString(GraphId graph) const
@@ -72,9 +304,20 @@ std::string GraphElement::toPrefixedString(GraphId graph) const
     return ss.str();
 }
 
+void GraphElement::setUuid(const GraphElementUuid& uuid)
+{
+    std::lock_guard<std::mutex> lock(getUuidMutex(this));
+    mUuid = uuid;
+    if(!mUuid.is_nil())
+    {
+        registerUuid();
+    }
+    mUuidAssigned.store(!mUuid.is_nil(), std::memory_order_release);
+}
+
 void GraphElement::setUuid(const std::string& uuid)
 {
-    mUuid = boost::lexical_cast<GraphElementUuid>(uuid);
+    setUuid( boost::lexical_cast<GraphElementUuid>(uuid) );
 }
 
 }
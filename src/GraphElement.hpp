@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <vector>
 #include <map>
+#include <atomic>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -23,6 +24,84 @@ typedef uint32_t GraphId;
 typedef std::map<GraphId, GraphElementId> GraphElementMap;
 typedef std::vector<GraphId> GraphIdList;
 
+/**
+ * \brief Compact storage of the graph associations of a GraphElement
+ * \details
+ * Most elements are part of one or two graphs only (e.g. a graph and a
+ * copy or subgraph of it), thus the first InlineCapacity associations are
+ * stored in an inline array. A lookup for the first graph does not require
+ * any indirection. Further associations are stored in a (spill) vector,
+ * which allocates memory only when the inline array is full.
+ */
+class GraphElementAssociations
+{
+public:
+    /// Number of associations which are stored without allocation
+    static const size_t InlineCapacity = 2;
+
+    GraphElementAssociations()
+    {
+        clearInline();
+    }
+
+    /// Marks an unused inline slot
+    static const GraphId InvalidGraphId;
+
+    /**
+     * Get the element id for the given graph
+     * \return pointer to the id, or NULL if there is no association
+     */
+    const GraphElementId* find(GraphId graph) const
+    {
+        if(mGraphs[0] == graph)
+        {
+            return &mElementIds[0];
+        }
+        return findSlow(graph);
+    }
+
+    /**
+     * Test if there is an association to the given graph
+     */
+    bool contains(GraphId graph) const { return find(graph) != NULL; }
+
+    /**
+     * Set the element id for a given graph (overwrites existing association)
+     */
+    void set(GraphId graph, GraphElementId elementId);
+
+    /**
+     * Remove the association to the given graph
+     */
+    void erase(GraphId graph);
+
+    /**
+     * Remove all associations
+     */
+    void clear();
+
+    /**
+     * Get number of associations
+     */
+    size_t size() const;
+
+    /**
+     * Get the list of associated graphs (in ascending order)
+     */
+    GraphIdList getGraphIds() const;
+
+private:
+    const GraphElementId* findSlow(GraphId graph) const;
+
+    void clearInline();
+
+    /// Inline slots are filled from the front, unused slots are marked
+    /// with InvalidGraphId
+    GraphId mGraphs[InlineCapacity];
+    GraphElementId mElementIds[InlineCapacity];
+    std::vector< std::pair<GraphId, GraphElementId> > mSpilled;
+};
+
 /**
  * \brief GraphElement is the base class for all element in a graph, i.e. for
  * edges and vertices
@@ -41,6 +120,13 @@ public:
      */
     GraphElement(const std::string& label = std::string());
 
+    /**
+     * Copy the element including its uuid (if it has been assigned already)
+     */
+    GraphElement(const GraphElement& other);
+
+    GraphElement& operator=(const GraphElement& other);
+
     virtual ~GraphElement();
 
     typedef shared_ptr< GraphElement > Ptr;
@@ -76,39 +162,64 @@ public:
      * Test whether this element has been associated with
      * an edge or node
      */
-    bool associated(GraphId graph) const { return mGraphElementMap.count(graph); }
+    bool associated(GraphId graph) const { return mGraphAssociations.contains(graph); }
 
     /**
      * Add the element to a corresponding graph
      * This allows reverse mapping from the element to the graphs it belongs to
      */
-    void associate(GraphId graph, GraphElementId elementId) { mGraphElementMap[graph] = elementId; }
+    void associate(GraphId graph, GraphElementId elementId) { mGraphAssociations.set(graph, elementId); }
 
     /**
      * Remove the edge that corresponds to a given graph
      */
-    void disassociate(GraphId graph) { mGraphElementMap.erase(graph); }
+    void disassociate(GraphId graph) { mGraphAssociations.erase(graph); }
 
     /**
      * Get id of this element within a given graph
+     * \throw std::runtime_error if the element is not part of the graph
      */
-    GraphElementId getId(GraphId graph) const;
+    GraphElementId getId(GraphId graph) const
+    {
+        const GraphElementId* id = mGraphAssociations.find(graph);
+        if(id)
+        {
+            return *id;
+        }
+        throwNotAssociated(graph);
+        return 0;
+    }
 
     /**
      * Get a universally unique id of this GraphElement
      * \deprecated use getUuid instead
      */
-    GraphElementUuid getUid() const { return mUuid; }
+    GraphElementUuid getUid() const { return getUuid(); }
 
     /**
      * Get a universally unique id of this GraphElement
+     * \details The uuid is generated on first request (unless it has been
+     * set explicitly), and the element is then registered so that it can be
+     * retrieved via fromUuid. Concurrent calls are safe, the uuid is
+     * published once it is complete
      * \return uuid
      */
-    GraphElementUuid getUuid() const { return mUuid; }
+    GraphElementUuid getUuid() const
+    {
+        if(!mUuidAssigned.load(std::memory_order_acquire))
+        {
+            assignUuid();
+        }
+        return mUuid;
+    }
 
     /**
       * Get pointer to existing GraphElement from Uuid
+      * Only elements which are managed by a shared pointer, at the time their
+      * uuid is generated or set, can be retrieved
       * \return pointer to GraphElement
+      * \throw std::invalid_argument if there is no (living) element with
+      * this uuid
       */
     static GraphElement::Ptr fromUuid(const GraphElementUuid& uuid);
 
@@ -129,21 +240,40 @@ protected:
      */
     GraphElement::Ptr getSharedFromThis() { return shared_from_this(); }
 
-    void disassociateFromAll() { mGraphElementMap.clear(); }
+    void disassociateFromAll() { mGraphAssociations.clear(); }
 
     /**
      * Set the uuid from a given one, e.g.,
      * when deserialising elements
+     * Must not be called concurrently with getUuid
      */
-    void setUuid(const GraphElementUuid& uuid) { mUuid = uuid; }
+    void setUuid(const GraphElementUuid& uuid);
 
     void setUuid(const std::string& uuid);
 
-    GraphElementMap mGraphElementMap;
+    /**
+     * \throw std::runtime_error for an element that is not part of the given
+     * graph
+     */
+    void throwNotAssociated(GraphId graph) const;
+
+    /**
+     * Generate the uuid and register this element
+     */
+    void assignUuid() const;
+
+    /**
+     * Register this element (with its current uuid) in the registry
+     */
+    void registerUuid() const;
+
+    GraphElementAssociations mGraphAssociations;
 
-    GraphElementUuid mUuid;
-    static boost::uuids::random_generator msUuidGenerator;
-    static std::map<GraphElementUuid, function<GraphElement::Ptr()> > msGraphElements;
+    /// Lazily generated uuid, nil until first requested
+    mutable GraphElementUuid mUuid;
+    /// Set (with release semantics) once mUuid has been assigned, so that
+    /// readers do not need to lock
+    mutable std::atomic<bool> mUuidAssigned;
     std::string mLabel;
 };
 
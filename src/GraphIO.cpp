@@ -11,6 +11,8 @@
 #include "io/YamlWriter.hpp"
 #include "io/YamlReader.hpp"
 #include "io/GraphvizWriter.hpp"
+#include "io/MappedWriter.hpp"
+#include "io/MappedReader.hpp"
 
 #include <base-logging/Logging.hpp>
 
@@ -24,6 +26,7 @@ std::map<Type, std::string> TypeTxt = InitMap<Type, std::string>
     (LEMON, "LEMON")
     (GRAPHVIZ, "GRAPHVIZ")
     (YAML, "YAML")
+    (MAPPED, "MAPPED")
     ;
 // TODO3: "typemanager"
 // -kanten checken: is ein drag-drop event, der false zurückgeben kann
@@ -58,12 +61,14 @@ GraphIO::WriterMap GraphIO::msWriters = InitMap<representation::Type, Writer::Pt
     (representation::GRAPHML,  make_shared<GraphMLWriter>())
     (representation::GRAPHVIZ, make_shared<GraphvizWriter>())
     (representation::YAML,     make_shared<YamlWriter>())
+    (representation::MAPPED,   make_shared<MappedWriter>())
     ;
 
 GraphIO::ReaderMap GraphIO::msReaders = InitMap<representation::Type, Reader::Ptr>
     (representation::GEXF,    make_shared<GexfReader>())
     (representation::GRAPHML, make_shared<GraphMLReader>())
     (representation::YAML,    make_shared<YamlReader>())
+    (representation::MAPPED,  make_shared<MappedReader>())
     ;
 
 std::map<representation::Suffix, representation::Type> GraphIO::msSuffixes = InitMap<representation::Suffix, representation::Type>
@@ -73,6 +78,7 @@ std::map<representation::Suffix, representation::Type> GraphIO::msSuffixes = Ini
     ("xml", representation::GEXF)
     ("lemon", representation::LEMON)
     ("dot", representation::GRAPHVIZ)
+    ("mapped", representation::MAPPED)
     ;
 
 
@@ -0,0 +1,66 @@
+#ifndef GRAPH_ANALYSIS_ID_POOL_HPP
+#define GRAPH_ANALYSIS_ID_POOL_HPP
+
+#include <queue>
+#include <vector>
+#include <functional>
+#include "GraphElement.hpp"
+
+namespace graph_analysis {
+
+/**
+ * \brief Allocator for the element ids of a graph implementation
+ * \details Ids of removed elements are recycled (smallest id first), so that
+ * the range of ids remains dense for long-running workloads with frequent
+ * additions and removals
+ */
+class IdPool
+{
+public:
+    IdPool()
+        : mNextId(0)
+    {}
+
+    /**
+     * Get an unused id, preferring the smallest released one
+     */
+    GraphElementId allocate()
+    {
+        if(mReleasedIds.empty())
+        {
+            return mNextId++;
+        }
+
+        GraphElementId id = mReleasedIds.top();
+        mReleasedIds.pop();
+        return id;
+    }
+
+    /**
+     * Release an id for reuse
+     */
+    void release(GraphElementId id) { mReleasedIds.push(id); }
+
+    /**
+     * Get the upper bound of all allocated ids
+     */
+    GraphElementId getUpperBound() const { return mNextId; }
+
+    /**
+     * Reset the pool, so that ids [0, nextId) are in use
+     */
+    void reset(GraphElementId nextId)
+    {
+        mNextId = nextId;
+        mReleasedIds = ReleasedIds();
+    }
+
+private:
+    typedef std::priority_queue<GraphElementId, std::vector<GraphElementId>, std::greater<GraphElementId> > ReleasedIds;
+
+    GraphElementId mNextId;
+    ReleasedIds mReleasedIds;
+};
+
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_ID_POOL_HPP
@@ -0,0 +1,50 @@
+#include "IdRemapping.hpp"
+#include <limits>
+
+namespace graph_analysis {
+
+const GraphElementId IdRemapping::InvalidId = std::numeric_limits<GraphElementId>::max();
+
+IdRemapping::IdRemapping(GraphElementId vertexIdUpperBound, GraphElementId edgeIdUpperBound)
+    : mVertexIds(vertexIdUpperBound, InvalidId)
+    , mEdgeIds(edgeIdUpperBound, InvalidId)
+{
+}
+
+void IdRemapping::setVertexId(GraphElementId oldId, GraphElementId newId)
+{
+    if(oldId >= mVertexIds.size())
+    {
+        mVertexIds.resize(oldId + 1, InvalidId);
+    }
+    mVertexIds[oldId] = newId;
+}
+
+void IdRemapping::setEdgeId(GraphElementId oldId, GraphElementId newId)
+{
+    if(oldId >= mEdgeIds.size())
+    {
+        mEdgeIds.resize(oldId + 1, InvalidId);
+    }
+    mEdgeIds[oldId] = newId;
+}
+
+GraphElementId IdRemapping::getVertexId(GraphElementId oldId) const
+{
+    if(oldId < mVertexIds.size())
+    {
+        return mVertexIds[oldId];
+    }
+    return InvalidId;
+}
+
+GraphElementId IdRemapping::getEdgeId(GraphElementId oldId) const
+{
+    if(oldId < mEdgeIds.size())
+    {
+        return mEdgeIds[oldId];
+    }
+    return InvalidId;
+}
+
+} // end namespace graph_analysis
@@ -0,0 +1,51 @@
+#ifndef GRAPH_ANALYSIS_ID_REMAPPING_HPP
+#define GRAPH_ANALYSIS_ID_REMAPPING_HPP
+
+#include <vector>
+#include "GraphElement.hpp"
+
+namespace graph_analysis {
+
+/**
+ * \brief Mapping of the old to the new ids of vertices and edges, after the
+ * ids of a graph have been renumbered (see BaseGraph::compact)
+ */
+class IdRemapping
+{
+public:
+    /// New id of an old id which has not been in use
+    static const GraphElementId InvalidId;
+
+    /**
+     * \param vertexIdUpperBound upper bound of the old vertex ids
+     * \param edgeIdUpperBound upper bound of the old edge ids
+     */
+    IdRemapping(GraphElementId vertexIdUpperBound = 0, GraphElementId edgeIdUpperBound = 0);
+
+    void setVertexId(GraphElementId oldId, GraphElementId newId);
+    void setEdgeId(GraphElementId oldId, GraphElementId newId);
+
+    /**
+     * Get the new id of a vertex
+     * \return new id, or InvalidId if the old id has not been in use
+     */
+    GraphElementId getVertexId(GraphElementId oldId) const;
+
+    /**
+     * Get the new id of an edge
+     * \return new id, or InvalidId if the old id has not been in use
+     */
+    GraphElementId getEdgeId(GraphElementId oldId) const;
+
+    /**
+     * Test if no id has been remapped
+     */
+    bool empty() const { return mVertexIds.empty() && mEdgeIds.empty(); }
+
+private:
+    std::vector<GraphElementId> mVertexIds;
+    std::vector<GraphElementId> mEdgeIds;
+};
+
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_ID_REMAPPING_HPP
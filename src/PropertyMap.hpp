@@ -0,0 +1,246 @@
+#ifndef GRAPH_ANALYSIS_PROPERTY_MAP_HPP
+#define GRAPH_ANALYSIS_PROPERTY_MAP_HPP
+
+#include <vector>
+#include <stdint.h>
+#include "BaseGraph.hpp"
+
+namespace graph_analysis {
+
+/**
+ * \brief Dense map from GraphElementId to a value
+ * \details
+ * The values are stored in a contiguous vector indexed by the id, so that
+ * lookups require neither hashing nor comparing of shared pointers.
+ * Reading an id which has never been set yields the default value, writing
+ * an id beyond the current size grows the map.
+ * Since ids are only unique per graph, a map must only be used for the
+ * elements of a single graph.
+ */
+template<typename T>
+class PropertyMap
+{
+public:
+    typedef T value_type;
+    typedef const T& const_reference;
+    typedef T& reference;
+
+    /**
+     * \param defaultValue Value of all ids which have not been set
+     * \param size Initial number of entries, e.g., the id upper bound of a
+     * graph
+     */
+    explicit PropertyMap(const T& defaultValue = T(), size_t size = 0)
+        : mValues(size, defaultValue)
+        , mDefaultValue(defaultValue)
+    {}
+
+    /**
+     * Get the value for the given id
+     * \return value or the default value if it has not been set
+     */
+    const_reference get(GraphElementId id) const
+    {
+        if(id < mValues.size())
+        {
+            return mValues[id];
+        }
+        return mDefaultValue;
+    }
+
+    /**
+     * Set the value for the given id
+     */
+    void set(GraphElementId id, const T& value)
+    {
+        (*this)[id] = value;
+    }
+
+    /**
+     * Get a modifiable reference to the value for the given id
+     */
+    reference operator[](GraphElementId id)
+    {
+        if(id >= mValues.size())
+        {
+            resize(id + 1);
+        }
+        return mValues[id];
+    }
+
+    /**
+     * Resize the map, newly added entries are set to the default value
+     */
+    void resize(size_t size)
+    {
+        mValues.resize(size, mDefaultValue);
+    }
+
+    /**
+     * Reset all values to the default value
+     */
+    void clear() { mValues.assign(mValues.size(), mDefaultValue); }
+
+    /**
+     * Get the number of allocated entries
+     */
+    size_t size() const { return mValues.size(); }
+
+    /**
+     * Get the default value
+     */
+    const T& getDefaultValue() const { return mDefaultValue; }
+
+private:
+    std::vector<T> mValues;
+    T mDefaultValue;
+};
+
+/**
+ * \brief Specialization of the dense map for flags, stored as bitmap
+ */
+template<>
+class PropertyMap<bool>
+{
+public:
+    typedef bool value_type;
+    typedef bool const_reference;
+
+    explicit PropertyMap(bool defaultValue = false, size_t size = 0)
+        : mWords((size + 63)/64, defaultValue ? ~uint64_t(0) : 0)
+        , mSize(size)
+        , mDefaultValue(defaultValue)
+    {}
+
+    /**
+     * Get the flag for the given id
+     * \return flag or the default value if it has not been set
+     */
+    bool get(GraphElementId id) const
+    {
+        if(id < mSize)
+        {
+            return (mWords[id/64] >> (id%64)) & 1;
+        }
+        return mDefaultValue;
+    }
+
+    /**
+     * Set the flag for the given id
+     */
+    void set(GraphElementId id, bool value)
+    {
+        if(id >= mSize)
+        {
+            resize(id + 1);
+        }
+
+        uint64_t mask = uint64_t(1) << (id%64);
+        if(value)
+        {
+            mWords[id/64] |= mask;
+        } else {
+            mWords[id/64] &= ~mask;
+        }
+    }
+
+    /**
+     * Resize the bitmap, newly added entries are set to the default value
+     */
+    void resize(size_t size)
+    {
+        mWords.resize((size + 63)/64, mDefaultValue ? ~uint64_t(0) : 0);
+        mSize = size;
+    }
+
+    /**
+     * Reset all flags to the default value
+     */
+    void clear() { mWords.assign(mWords.size(), mDefaultValue ? ~uint64_t(0) : 0); }
+
+    size_t size() const { return mSize; }
+
+    bool getDefaultValue() const { return mDefaultValue; }
+
+private:
+    std::vector<uint64_t> mWords;
+    size_t mSize;
+    bool mDefaultValue;
+};
+
+/**
+ * \brief Dense map from the vertices of a graph to a value
+ * \details The map uses the id of the vertex within the given graph, and is
+ * initially sized by BaseGraph::getVertexIdUpperBound
+ */
+template<typename T>
+class VertexPropertyMap : public PropertyMap<T>
+{
+public:
+    typedef typename PropertyMap<T>::const_reference const_reference;
+
+    VertexPropertyMap(const BaseGraph::Ptr& graph, const T& defaultValue = T())
+        : PropertyMap<T>(defaultValue, graph->getVertexIdUpperBound())
+        , mpGraph(graph)
+    {}
+
+    using PropertyMap<T>::get;
+    using PropertyMap<T>::set;
+
+    /**
+     * Get the value for the given vertex
+     * \throw std::runtime_error if the vertex is not part of the graph
+     */
+    const_reference get(const Vertex::Ptr& vertex) const { return PropertyMap<T>::get( mpGraph->getVertexId(vertex) ); }
+
+    /**
+     * Set the value for the given vertex
+     * \throw std::runtime_error if the vertex is not part of the graph
+     */
+    void set(const Vertex::Ptr& vertex, const T& value) { PropertyMap<T>::set( mpGraph->getVertexId(vertex), value ); }
+
+    const BaseGraph::Ptr& getGraph() const { return mpGraph; }
+
+private:
+    BaseGraph::Ptr mpGraph;
+};
+
+/**
+ * \brief Dense map from the edges of a graph to a value
+ * \details The map uses the id of the edge within the given graph, and is
+ * initially sized by BaseGraph::getEdgeIdUpperBound
+ */
+template<typename T>
+class EdgePropertyMap : public PropertyMap<T>
+{
+public:
+    typedef typename PropertyMap<T>::const_reference const_reference;
+
+    EdgePropertyMap(const BaseGraph::Ptr& graph, const T& defaultValue = T())
+        : PropertyMap<T>(defaultValue, graph->getEdgeIdUpperBound())
+        , mpGraph(graph)
+    {}
+
+    using PropertyMap<T>::get;
+    using PropertyMap<T>::set;
+
+    /**
+     * Get the value for the given edge
+     * \throw std::runtime_error if the edge is not part of the graph
+     */
+    const_reference get(const Edge::Ptr& edge) const { return PropertyMap<T>::get( mpGraph->getEdgeId(edge) ); }
+
+    /**
+     * Set the value for the given edge
+     * \throw std::runtime_error if the edge is not part of the graph
+     */
+    void set(const Edge::Ptr& edge, const T& value) { PropertyMap<T>::set( mpGraph->getEdgeId(edge), value ); }
+
+    const BaseGraph::Ptr& getGraph() const { return mpGraph; }
+
+private:
+    BaseGraph::Ptr mpGraph;
+};
+
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_PROPERTY_MAP_HPP
@@ -0,0 +1,82 @@
+#ifndef GRAPH_ANALYSIS_SPAN_HPP
+#define GRAPH_ANALYSIS_SPAN_HPP
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace graph_analysis {
+
+/**
+ * \brief Non-owning view onto a contiguous sequence of elements
+ * \details
+ * A span remains valid only as long as the underlying storage is neither
+ * modified nor destroyed. It is used to expose internal arrays of graph
+ * implementations, e.g., the adjacency arrays of csr::DirectedGraph, without
+ * copying them.
+ */
+template<typename T>
+class Span
+{
+public:
+    typedef T value_type;
+    typedef const T* const_iterator;
+    typedef const T* iterator;
+
+    Span()
+        : mData(NULL)
+        , mSize(0)
+    {}
+
+    Span(const T* data, size_t size)
+        : mData(data)
+        , mSize(size)
+    {}
+
+    Span(const T* begin, const T* end)
+        : mData(begin)
+        , mSize(end - begin)
+    {}
+
+    /**
+     * Get pointer to the first element
+     */
+    const T* data() const { return mData; }
+
+    /**
+     * Get the number of elements
+     */
+    size_t size() const { return mSize; }
+
+    /**
+     * Test if the span has no elements
+     */
+    bool empty() const { return mSize == 0; }
+
+    const_iterator begin() const { return mData; }
+    const_iterator end() const { return mData + mSize; }
+
+    /**
+     * Access element without bounds check
+     */
+    const T& operator[](size_t index) const { return mData[index]; }
+
+    /**
+     * Access element with bounds check
+     * \throw std::out_of_range if index exceeds the size of the span
+     */
+    const T& at(size_t index) const
+    {
+        if(index >= mSize)
+        {
+            throw std::out_of_range("graph_analysis::Span::at: index out of range");
+        }
+        return mData[index];
+    }
+
+private:
+    const T* mData;
+    size_t mSize;
+};
+
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_SPAN_HPP
@@ -46,7 +46,29 @@ void SubGraph::applyFilters(const Filter<Vertex::Ptr>::Ptr& vertexFilter, const
         }
     }
 
-    if(vertexFilter)
+    // A filter on the class of the vertices is evaluated once per class, if
+    // the class index of the graph is available
+    std::vector< std::vector<GraphElementId> > idsByClass;
+    if(vertexFilter && vertexFilter->dependsOnClassOnly() && getBaseGraph()->getVertexIdsByClass(idsByClass))
+    {
+        BaseGraph::Ptr baseGraph = getBaseGraph();
+        std::vector< std::vector<GraphElementId> >::const_iterator cit = idsByClass.begin();
+        for(; cit != idsByClass.end(); ++cit)
+        {
+            bool matches = vertexFilter->matches( baseGraph->getVertex(cit->front()) );
+            std::vector<GraphElementId>::const_iterator iit = cit->begin();
+            for(; iit != cit->end(); ++iit)
+            {
+                Vertex::Ptr vertex = baseGraph->getVertex(*iit);
+                if(matches)
+                {
+                    disable(vertex);
+                } else {
+                    enable(vertex);
+                }
+            }
+        }
+    } else if(vertexFilter)
     {
         VertexIterator::Ptr vertexIterator = getBaseGraph()->getVertexIterator();
         while(vertexIterator->next())
@@ -98,7 +120,7 @@ BaseGraph::Ptr SubGraph::getBaseGraph() const
 void SubGraph::enable(const Vertex::Ptr& vertex)
 {
     std::set<GraphElementId>::iterator it =
-        mDisabledVertices.find(vertex->getId(mpBaseGraph->getId()));
+        mDisabledVertices.find(mpBaseGraph->getVertexId(vertex));
 
     if(it != mDisabledVertices.end())
     {
@@ -108,13 +130,13 @@ void SubGraph::enable(const Vertex::Ptr& vertex)
 
 void SubGraph::disable(const Vertex::Ptr& vertex)
 {
-    mDisabledVertices.insert(vertex->getId(mpBaseGraph->getId()));
+    mDisabledVertices.insert(mpBaseGraph->getVertexId(vertex));
 }
 
 void SubGraph::enable(const Edge::Ptr& edge)
 {
     std::set<GraphElementId>::iterator it =
-        mDisabledEdges.find(edge->getId(mpBaseGraph->getId()));
+        mDisabledEdges.find(mpBaseGraph->getEdgeId(edge));
 
     if(it != mDisabledEdges.end())
     {
@@ -124,13 +146,13 @@ void SubGraph::enable(const Edge::Ptr& edge)
 
 void SubGraph::disable(const Edge::Ptr& edge)
 {
-    mDisabledEdges.insert(edge->getId(mpBaseGraph->getId()));
+    mDisabledEdges.insert(mpBaseGraph->getEdgeId(edge));
 }
 
 bool SubGraph::enabled(const Vertex::Ptr& vertex) const
 {
     std::set<GraphElementId>::iterator it =
-        mDisabledVertices.find(vertex->getId(mpBaseGraph->getId()));
+        mDisabledVertices.find(mpBaseGraph->getVertexId(vertex));
 
     return it == mDisabledVertices.end();
 }
@@ -138,7 +160,7 @@ bool SubGraph::enabled(const Vertex::Ptr& vertex) const
 bool SubGraph::enabled(const Edge::Ptr& edge) const
 {
     std::set<GraphElementId>::iterator it =
-        mDisabledEdges.find(edge->getId(mpBaseGraph->getId()));
+        mDisabledEdges.find(mpBaseGraph->getEdgeId(edge));
 
     return it == mDisabledEdges.end();
 }
@@ -174,6 +196,7 @@ VertexIterator::Ptr SubGraph::getVertexIterator() const
     // disable(Vertex::Ptr) vs. disable(Edge::Ptr)
     VertexIterator::SkipFunction skipFunction( ::boost::bind(static_cast<bool (SubGraph::*)(const Vertex::Ptr&) const>(&SubGraph::disabled), this,_1) );
     vertexIt->setSkipFunction(skipFunction);
+    vertexIt->setIdSkipFunction( ::boost::bind(&SubGraph::disabledVertexId, this, _1) );
     return vertexIt;
 }
 
@@ -185,6 +208,7 @@ EdgeIterator::Ptr SubGraph::getEdgeIterator() const
     // disable(Vertex::Ptr) vs. disable(Edge::Ptr)
     EdgeIterator::SkipFunction skipFunction( ::boost::bind(static_cast<bool (SubGraph::*)(const Edge::Ptr&) const>(&SubGraph::disabled), this,_1) );
     edgeIt->setSkipFunction(skipFunction);
+    edgeIt->setIdSkipFunction( ::boost::bind(&SubGraph::disabledEdgeId, this, _1) );
     return edgeIt;
 }
 
@@ -198,6 +222,7 @@ EdgeIterator::Ptr SubGraph::getEdgeIterator(const Vertex::Ptr& vertex) const
     EdgeIterator::Ptr edgeIt = getBaseGraph()->getEdgeIterator(vertex);
     EdgeIterator::SkipFunction skipFunction( ::boost::bind(static_cast<bool (SubGraph::*)(const Edge::Ptr&) const>(&SubGraph::disabled), this,_1) );
     edgeIt->setSkipFunction(skipFunction);
+    edgeIt->setIdSkipFunction( ::boost::bind(&SubGraph::disabledEdgeId, this, _1) );
     return edgeIt;
 }
 
@@ -156,6 +156,18 @@ public:
      * Get the underlying base graph
      */
     shared_ptr<BaseGraph> getBaseGraph() const;
+
+private:
+    /**
+     * Test if a vertex has been disabled by its id, which allows the
+     * iterators to skip it without accessing the vertex
+     */
+    bool disabledVertexId(GraphElementId id) const { return mDisabledVertices.count(id) != 0; }
+
+    /**
+     * Test if an edge has been disabled by its id
+     */
+    bool disabledEdgeId(GraphElementId id) const { return mDisabledEdges.count(id) != 0; }
 };
 
 } // end namespace graph_analysis
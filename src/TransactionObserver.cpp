@@ -50,6 +50,11 @@ void TransactionObserver::notify(const Edge::Ptr& edge, const EventType& event,
     addEvent( ObserverEvent( edge, origin, event ) );
 };
 
+void TransactionObserver::notify( const IdRemapping& remapping, const GraphId& origin )
+{
+    mpObserver->notify( remapping, origin );
+}
+
 void TransactionObserver::notify( const TransactionType& event, const GraphId& origin )
 {
     // for a TRANSACTION_STOP event, we will emit all the events collected so far
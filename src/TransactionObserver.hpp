@@ -72,6 +72,12 @@ public:
                         const GraphId& origin);
     virtual void notify( const TransactionType& event, const GraphId& origin );
 
+    /**
+     * The remapping is forwarded immediately, since queued events refer to
+     * vertices and edges and not to their ids
+     */
+    virtual void notify( const IdRemapping& remapping, const GraphId& origin );
+
     /** @brief return true if a transaction is currently running
      */
     bool inTransaction();
@@ -102,6 +102,8 @@ protected:
      \verbatim
      return new MyVertex(*this);
      \endverbatim
+     * BaseGraph::clone calls this function concurrently for different
+     * vertices, unless it is asked to clone sequentially
      */
     virtual Vertex* getClone() const { return new Vertex(*this); }
 
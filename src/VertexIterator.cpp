@@ -11,4 +11,23 @@ bool VertexIterator::skip(const Vertex::Ptr& vertex) const
     return false;
 }
 
+bool VertexIterator::skipId(GraphElementId id) const
+{
+    if(mIdSkipFunction)
+    {
+        return mIdSkipFunction(id);
+    }
+    return false;
+}
+
+size_t VertexIterator::nextBatch(Vertex::Ptr* out, size_t max)
+{
+    size_t count = 0;
+    while(count < max && next())
+    {
+        out[count++] = current();
+    }
+    return count;
+}
+
 } // end namespace graph_analysis
@@ -20,6 +20,7 @@ class VertexIterator
 public:
     typedef shared_ptr<VertexIterator> Ptr;
     typedef function1<bool, const Vertex::Ptr&> SkipFunction;
+    typedef function1<bool, GraphElementId> IdSkipFunction;
 
     virtual ~VertexIterator() {}
 
@@ -30,6 +31,18 @@ public:
      */
     virtual bool next() { return false; }
 
+    /**
+     * \brief Advance the iterator by up to max items at once
+     * \details Fills the given array with the next (non-skipped) items and
+     * updates current() to the last of them. Implementations which can
+     * access the underlying graph library directly should override this
+     * function to avoid the per-item call of next()
+     * \param out Array with space for at least max items
+     * \param max Maximum number of items to retrieve
+     * \return number of items written to out, 0 if the iterator is exhausted
+     */
+    virtual size_t nextBatch(Vertex::Ptr* out, size_t max);
+
     /**
      * Retrieve the current vertex this iterator is pointing to
      */
@@ -42,6 +55,14 @@ protected:
      */
     bool skip(const Vertex::Ptr& vertex) const;
 
+    /**
+     * \brief Check if the vertex with the given id should be skipped
+     * \details Allows implementations which create their vertices on demand to
+     * skip them before creating them, skip has to be checked as well
+     * \return True if the vertex should be skipped, false otherwise
+     */
+    bool skipId(GraphElementId id) const;
+
     /**
      * \brief Set next vertex
      * Should be applied by class implementing next()
@@ -53,9 +74,16 @@ protected:
      */
     void setSkipFunction(SkipFunction skipFunction) { mSkipFunction = skipFunction; }
 
+    /**
+     * Allows to set a skip function by id, which has to be consistent with
+     * the skip function
+     */
+    void setIdSkipFunction(IdSkipFunction idSkipFunction) { mIdSkipFunction = idSkipFunction; }
+
 private:
     Vertex::Ptr mVertex;
     SkipFunction mSkipFunction;
+    IdSkipFunction mIdSkipFunction;
 };
 
 } // end namespace graph_analysis
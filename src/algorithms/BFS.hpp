@@ -1,9 +1,9 @@
 #ifndef GRAPH_ANALYSIS_ALGORITHMS_BFS_HPP
 #define GRAPH_ANALYSIS_ALGORITHMS_BFS_HPP
 
-#include <queue>
 #include "../BaseGraph.hpp"
 #include "Skipper.hpp"
+#include "StaticBFS.hpp"
 #include "BFSVisitor.hpp"
 
 namespace graph_analysis {
@@ -14,6 +14,8 @@ namespace algorithms {
   * \brief Implementation of Breadth-First-Search
   *¸\details This implements the breadth-first search algorithm, it is
   * based on the existing implementation of the algorithm in Boost
+  * The callbacks are forwarded to the virtual Visitor interface, use
+  * StaticBFS to avoid the virtual calls
   */
 class BFS
 {
@@ -28,14 +30,16 @@ public:
 
     /**
       * Start the algorithm beginning at the specified vertex
+      * \details The search borrows the vertices and edges from the graph,
+      * i.e. visitors receive references which remain valid only as long as
+      * the graph is not modified. Visitors have to copy the pointer if they
+      * want to keep an element beyond the callback
       * \param startVertex Start vertex of the search
       */
     void run(const Vertex::Ptr& startVertex = Vertex::Ptr());
 
 private:
     BaseGraph::Ptr mpGraph;
-    Vertex::Ptr mStartVertex;
-    std::queue<Vertex::Ptr> mStack;
     Visitor::Ptr mpVisitor;
     Skipper mSkipper;
 };
@@ -16,20 +16,20 @@ class BFSVisitor : public Visitor
 public:
     typedef shared_ptr<BFSVisitor> Ptr;
 
-    virtual void startVertex(Vertex::Ptr& vertex) { LOG_DEBUG_S << "startVertex" << vertex->toString(); }
-    virtual void initializeVertex(Vertex::Ptr& vertex) { LOG_DEBUG_S << "initializeVertex" << vertex->toString(); }
-    virtual void leafVertex(Vertex::Ptr& vertex) { LOG_DEBUG_S << "leafVertex" << vertex->toString(); }
+    virtual void startVertex(const Vertex::Ptr& vertex) { LOG_DEBUG_S << "startVertex" << vertex->toString(); }
+    virtual void initializeVertex(const Vertex::Ptr& vertex) { LOG_DEBUG_S << "initializeVertex" << vertex->toString(); }
+    virtual void leafVertex(const Vertex::Ptr& vertex) { LOG_DEBUG_S << "leafVertex" << vertex->toString(); }
     /**
      * Invoked when a vertex is encoutered for the first time
      */
-    virtual void discoverVertex(Vertex::Ptr& vertex) { LOG_DEBUG_S << "discoverVertex: " << vertex->toString(); }
-    virtual void finishVertex(Vertex::Ptr& vertex) { LOG_DEBUG_S << "finishVertex: " << vertex->toString(); }
+    virtual void discoverVertex(const Vertex::Ptr& vertex) { LOG_DEBUG_S << "discoverVertex: " << vertex->toString(); }
+    virtual void finishVertex(const Vertex::Ptr& vertex) { LOG_DEBUG_S << "finishVertex: " << vertex->toString(); }
 
 
-    virtual void examineEdge(Edge::Ptr& edge) { LOG_DEBUG_S << "examineEdge: " << edge->toString(); }
-    virtual void treeEdge(Edge::Ptr& edge) { LOG_DEBUG_S << "treeEdge: " << edge->toString(); }
-    virtual void forwardOrCrossEdge(Edge::Ptr& edge) { LOG_DEBUG_S << "forwardOrCrossEdge: " << edge->toString(); }
-    virtual void backEdge(Edge::Ptr& edge) { LOG_DEBUG_S << "backEdge: " << edge->toString(); }
+    virtual void examineEdge(const Edge::Ptr& edge) { LOG_DEBUG_S << "examineEdge: " << edge->toString(); }
+    virtual void treeEdge(const Edge::Ptr& edge) { LOG_DEBUG_S << "treeEdge: " << edge->toString(); }
+    virtual void forwardOrCrossEdge(const Edge::Ptr& edge) { LOG_DEBUG_S << "forwardOrCrossEdge: " << edge->toString(); }
+    virtual void backEdge(const Edge::Ptr& edge) { LOG_DEBUG_S << "backEdge: " << edge->toString(); }
 
 };
 
@@ -0,0 +1,120 @@
+#include "BidirectionalBFS.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace graph_analysis {
+namespace algorithms {
+
+const uint32_t BidirectionalBFS::Unreachable = std::numeric_limits<uint32_t>::max();
+
+BidirectionalBFS::BidirectionalBFS(const BaseGraph::Ptr& graph, Skipper skipper)
+    : mpGraph(graph)
+    , mSkipper(skipper)
+    , mQuery(0)
+    , mExploredVertices(0)
+{
+}
+
+uint32_t BidirectionalBFS::getHopDistance(const Vertex::Ptr& source, const Vertex::Ptr& target, uint32_t maxHops)
+{
+    GraphElementId sourceId = mpGraph->getVertexId(source);
+    GraphElementId targetId = mpGraph->getVertexId(target);
+    if(source == target)
+    {
+        mExploredVertices = 1;
+        return 0;
+    }
+    mExploredVertices = 2;
+
+    if(++mQuery == 0)
+    {
+        // The tags wrapped around, so previous queries have to be cleared
+        mForwardMarks.clear();
+        mBackwardMarks.clear();
+        mQuery = 1;
+    }
+
+    // Keep the borrowed vertices and edges alive until the query ends
+    BaseGraph::ElementRetention retention(*mpGraph);
+    mSource = source;
+    mTarget = target;
+    mForwardMarks[sourceId].query = mQuery;
+    mForwardMarks[sourceId].depth = 0;
+    mBackwardMarks[targetId].query = mQuery;
+    mBackwardMarks[targetId].depth = 0;
+    mForwardFrontier.assign(1, &mSource);
+    mBackwardFrontier.assign(1, &mTarget);
+
+    uint32_t forwardDepth = 0;
+    uint32_t backwardDepth = 0;
+    uint32_t distance = Unreachable;
+    while(distance == Unreachable
+            && !mForwardFrontier.empty() && !mBackwardFrontier.empty()
+            && forwardDepth + backwardDepth < maxHops)
+    {
+        if(mForwardFrontier.size() <= mBackwardFrontier.size())
+        {
+            distance = expand(true, forwardDepth);
+            ++forwardDepth;
+        } else {
+            distance = expand(false, backwardDepth);
+            ++backwardDepth;
+        }
+    }
+
+    mForwardFrontier.clear();
+    mBackwardFrontier.clear();
+    if(distance > maxHops)
+    {
+        return Unreachable;
+    }
+    return distance;
+}
+
+uint32_t BidirectionalBFS::expand(bool forward, uint32_t depth)
+{
+    Frontier& frontier = forward ? mForwardFrontier : mBackwardFrontier;
+    PropertyMap<Mark>& marks = forward ? mForwardMarks : mBackwardMarks;
+    const PropertyMap<Mark>& otherMarks = forward ? mBackwardMarks : mForwardMarks;
+
+    // The level is completed, since the first meeting vertex found does not
+    // necessarily lie on a shortest path
+    uint32_t distance = Unreachable;
+    mNextFrontier.clear();
+    for(const Vertex::Ptr* vertex : frontier)
+    {
+        EdgeIterator::Ptr edgeIt = forward ? mpGraph->getOutEdgeIterator(*vertex) : mpGraph->getInEdgeIterator(*vertex);
+        while(edgeIt->next())
+        {
+            const Edge::Ptr& edge = edgeIt->current();
+            if(mSkipper && mSkipper(edge))
+            {
+                continue;
+            }
+
+            const Vertex::Ptr& neighbour = forward ? edge->getTargetVertex() : edge->getSourceVertex();
+            GraphElementId neighbourId = mpGraph->getVertexId(neighbour);
+            Mark& mark = marks[neighbourId];
+            if(mark.query == mQuery)
+            {
+                continue;
+            }
+            mark.query = mQuery;
+            mark.depth = depth + 1;
+            mNextFrontier.push_back(&neighbour);
+
+            const Mark& otherMark = otherMarks.get(neighbourId);
+            if(otherMark.query == mQuery)
+            {
+                distance = std::min(distance, depth + 1 + otherMark.depth);
+            }
+        }
+    }
+
+    mExploredVertices += mNextFrontier.size();
+    frontier.swap(mNextFrontier);
+    return distance;
+}
+
+} // end namespace algorithms
+} // end namespace graph_analysis
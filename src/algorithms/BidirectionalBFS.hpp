@@ -0,0 +1,100 @@
+#ifndef GRAPH_ANALYSIS_ALGORITHMS_BIDIRECTIONAL_BFS_HPP
+#define GRAPH_ANALYSIS_ALGORITHMS_BIDIRECTIONAL_BFS_HPP
+
+#include <vector>
+#include "../BaseGraph.hpp"
+#include "../PropertyMap.hpp"
+#include "Skipper.hpp"
+
+namespace graph_analysis {
+namespace algorithms {
+
+/**
+ * \class BidirectionalBFS
+ * \brief Answer source-target reachability and hop distance queries
+ * \details
+ * A query searches breadth-first forward from the source over the out edges
+ * and backward from the target over the in edges, always expanding the
+ * smaller of both frontiers by one level. The query terminates in the
+ * level in which the frontiers meet, i.e. it typically explores only a
+ * small part of the vertices which are reachable from the source.
+ *
+ * The search state is kept across queries and tagged per query, so that a
+ * query does not need to reset it and its cost depends only on the number
+ * of explored vertices. The search borrows the vertices from the graph,
+ * the graph must not be modified during a query.
+ */
+class BidirectionalBFS
+{
+public:
+    /// Distance of unreachable vertices, and the hop limit of an unlimited
+    /// query
+    static const uint32_t Unreachable;
+
+    /**
+     * \param graph Graph to search
+     * \param skipper Skipper object to define, when an edge does not need to
+     * be followed
+     */
+    BidirectionalBFS(const BaseGraph::Ptr& graph, Skipper skipper = Skipper());
+
+    /**
+     * Get the minimum number of hops from source to target
+     * \param maxHops Maximum number of hops, longer paths are not searched
+     * \return number of hops or Unreachable, if the target cannot be reached
+     * within maxHops
+     */
+    uint32_t getHopDistance(const Vertex::Ptr& source, const Vertex::Ptr& target, uint32_t maxHops = Unreachable);
+
+    /**
+     * Test if the target can be reached from the source
+     * \param maxHops Maximum number of hops
+     */
+    bool isReachable(const Vertex::Ptr& source, const Vertex::Ptr& target, uint32_t maxHops = Unreachable) { return getHopDistance(source, target, maxHops) != Unreachable; }
+
+    /**
+     * Get the number of vertices which have been explored by the last query
+     */
+    size_t getExploredVertexCount() const { return mExploredVertices; }
+
+private:
+    /**
+     * Search status of a vertex, which is only valid if it has been set in
+     * the current query
+     */
+    struct Mark
+    {
+        uint32_t query;
+        uint32_t depth;
+
+        Mark() : query(0), depth(0) {}
+    };
+
+    typedef std::vector<const Vertex::Ptr*> Frontier;
+
+    /**
+     * Expand the frontier of one direction by one level
+     * \return the minimum distance via a vertex at which both searches meet,
+     * or Unreachable
+     */
+    uint32_t expand(bool forward, uint32_t depth);
+
+    BaseGraph::Ptr mpGraph;
+    Skipper mSkipper;
+
+    uint32_t mQuery;
+    PropertyMap<Mark> mForwardMarks;
+    PropertyMap<Mark> mBackwardMarks;
+    Vertex::Ptr mSource;
+    Vertex::Ptr mTarget;
+    /// Borrowed references to the vertices held by source, target and the
+    /// traversed edges
+    Frontier mForwardFrontier;
+    Frontier mBackwardFrontier;
+    Frontier mNextFrontier;
+    size_t mExploredVertices;
+};
+
+} // end namespace algorithms
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_ALGORITHMS_BIDIRECTIONAL_BFS_HPP
@@ -1,9 +1,9 @@
 #ifndef GRAPH_ANALYSIS_ALGORITHMS_DFS_HPP
 #define GRAPH_ANALYSIS_ALGORITHMS_DFS_HPP
 
-#include <vector>
 #include "../BaseGraph.hpp"
 #include "Skipper.hpp"
+#include "StaticDFS.hpp"
 #include "DFSVisitor.hpp"
 
 namespace graph_analysis {
@@ -14,6 +14,8 @@ namespace algorithms {
   * \brief Implementation of Depth-First-Search
   *¸\details This implements the depth-first search algorithm, it is
   * based on the existing implementation of the algorithm in Boost
+  * The callbacks are forwarded to the virtual Visitor interface, use
+  * StaticDFS to avoid the virtual calls
   */
 class DFS
 {
@@ -28,14 +30,16 @@ public:
 
     /**
       * Start the algorithm beginning at the specified vertex
+      * \details The search borrows the vertices and edges from the graph,
+      * i.e. visitors receive references which remain valid only as long as
+      * the graph is not modified. Visitors have to copy the pointer if they
+      * want to keep an element beyond the callback
       * \param startVertex Start vertex of the search
       */
     void run(const Vertex::Ptr& startVertex = Vertex::Ptr());
 
 private:
     BaseGraph::Ptr mpGraph;
-    Vertex::Ptr mStartVertex;
-    std::vector<Vertex::Ptr> mStack;
     Visitor::Ptr mpVisitor;
     Skipper mSkipper;
 };
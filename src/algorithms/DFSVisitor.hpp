@@ -13,8 +13,8 @@ namespace algorithms {
  * \verbatim
  class PathConstructor : public graph_analysis::algorithm::DFSVisitor
  {
-    bool invalidTransition(graph_analysis::Edge::Ptr& edge) { // check if it a valid transition and return true or false ... }
-    void discoverVertex(graph_analysis::Vertex::Ptr& vertex) { // collect vertices ... }
+    bool invalidTransition(const graph_analysis::Edge::Ptr& edge) { // check if it a valid transition and return true or false ... }
+    void discoverVertex(const graph_analysis::Vertex::Ptr& vertex) { // collect vertices ... }
  };
 
  BaseGraph::Ptr graph = BaseGraph::getInstance();
@@ -34,19 +34,19 @@ class DFSVisitor : public Visitor
 public:
     typedef shared_ptr<DFSVisitor> Ptr;
 
-    virtual void initializeVertex(Vertex::Ptr& vertex) { LOG_DEBUG_S << "initializeVertex" << vertex->toString(); }
-    virtual void leafVertex(Vertex::Ptr& vertex) { LOG_DEBUG_S << "leafVertex" << vertex->toString(); }
+    virtual void initializeVertex(const Vertex::Ptr& vertex) { LOG_DEBUG_S << "initializeVertex" << vertex->toString(); }
+    virtual void leafVertex(const Vertex::Ptr& vertex) { LOG_DEBUG_S << "leafVertex" << vertex->toString(); }
 
-    virtual void examineEdge(Edge::Ptr& edge) { LOG_DEBUG_S << "examineEdge: " << edge->toString(); }
-    virtual void treeEdge(Edge::Ptr& edge) { LOG_DEBUG_S << "treeEdge: " << edge->toString(); }
-    virtual void forwardOrCrossEdge(Edge::Ptr& edge) { LOG_DEBUG_S << "forwardOrCrossEdge: " << edge->toString(); }
-    virtual void backEdge(Edge::Ptr& edge) { LOG_DEBUG_S << "backEdge: " << edge->toString(); }
+    virtual void examineEdge(const Edge::Ptr& edge) { LOG_DEBUG_S << "examineEdge: " << edge->toString(); }
+    virtual void treeEdge(const Edge::Ptr& edge) { LOG_DEBUG_S << "treeEdge: " << edge->toString(); }
+    virtual void forwardOrCrossEdge(const Edge::Ptr& edge) { LOG_DEBUG_S << "forwardOrCrossEdge: " << edge->toString(); }
+    virtual void backEdge(const Edge::Ptr& edge) { LOG_DEBUG_S << "backEdge: " << edge->toString(); }
 
     /**
      * Invoked when a vertex is encoutered for the first time
      */
-    virtual void discoverVertex(Vertex::Ptr& vertex) { LOG_DEBUG_S << "discoverVertex: " << vertex->toString(); }
-    virtual void finishVertex(Vertex::Ptr& vertex) { LOG_DEBUG_S << "finishVertex: " << vertex->toString(); }
+    virtual void discoverVertex(const Vertex::Ptr& vertex) { LOG_DEBUG_S << "discoverVertex: " << vertex->toString(); }
+    virtual void finishVertex(const Vertex::Ptr& vertex) { LOG_DEBUG_S << "finishVertex: " << vertex->toString(); }
 
 };
 
@@ -1,65 +1,56 @@
 #include "FloydWarshall.hpp"
+#include "../PropertyMap.hpp"
 #include <limits>
 #include <cmath>
 
 namespace graph_analysis {
 namespace algorithms {
 
-double FloydWarshall::getDistanceLazy(DistanceMatrix& distanceMatrix, Vertex::Ptr i, Vertex::Ptr k)
+DistanceMatrix FloydWarshall::allShortestPaths(const BaseGraph::Ptr& graph, EdgeWeightFunction edgeWeightFunction, bool detectNegativeCycle)
 {
-    DistanceMatrix::iterator itDistanceIK = distanceMatrix.find(std::pair<Vertex::Ptr, Vertex::Ptr>(i,k));
-    // Lazy initialization of pair
-    double distanceIK = std::numeric_limits<double>::infinity();
-    if(itDistanceIK != distanceMatrix.end())
+    // Compute on a dense matrix using the position of the vertices in the
+    // iteration order
+    std::vector<Vertex::Ptr> vertices = graph->getAllVertices();
+    size_t order = vertices.size();
+
+    VertexPropertyMap<size_t> positions(graph);
+    for(size_t i = 0; i < order; ++i)
     {
-        distanceIK = itDistanceIK->second;
-    } else {
-        distanceMatrix[std::pair<Vertex::Ptr, Vertex::Ptr>(i,k)] = distanceIK;
+        positions.set(vertices[i], i);
     }
 
-    return distanceIK;
-}
-
-DistanceMatrix FloydWarshall::allShortestPaths(const BaseGraph::Ptr& graph, EdgeWeightFunction edgeWeightFunction, bool detectNegativeCycle)
-{
-    DistanceMatrix distanceMatrix;
-
     // Initialize the distance matrix
-    VertexIterator::Ptr vertexIt = graph->getVertexIterator();
-    while(vertexIt->next())
+    std::vector<double> distances(order*order, std::numeric_limits<double>::infinity());
+    for(size_t i = 0; i < order; ++i)
     {
-        Vertex::Ptr vertex = vertexIt->current();
-        distanceMatrix[ std::pair<Vertex::Ptr, Vertex::Ptr>(vertex,vertex) ] = 0;
+        distances[i*order + i] = 0;
     }
 
     EdgeIterator::Ptr edgeIt = graph->getEdgeIterator();
     while(edgeIt->next())
     {
-        Edge::Ptr edge = edgeIt->current();
-        distanceMatrix[ std::pair<Vertex::Ptr, Vertex::Ptr>(edge->getSourceVertex(), edge->getTargetVertex()) ] = edgeWeightFunction(edge);
+        const Edge::Ptr& edge = edgeIt->current();
+        size_t source = positions.get(edge->getSourceVertex());
+        size_t target = positions.get(edge->getTargetVertex());
+        distances[source*order + target] = edgeWeightFunction(edge);
     }
 
-    VertexIterator::Ptr i_vertexIt = graph->getVertexIterator();
-    while(i_vertexIt->next())
+    for(size_t i = 0; i < order; ++i)
     {
-        Vertex::Ptr i = i_vertexIt->current();
-
-        VertexIterator::Ptr j_vertexIt = graph->getVertexIterator();
-        while(j_vertexIt->next())
+        const double* distancesI = &distances[i*order];
+        for(size_t j = 0; j < order; ++j)
         {
-            Vertex::Ptr j = j_vertexIt->current();
-            double distanceJI = getDistanceLazy(distanceMatrix,j,i);
+            double* distancesJ = &distances[j*order];
+            double distanceJI = distancesJ[i];
 
             // Direct: J-->K
             // Transitive:  J->I->K
-            VertexIterator::Ptr k_vertexIt = graph->getVertexIterator();
-            while(k_vertexIt->next())
+            for(size_t k = 0; k < order; ++k)
             {
-                Vertex::Ptr k = k_vertexIt->current();
-                double distanceJK = getDistanceLazy(distanceMatrix,j,k);
-                double distanceIK = getDistanceLazy(distanceMatrix,i,k);
-                double transitiveDistanceJK = distanceJI + distanceIK;
+                double distanceJK = distancesJ[k];
+                double distanceIK = distancesI[k];
 
+                double transitiveDistanceJK = distanceJI + distanceIK;
                 if( j == k && abs(transitiveDistanceJK) < std::numeric_limits<double>::epsilon())
                 {
                     continue;
@@ -71,13 +62,23 @@ DistanceMatrix FloydWarshall::allShortestPaths(const BaseGraph::Ptr& graph, Edge
                     {
                         throw std::runtime_error("graph_analysis::algorithms::FloydWarshall::allShortestPaths: negative cycle detected");
                     } else {
-                        distanceMatrix[ std::pair<Vertex::Ptr, Vertex::Ptr>(j,k) ] = transitiveDistanceJK;
+                        distancesJ[k] = transitiveDistanceJK;
                     }
                 }
             }
         }
     }
+
+    DistanceMatrix distanceMatrix;
+    for(size_t j = 0; j < order; ++j)
+    {
+        for(size_t k = 0; k < order; ++k)
+        {
+            distanceMatrix[ std::pair<Vertex::Ptr, Vertex::Ptr>(vertices[j], vertices[k]) ] = distances[j*order + k];
+        }
+    }
     return distanceMatrix;
 }
+
 } // end namespace algorithms
 } // end namespace graph_analysis
@@ -19,7 +19,6 @@ typedef function1<double, Edge::Ptr> EdgeWeightFunction;
  */
 class FloydWarshall
 {
-    static double getDistanceLazy(DistanceMatrix& distanceMatrix, Vertex::Ptr i, Vertex::Ptr k);
 public:
     /**
      * \param graph The graph to search on
@@ -15,6 +15,7 @@ MultiCommodityMinCostFlow::MultiCommodityMinCostFlow(const BaseGraph::Ptr& graph
     : mpSolver( LPSolver::getInstance(solverType) )
     , mCommodities(commodities)
     , mpGraph(graph)
+    , mEdgeToColumn(-1)
     , mTotalNumberOfColumns(0)
     , mTotalNumberOfRows(0)
 {
@@ -133,6 +134,7 @@ std::string MultiCommodityMinCostFlow::createProblemCPLEX()
 
         // Start column --> mColumnToEdge*numberOfCommodities + commodityOffset
         // commodityOffset := 1 .. K
+        mEdgeToColumn.set(mpGraph->getEdgeId(edge), mColumnToEdge.size());
         mColumnToEdge.push_back(edge);
 
         // Bound on total capacity
@@ -551,10 +553,14 @@ std::vector<ConstraintViolation> MultiCommodityMinCostFlow::validateInflow() con
 
 int MultiCommodityMinCostFlow::getColumnIndex(const Edge::Ptr& e, uint32_t commodity)
 {
-    std::vector<Edge::Ptr>::iterator cit = std::find(mColumnToEdge.begin(), mColumnToEdge.end(), e);
-    if(cit != mColumnToEdge.end())
+    int index = -1;
+    if(mpGraph->contains(e))
     {
-        int distance = std::distance(mColumnToEdge.begin(), cit)*mCommodities + commodity + 1;
+        index = mEdgeToColumn.get( mpGraph->getEdgeId(e) );
+    }
+    if(index >= 0)
+    {
+        int distance = index*mCommodities + commodity + 1;
         LOG_DEBUG_S << "Column index '" << e->toString() << "' commodity: '" << commodity << "' is " << distance;
         return distance;
     }
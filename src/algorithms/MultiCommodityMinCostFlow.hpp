@@ -2,6 +2,7 @@
 #define GRAPH_ANALYSIS_ALGORITHMS_MULTI_COMMODITY_MIN_COST_FLOW_HPP
 
 #include "../BaseGraph.hpp"
+#include "../PropertyMap.hpp"
 #include "../GraphIO.hpp"
 #include "LPSolver.hpp"
 #include "MultiCommodityEdge.hpp"
@@ -256,6 +257,8 @@ private:
     BaseGraph::Ptr mpGraph;
     /// Map a column to a particular edge
     std::vector<Edge::Ptr> mColumnToEdge;
+    /// Map an edge (by its id) to the index in mColumnToEdge
+    PropertyMap<int> mEdgeToColumn;
     /// Map row to vertex
     VertexCommodityList mRowToVertexCommodity;
 
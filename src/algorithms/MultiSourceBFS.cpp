@@ -0,0 +1,174 @@
+#include "MultiSourceBFS.hpp"
+#include "../csr/DirectedGraph.hpp"
+#include "../utils/Parallel.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace graph_analysis {
+namespace algorithms {
+
+const uint32_t MultiSourceBFS::Unreachable = std::numeric_limits<uint32_t>::max();
+
+MultiSourceBFS::MultiSourceBFS(const BaseGraph::Ptr& graph)
+    : mpGraph(graph)
+    , mpCSRGraph(NULL)
+    , mNumberOfSources(0)
+    , mRecordDepths(false)
+{
+}
+
+void MultiSourceBFS::run(const std::vector<Vertex::Ptr>& sources, uint32_t maxDepth, bool recordDepths)
+{
+    mpDenseGraph = mpGraph;
+    if(!dynamic_cast<const csr::DirectedGraph*>(mpGraph.get()))
+    {
+        mpDenseGraph = mpGraph->snapshot();
+    }
+    mpCSRGraph = static_cast<const csr::DirectedGraph*>(mpDenseGraph.get());
+
+    std::vector<GraphElementId> sourceIds;
+    sourceIds.reserve(sources.size());
+    for(const Vertex::Ptr& source : sources)
+    {
+        sourceIds.push_back(mpCSRGraph->getVertexId(source));
+    }
+
+    size_t order = mpCSRGraph->getVertexCount();
+    size_t numberOfBatches = (sources.size() + 63)/64;
+    mNumberOfSources = sources.size();
+    mRecordDepths = recordDepths;
+    mSeen.assign(numberOfBatches*order, 0);
+    mDepths.clear();
+    if(mRecordDepths)
+    {
+        mDepths.assign(sources.size()*order, Unreachable);
+    }
+
+    utils::Parallel::forEachChunk(numberOfBatches, [&](size_t begin, size_t end)
+    {
+        for(size_t batch = begin; batch < end; ++batch)
+        {
+            runBatch(batch, sourceIds, maxDepth);
+        }
+    }, 1);
+}
+
+void MultiSourceBFS::runBatch(size_t batch, const std::vector<GraphElementId>& sources, uint32_t maxDepth)
+{
+    size_t order = mpCSRGraph->getVertexCount();
+    Span<GraphElementId> outOffsets = mpCSRGraph->getOutOffsets();
+    Span<GraphElementId> outTargets = mpCSRGraph->getOutTargets();
+
+    // Bit i of a word refers to source 64*batch + i
+    uint64_t* seen = mSeen.data() + batch*order;
+    std::vector<uint64_t> visit(order, 0);
+    std::vector<uint64_t> visitNext(order, 0);
+
+    size_t firstSource = batch*64;
+    size_t numberOfSources = std::min<size_t>(64, sources.size() - firstSource);
+    for(size_t i = 0; i < numberOfSources; ++i)
+    {
+        GraphElementId source = sources[firstSource + i];
+        seen[source] |= uint64_t(1) << i;
+        visit[source] |= uint64_t(1) << i;
+        if(mRecordDepths)
+        {
+            mDepths[(firstSource + i)*order + source] = 0;
+        }
+    }
+
+    bool active = numberOfSources != 0;
+    for(uint32_t depth = 1; active && depth <= maxDepth; ++depth)
+    {
+        // One scan of the out edges of a vertex advances all sources which
+        // reached it in the previous level
+        for(GraphElementId v = 0; v < order; ++v)
+        {
+            uint64_t sourcesOfVertex = visit[v];
+            if(sourcesOfVertex == 0)
+            {
+                continue;
+            }
+            for(GraphElementId e = outOffsets[v]; e < outOffsets[v + 1]; ++e)
+            {
+                GraphElementId target = outTargets[e];
+                visitNext[target] |= sourcesOfVertex & ~seen[target];
+            }
+        }
+
+        active = false;
+        for(GraphElementId v = 0; v < order; ++v)
+        {
+            uint64_t discovered = visitNext[v];
+            visit[v] = discovered;
+            visitNext[v] = 0;
+            if(discovered == 0)
+            {
+                continue;
+            }
+            active = true;
+            seen[v] |= discovered;
+            if(mRecordDepths)
+            {
+                for(size_t i = 0; discovered != 0; ++i, discovered >>= 1)
+                {
+                    if(discovered & 1)
+                    {
+                        mDepths[(firstSource + i)*order + v] = depth;
+                    }
+                }
+            }
+        }
+    }
+}
+
+GraphElementId MultiSourceBFS::getDenseVertexId(size_t sourceIndex, const Vertex::Ptr& vertex) const
+{
+    if(sourceIndex >= mNumberOfSources)
+    {
+        throw std::out_of_range("graph_analysis::algorithms::MultiSourceBFS: invalid source index");
+    }
+    return mpCSRGraph->getVertexId(vertex);
+}
+
+bool MultiSourceBFS::isReachable(size_t sourceIndex, const Vertex::Ptr& vertex) const
+{
+    GraphElementId v = getDenseVertexId(sourceIndex, vertex);
+    size_t order = mpCSRGraph->getVertexCount();
+    return mSeen[(sourceIndex/64)*order + v] & (uint64_t(1) << (sourceIndex % 64));
+}
+
+uint32_t MultiSourceBFS::getDepth(size_t sourceIndex, const Vertex::Ptr& vertex) const
+{
+    GraphElementId v = getDenseVertexId(sourceIndex, vertex);
+    if(!mRecordDepths)
+    {
+        throw std::runtime_error("graph_analysis::algorithms::MultiSourceBFS::getDepth: depths have not been recorded");
+    }
+    return mDepths[sourceIndex*mpCSRGraph->getVertexCount() + v];
+}
+
+std::vector<Vertex::Ptr> MultiSourceBFS::getReachableVertices(size_t sourceIndex) const
+{
+    if(sourceIndex >= mNumberOfSources)
+    {
+        throw std::out_of_range("graph_analysis::algorithms::MultiSourceBFS::getReachableVertices: invalid source index");
+    }
+
+    std::vector<Vertex::Ptr> vertices;
+    size_t order = mpCSRGraph->getVertexCount();
+    const uint64_t* seen = mSeen.data() + (sourceIndex/64)*order;
+    uint64_t mask = uint64_t(1) << (sourceIndex % 64);
+    for(GraphElementId v = 0; v < order; ++v)
+    {
+        if(seen[v] & mask)
+        {
+            vertices.push_back(mpCSRGraph->getVertex(v));
+        }
+    }
+    return vertices;
+}
+
+} // end namespace algorithms
+} // end namespace graph_analysis
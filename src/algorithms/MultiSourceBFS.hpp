@@ -0,0 +1,111 @@
+#ifndef GRAPH_ANALYSIS_ALGORITHMS_MULTI_SOURCE_BFS_HPP
+#define GRAPH_ANALYSIS_ALGORITHMS_MULTI_SOURCE_BFS_HPP
+
+#include <vector>
+#include "../BaseGraph.hpp"
+
+namespace graph_analysis {
+
+namespace csr {
+    class DirectedGraph;
+}
+
+namespace algorithms {
+
+/**
+ * \class MultiSourceBFS
+ * \brief Breadth-first search from many start vertices at once, e.g. to
+ * answer batches of reachability queries
+ * \details
+ * The sources are processed in batches of 64, where each vertex keeps one
+ * bit per source of the batch in a machine word (Then et al., The More the
+ * Merrier: Efficient Multi-Source Graph Traversal). A single scan of the
+ * adjacency of a vertex thus advances the search of all sources of the
+ * batch, which have reached this vertex in the same level. Batches are
+ * processed concurrently, see utils::Parallel.
+ *
+ * The search runs on the adjacency arrays of a csr::DirectedGraph. If the
+ * given graph is not a csr::DirectedGraph its (cached) snapshot is used,
+ * see BaseGraph::snapshot. Vertices and edges are not materialized.
+ *
+ * The reachability requires one bit per source and vertex, recording the
+ * depths additionally 4 bytes per source and vertex.
+ */
+class MultiSourceBFS
+{
+public:
+    /// Depth of the vertices which are not reachable, and the maximum depth
+    /// of an unlimited search
+    static const uint32_t Unreachable;
+
+    /**
+     * \param graph Graph to search
+     */
+    MultiSourceBFS(const BaseGraph::Ptr& graph);
+
+    /**
+     * Search from all given start vertices
+     * \param sources Start vertices, the results are accessed by the index
+     * of the start vertex in this list
+     * \param maxDepth Maximum number of hops from a start vertex
+     * \param recordDepths If false, only the reachability is recorded
+     * \throw std::runtime_error if a start vertex is not part of the graph
+     */
+    void run(const std::vector<Vertex::Ptr>& sources, uint32_t maxDepth = Unreachable, bool recordDepths = true);
+
+    /**
+     * Get the number of start vertices of the last search
+     */
+    size_t getNumberOfSources() const { return mNumberOfSources; }
+
+    /**
+     * Test if the vertex is reachable from the start vertex with the given
+     * index
+     * \throw std::out_of_range if the source index is invalid
+     */
+    bool isReachable(size_t sourceIndex, const Vertex::Ptr& vertex) const;
+
+    /**
+     * Get the depth of the vertex in the search from the start vertex with
+     * the given index
+     * \return depth or Unreachable
+     * \throw std::out_of_range if the source index is invalid
+     * \throw std::runtime_error if the depths have not been recorded
+     */
+    uint32_t getDepth(size_t sourceIndex, const Vertex::Ptr& vertex) const;
+
+    /**
+     * Get all vertices which are reachable from the start vertex with the
+     * given index, including the start vertex
+     * \throw std::out_of_range if the source index is invalid
+     */
+    std::vector<Vertex::Ptr> getReachableVertices(size_t sourceIndex) const;
+
+private:
+    /**
+     * Search from the sources of a batch
+     */
+    void runBatch(size_t batch, const std::vector<GraphElementId>& sources, uint32_t maxDepth);
+
+    /**
+     * Get the id of the vertex in the dense graph
+     * \throw std::out_of_range if the source index is invalid
+     */
+    GraphElementId getDenseVertexId(size_t sourceIndex, const Vertex::Ptr& vertex) const;
+
+    BaseGraph::Ptr mpGraph;
+    BaseGraph::Ptr mpDenseGraph;
+    const csr::DirectedGraph* mpCSRGraph;
+
+    size_t mNumberOfSources;
+    bool mRecordDepths;
+    /// Per batch the bitmask of the sources which have reached a vertex,
+    /// indexed by batch*order + vertex id of the dense graph
+    std::vector<uint64_t> mSeen;
+    /// Indexed by source*order + vertex id of the dense graph
+    std::vector<uint32_t> mDepths;
+};
+
+} // end namespace algorithms
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_ALGORITHMS_MULTI_SOURCE_BFS_HPP
@@ -0,0 +1,361 @@
+#include "ParallelBFS.hpp"
+#include "../csr/DirectedGraph.hpp"
+#include "../utils/Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace graph_analysis {
+namespace algorithms {
+
+namespace {
+
+/**
+ * Bitmap over the vertex ids, which can be modified concurrently
+ */
+class AtomicBitmap
+{
+public:
+    explicit AtomicBitmap(size_t size)
+        : mNumberOfWords((size + 63)/64)
+        , mWords(new std::atomic<uint64_t>[mNumberOfWords])
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        for(size_t w = 0; w < mNumberOfWords; ++w)
+        {
+            mWords[w].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool test(size_t index) const
+    {
+        return mWords[index/64].load(std::memory_order_relaxed) & mask(index);
+    }
+
+    /**
+     * Set the bit
+     * \return true if this call has set the bit, false if it has been set
+     * before
+     */
+    bool testAndSet(size_t index)
+    {
+        std::atomic<uint64_t>& word = mWords[index/64];
+        if(word.load(std::memory_order_relaxed) & mask(index))
+        {
+            return false;
+        }
+        return !(word.fetch_or(mask(index), std::memory_order_relaxed) & mask(index));
+    }
+
+    /**
+     * Set the bit, which requires that no other thread modifies the same
+     * word
+     */
+    void setExclusive(size_t index)
+    {
+        std::atomic<uint64_t>& word = mWords[index/64];
+        word.store(word.load(std::memory_order_relaxed) | mask(index), std::memory_order_relaxed);
+    }
+
+    uint64_t getWord(size_t w) const { return mWords[w].load(std::memory_order_relaxed); }
+
+    size_t getNumberOfWords() const { return mNumberOfWords; }
+
+    /**
+     * Get the indices of all set bits in ascending order
+     */
+    std::vector<GraphElementId> toVector() const
+    {
+        std::vector<GraphElementId> indices;
+        for(size_t w = 0; w < mNumberOfWords; ++w)
+        {
+            uint64_t word = getWord(w);
+            for(size_t b = 0; word != 0; ++b, word >>= 1)
+            {
+                if(word & 1)
+                {
+                    indices.push_back(w*64 + b);
+                }
+            }
+        }
+        return indices;
+    }
+
+    void swap(AtomicBitmap& other)
+    {
+        std::swap(mNumberOfWords, other.mNumberOfWords);
+        mWords.swap(other.mWords);
+    }
+
+private:
+    static uint64_t mask(size_t index) { return uint64_t(1) << (index % 64); }
+
+    size_t mNumberOfWords;
+    std::unique_ptr<std::atomic<uint64_t>[]> mWords;
+};
+
+} // end anonymous namespace
+
+const uint32_t ParallelBFS::Unreachable = std::numeric_limits<uint32_t>::max();
+const GraphElementId ParallelBFS::NoParent = std::numeric_limits<GraphElementId>::max();
+
+ParallelBFS::ParallelBFS(const BaseGraph::Ptr& graph)
+    : mpGraph(graph)
+    , mAlpha(15.0)
+    , mBeta(18.0)
+    , mpCSRGraph(NULL)
+    , mDepths(Unreachable)
+    , mParents(NoParent)
+    , mTopDownLevels(0)
+    , mBottomUpLevels(0)
+{
+}
+
+void ParallelBFS::setDirectionThresholds(double alpha, double beta)
+{
+    if(alpha <= 0 || beta <= 0)
+    {
+        throw std::invalid_argument("graph_analysis::algorithms::ParallelBFS::setDirectionThresholds: thresholds have to be positive");
+    }
+    mAlpha = alpha;
+    mBeta = beta;
+}
+
+void ParallelBFS::prepare()
+{
+    BaseGraph::Ptr denseGraph = mpGraph;
+    if(!dynamic_cast<const csr::DirectedGraph*>(mpGraph.get()))
+    {
+        denseGraph = mpGraph->snapshot();
+    }
+    if(denseGraph == mpDenseGraph)
+    {
+        return;
+    }
+
+    mpDenseGraph = denseGraph;
+    mpCSRGraph = static_cast<const csr::DirectedGraph*>(mpDenseGraph.get());
+    mVertexIds.clear();
+    if(mpDenseGraph != mpGraph)
+    {
+        mVertexIds.resize(mpCSRGraph->getVertexCount());
+        for(GraphElementId v = 0; v < mVertexIds.size(); ++v)
+        {
+            mVertexIds[v] = mpGraph->getVertexId(mpCSRGraph->getVertex(v));
+        }
+    }
+}
+
+void ParallelBFS::run(const Vertex::Ptr& startVertex)
+{
+    if(mpGraph->empty())
+    {
+        throw std::invalid_argument("graph_analysis::algorithms::ParallelBFS::run: search failed since graph is empty");
+    }
+    prepare();
+
+    const csr::DirectedGraph& graph = *mpCSRGraph;
+    size_t order = graph.getVertexCount();
+    Span<GraphElementId> outOffsets = graph.getOutOffsets();
+    Span<GraphElementId> outTargets = graph.getOutTargets();
+    Span<GraphElementId> inOffsets = graph.getInOffsets();
+    Span<GraphElementId> inSources = graph.getInSources();
+    Span<GraphElementId> inEdgeIds = graph.getInEdgeIds();
+    GraphElementId start = graph.getVertexId(startVertex);
+
+    // Search state by the ids of the dense graph, the tree edges are only
+    // required for the visitor
+    std::vector<uint32_t> depths(order, Unreachable);
+    std::vector<GraphElementId> parents(order, NoParent);
+    std::vector<GraphElementId> parentEdges(mpVisitor ? order : 0, NoParent);
+    GraphElementId* parentEdgeData = mpVisitor ? parentEdges.data() : NULL;
+
+    AtomicBitmap visited(order);
+    visited.testAndSet(start);
+    depths[start] = 0;
+    parents[start] = start;
+    if(mpVisitor)
+    {
+        mpVisitor->setGraph(mpGraph);
+        mpVisitor->startVertex(startVertex);
+    }
+
+    // The frontier is either a queue (top-down) or a bitmap (bottom-up)
+    std::vector<GraphElementId> frontier(1, start);
+    AtomicBitmap frontierBitmap(order);
+    AtomicBitmap nextBitmap(order);
+    bool bottomUp = false;
+    size_t frontierSize = 1;
+    size_t previousFrontierSize = 0;
+    uint64_t frontierEdges = outOffsets[start + 1] - outOffsets[start];
+    uint64_t unexploredEdges = graph.getEdgeCount() - (inOffsets[start + 1] - inOffsets[start]);
+
+    mTopDownLevels = 0;
+    mBottomUpLevels = 0;
+    for(uint32_t depth = 0; frontierSize != 0; ++depth)
+    {
+        if(!bottomUp && frontierEdges > unexploredEdges/mAlpha)
+        {
+            bottomUp = true;
+            frontierBitmap.clear();
+            utils::Parallel::forEachChunk(frontier.size(), [&](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; ++i)
+                {
+                    frontierBitmap.testAndSet(frontier[i]);
+                }
+            });
+        } else if(bottomUp && frontierSize < previousFrontierSize && frontierSize < order/mBeta)
+        {
+            bottomUp = false;
+            frontier = frontierBitmap.toVector();
+        }
+
+        std::mutex nextMutex;
+        std::vector<GraphElementId> next;
+        size_t nextSize = 0;
+        uint64_t nextEdges = 0;
+        uint64_t nextInEdges = 0;
+        if(bottomUp)
+        {
+            ++mBottomUpLevels;
+            nextBitmap.clear();
+            // Chunks consist of whole words, so that each thread owns the
+            // words of the visited and the next bitmap it modifies
+            utils::Parallel::forEachChunk(visited.getNumberOfWords(), [&](size_t begin, size_t end)
+            {
+                size_t localSize = 0;
+                uint64_t localEdges = 0;
+                uint64_t localInEdges = 0;
+                for(size_t w = begin; w < end; ++w)
+                {
+                    if(visited.getWord(w) == ~uint64_t(0))
+                    {
+                        continue;
+                    }
+
+                    for(GraphElementId v = w*64; v < std::min<size_t>(order, (w + 1)*64); ++v)
+                    {
+                        if(visited.test(v))
+                        {
+                            continue;
+                        }
+                        for(GraphElementId i = inOffsets[v]; i < inOffsets[v + 1]; ++i)
+                        {
+                            GraphElementId u = inSources[i];
+                            if(frontierBitmap.test(u))
+                            {
+                                depths[v] = depth + 1;
+                                parents[v] = u;
+                                if(parentEdgeData)
+                                {
+                                    parentEdgeData[v] = inEdgeIds[i];
+                                }
+                                visited.setExclusive(v);
+                                nextBitmap.setExclusive(v);
+                                ++localSize;
+                                localEdges += outOffsets[v + 1] - outOffsets[v];
+                                localInEdges += inOffsets[v + 1] - inOffsets[v];
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(nextMutex);
+                nextSize += localSize;
+                nextEdges += localEdges;
+                nextInEdges += localInEdges;
+            }, 16);
+        } else {
+            ++mTopDownLevels;
+            utils::Parallel::forEachChunk(frontier.size(), [&](size_t begin, size_t end)
+            {
+                std::vector<GraphElementId> localNext;
+                uint64_t localEdges = 0;
+                uint64_t localInEdges = 0;
+                for(size_t i = begin; i < end; ++i)
+                {
+                    GraphElementId v = frontier[i];
+                    for(GraphElementId e = outOffsets[v]; e < outOffsets[v + 1]; ++e)
+                    {
+                        GraphElementId w = outTargets[e];
+                        if(visited.testAndSet(w))
+                        {
+                            depths[w] = depth + 1;
+                            parents[w] = v;
+                            if(parentEdgeData)
+                            {
+                                parentEdgeData[w] = e;
+                            }
+                            localNext.push_back(w);
+                            localEdges += outOffsets[w + 1] - outOffsets[w];
+                            localInEdges += inOffsets[w + 1] - inOffsets[w];
+                        }
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(nextMutex);
+                next.insert(next.end(), localNext.begin(), localNext.end());
+                nextEdges += localEdges;
+                nextInEdges += localInEdges;
+            });
+            nextSize = next.size();
+        }
+
+        if(mpVisitor)
+        {
+            std::vector<GraphElementId> discovered = bottomUp ? nextBitmap.toVector() : next;
+            for(GraphElementId v : discovered)
+            {
+                mpVisitor->treeEdge(graph.getEdge(parentEdges[v]));
+                mpVisitor->discoverVertex(graph.getVertex(v));
+            }
+            std::vector<GraphElementId> finished = bottomUp ? frontierBitmap.toVector() : frontier;
+            for(GraphElementId v : finished)
+            {
+                mpVisitor->finishVertex(graph.getVertex(v));
+            }
+        }
+
+        if(bottomUp)
+        {
+            frontierBitmap.swap(nextBitmap);
+        } else {
+            frontier.swap(next);
+        }
+        previousFrontierSize = frontierSize;
+        frontierSize = nextSize;
+        frontierEdges = nextEdges;
+        unexploredEdges -= nextInEdges;
+    }
+
+    // Provide the results by the ids of the searched graph
+    mDepths = PropertyMap<uint32_t>(Unreachable, mpGraph->getVertexIdUpperBound());
+    mParents = PropertyMap<GraphElementId>(NoParent, mpGraph->getVertexIdUpperBound());
+    for(GraphElementId v = 0; v < order; ++v)
+    {
+        if(depths[v] == Unreachable)
+        {
+            continue;
+        }
+        if(mVertexIds.empty())
+        {
+            mDepths.set(v, depths[v]);
+            mParents.set(v, parents[v]);
+        } else {
+            mDepths.set(mVertexIds[v], depths[v]);
+            mParents.set(mVertexIds[v], mVertexIds[ parents[v] ]);
+        }
+    }
+}
+
+} // end namespace algorithms
+} // end namespace graph_analysis
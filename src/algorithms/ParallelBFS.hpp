@@ -0,0 +1,134 @@
+#ifndef GRAPH_ANALYSIS_ALGORITHMS_PARALLEL_BFS_HPP
+#define GRAPH_ANALYSIS_ALGORITHMS_PARALLEL_BFS_HPP
+
+#include <vector>
+#include "../BaseGraph.hpp"
+#include "../PropertyMap.hpp"
+#include "Visitor.hpp"
+
+namespace graph_analysis {
+
+namespace csr {
+    class DirectedGraph;
+}
+
+namespace algorithms {
+
+/**
+ * \class ParallelBFS
+ * \brief Multi-threaded, level-synchronous breadth-first search which
+ * computes the depth and the parent of every reachable vertex
+ * \details
+ * The search runs on the dense adjacency arrays of a csr::DirectedGraph. If
+ * the given graph is not a csr::DirectedGraph its (cached) snapshot is used,
+ * see BaseGraph::snapshot.
+ *
+ * Each level is expanded either top-down, i.e. the out edges of the
+ * frontier are followed, or bottom-up, i.e. every unvisited vertex searches
+ * its in edges for a parent in the frontier and stops at the first one
+ * found. The direction is chosen per level (Beamer et al., Direction-Optimizing
+ * Breadth-First Search): the search switches to bottom-up once the out edges
+ * of the frontier exceed 1/alpha of the in edges of the unvisited vertices,
+ * and back to top-down once the frontier shrinks below 1/beta of all
+ * vertices. The frontier is kept as queue top-down and as bitmap bottom-up.
+ * Each level is split into chunks which are processed concurrently, see
+ * utils::Parallel.
+ *
+ * The depth and parent maps are indexed by the vertex ids of the given
+ * graph. Which of several valid parents a vertex gets depends on the thread
+ * scheduling, the depths are deterministic.
+ *
+ * A visitor is optional. If set, it is called from the calling thread after
+ * each level: startVertex for the start vertex, treeEdge and discoverVertex
+ * for each vertex discovered in a level and finishVertex for each vertex of
+ * the previous frontier. Other edge events are not reported, and a search
+ * without visitor does not materialize any element.
+ */
+class ParallelBFS
+{
+public:
+    /// Depth of the vertices which are not reachable
+    static const uint32_t Unreachable;
+    /// Parent of the vertices which are not reachable, the start vertex is
+    /// its own parent
+    static const GraphElementId NoParent;
+
+    /**
+     * \param graph Graph to search
+     */
+    ParallelBFS(const BaseGraph::Ptr& graph);
+
+    /**
+     * Set the visitor, which is called for each level
+     * \param visitor Visitor object or a null pointer to disable callbacks
+     */
+    void setVisitor(const Visitor::Ptr& visitor) { mpVisitor = visitor; }
+
+    /**
+     * Set the thresholds which control the switching between top-down and
+     * bottom-up expansion
+     * \param alpha Switch to bottom-up, when the frontier has more than 1/alpha
+     * of the edges of the unvisited vertices
+     * \param beta Switch to top-down, when the frontier has less than 1/beta
+     * of all vertices
+     */
+    void setDirectionThresholds(double alpha, double beta);
+
+    /**
+     * Start the search at the given vertex
+     * \throw std::invalid_argument if the graph is empty
+     * \throw std::runtime_error if the start vertex is not part of the graph
+     */
+    void run(const Vertex::Ptr& startVertex);
+
+    /**
+     * Get the depth of every vertex after the search, Unreachable for
+     * vertices which have not been discovered
+     */
+    const PropertyMap<uint32_t>& getDepths() const { return mDepths; }
+
+    /**
+     * Get the id of the parent of every vertex in the search tree,
+     * NoParent for vertices which have not been discovered
+     */
+    const PropertyMap<GraphElementId>& getParents() const { return mParents; }
+
+    /**
+     * Get the number of levels of the last search, which have been expanded
+     * top-down
+     */
+    size_t getTopDownLevelCount() const { return mTopDownLevels; }
+
+    /**
+     * Get the number of levels of the last search, which have been expanded
+     * bottom-up
+     */
+    size_t getBottomUpLevelCount() const { return mBottomUpLevels; }
+
+private:
+    /**
+     * Update the dense graph and the mapping of its vertex ids to the ids
+     * of the searched graph
+     */
+    void prepare();
+
+    BaseGraph::Ptr mpGraph;
+    Visitor::Ptr mpVisitor;
+    double mAlpha;
+    double mBeta;
+
+    BaseGraph::Ptr mpDenseGraph;
+    const csr::DirectedGraph* mpCSRGraph;
+    /// Id in the searched graph per vertex id of the dense graph, empty if
+    /// the searched graph is the dense graph
+    std::vector<GraphElementId> mVertexIds;
+
+    PropertyMap<uint32_t> mDepths;
+    PropertyMap<GraphElementId> mParents;
+    size_t mTopDownLevels;
+    size_t mBottomUpLevels;
+};
+
+} // end namespace algorithms
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_ALGORITHMS_PARALLEL_BFS_HPP
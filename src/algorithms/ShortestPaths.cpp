@@ -0,0 +1,381 @@
+#include "ShortestPaths.hpp"
+#include "../csr/DirectedGraph.hpp"
+#include "../utils/Parallel.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+namespace graph_analysis {
+namespace algorithms {
+
+namespace {
+
+/**
+ * Get a key which preserves the order of non-negative doubles
+ */
+uint64_t toKey(double distance)
+{
+    uint64_t key;
+    memcpy(&key, &distance, sizeof(key));
+    return key;
+}
+
+/**
+ * Get the number of significant bits
+ */
+size_t getBitLength(uint64_t value)
+{
+#if defined(__GNUC__)
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+#else
+    size_t length = 0;
+    for(; value != 0; value >>= 1)
+    {
+        ++length;
+    }
+    return length;
+#endif
+}
+
+/**
+ * \brief Monotone priority queue, i.e. a pushed key must not be smaller
+ * than the last popped key
+ * \details An entry is stored in the bucket given by the highest bit in
+ * which its key differs from the last popped key. Popping redistributes
+ * only the first nonempty bucket, so that each entry is moved at most 64
+ * times
+ */
+class RadixHeap
+{
+public:
+    typedef std::pair<uint64_t, GraphElementId> Entry;
+
+    RadixHeap()
+        : mBuckets(65)
+        , mLast(0)
+        , mSize(0)
+    {}
+
+    bool empty() const { return mSize == 0; }
+
+    void push(uint64_t key, GraphElementId value)
+    {
+        mBuckets[ getBitLength(key ^ mLast) ].push_back(Entry(key, value));
+        ++mSize;
+    }
+
+    Entry pop()
+    {
+        if(mBuckets[0].empty())
+        {
+            size_t i = 1;
+            while(mBuckets[i].empty())
+            {
+                ++i;
+            }
+
+            std::vector<Entry>& bucket = mBuckets[i];
+            mLast = std::min_element(bucket.begin(), bucket.end())->first;
+            for(const Entry& entry : bucket)
+            {
+                mBuckets[ getBitLength(entry.first ^ mLast) ].push_back(entry);
+            }
+            bucket.clear();
+        }
+
+        Entry entry = mBuckets[0].back();
+        mBuckets[0].pop_back();
+        --mSize;
+        return entry;
+    }
+
+private:
+    std::vector< std::vector<Entry> > mBuckets;
+    uint64_t mLast;
+    size_t mSize;
+};
+
+/**
+ * Get the index of the bucket of the given width which contains the
+ * distance
+ * \details Quotients beyond the range of size_t share the last bucket, so
+ * that the conversion is defined for any distance and width
+ */
+size_t getBucket(double distance, double delta)
+{
+    const double lastBucket = static_cast<double>(std::numeric_limits<size_t>::max()/2);
+    double bucket = distance/delta;
+    if(bucket < lastBucket)
+    {
+        return static_cast<size_t>(bucket);
+    }
+    return static_cast<size_t>(lastBucket);
+}
+
+/// Frontiers with fewer vertices are relaxed by the calling thread only,
+/// since dispatching them to the workers costs more than it saves
+const size_t MinParallelFrontierSize = 256;
+
+/**
+ * Request to relax the distance of a vertex
+ */
+struct Request
+{
+    GraphElementId target;
+    GraphElementId predecessor;
+    double distance;
+
+    Request(GraphElementId t, GraphElementId p, double d)
+        : target(t)
+        , predecessor(p)
+        , distance(d)
+    {}
+};
+
+} // end anonymous namespace
+
+const GraphElementId ShortestPaths::NoPredecessor = std::numeric_limits<GraphElementId>::max();
+
+ShortestPaths::ShortestPaths(const BaseGraph::Ptr& graph, Algorithms::EdgeWeightFunction edgeWeightFunction)
+    : mpGraph(graph)
+    , mpDenseGraph(graph)
+    , mMeanWeight(0)
+    , mDistances(std::numeric_limits<double>::infinity())
+    , mPredecessors(NoPredecessor)
+{
+    if(!dynamic_cast<const csr::DirectedGraph*>(mpGraph.get()))
+    {
+        mpDenseGraph = mpGraph->snapshot();
+        mpCSRGraph = static_cast<const csr::DirectedGraph*>(mpDenseGraph.get());
+        mVertexIds.resize(mpCSRGraph->getVertexCount());
+        for(GraphElementId v = 0; v < mVertexIds.size(); ++v)
+        {
+            mVertexIds[v] = mpGraph->getVertexId(mpCSRGraph->getVertex(v));
+        }
+    } else {
+        mpCSRGraph = static_cast<const csr::DirectedGraph*>(mpDenseGraph.get());
+    }
+
+    mWeights.resize(mpCSRGraph->getEdgeCount());
+    double sum = 0;
+    for(GraphElementId e = 0; e < mWeights.size(); ++e)
+    {
+        double weight = edgeWeightFunction(mpCSRGraph->getEdge(e));
+        if(!(weight >= 0))
+        {
+            throw std::invalid_argument("graph_analysis::algorithms::ShortestPaths: edge weights have to be non-negative");
+        }
+        mWeights[e] = weight;
+        sum += weight;
+    }
+    if(!mWeights.empty())
+    {
+        mMeanWeight = sum/mWeights.size();
+    }
+}
+
+void ShortestPaths::run(const Vertex::Ptr& source, Method method, double delta)
+{
+    GraphElementId sourceId = mpCSRGraph->getVertexId(source);
+    size_t order = mpCSRGraph->getVertexCount();
+
+    std::vector<double> distances(order, std::numeric_limits<double>::infinity());
+    std::vector<GraphElementId> predecessors(order, NoPredecessor);
+    switch(method)
+    {
+        case DIJKSTRA:
+            dijkstra(sourceId, distances, predecessors);
+            break;
+        case DELTA_STEPPING:
+            if(delta <= 0)
+            {
+                delta = mMeanWeight > 0 ? mMeanWeight : 1.0;
+            }
+            deltaStepping(sourceId, delta, distances, predecessors);
+            break;
+        default:
+            throw std::invalid_argument("graph_analysis::algorithms::ShortestPaths::run: unknown method");
+    }
+
+    // Provide the results by the ids of the searched graph
+    mDistances = PropertyMap<double>(std::numeric_limits<double>::infinity(), mpGraph->getVertexIdUpperBound());
+    mPredecessors = PropertyMap<GraphElementId>(NoPredecessor, mpGraph->getVertexIdUpperBound());
+    for(GraphElementId v = 0; v < order; ++v)
+    {
+        if(predecessors[v] == NoPredecessor)
+        {
+            continue;
+        }
+        if(mVertexIds.empty())
+        {
+            mDistances.set(v, distances[v]);
+            mPredecessors.set(v, predecessors[v]);
+        } else {
+            mDistances.set(mVertexIds[v], distances[v]);
+            mPredecessors.set(mVertexIds[v], mVertexIds[ predecessors[v] ]);
+        }
+    }
+}
+
+void ShortestPaths::dijkstra(GraphElementId source, std::vector<double>& distances, std::vector<GraphElementId>& predecessors) const
+{
+    Span<GraphElementId> outOffsets = mpCSRGraph->getOutOffsets();
+    Span<GraphElementId> outTargets = mpCSRGraph->getOutTargets();
+
+    distances[source] = 0;
+    predecessors[source] = source;
+    RadixHeap heap;
+    heap.push(toKey(0.0), source);
+    while(!heap.empty())
+    {
+        RadixHeap::Entry entry = heap.pop();
+        GraphElementId v = entry.second;
+        // Skip entries which have been superseded by a shorter distance
+        if(entry.first != toKey(distances[v]))
+        {
+            continue;
+        }
+
+        for(GraphElementId e = outOffsets[v]; e < outOffsets[v + 1]; ++e)
+        {
+            GraphElementId target = outTargets[e];
+            double distance = distances[v] + mWeights[e];
+            if(distance < distances[target])
+            {
+                distances[target] = distance;
+                predecessors[target] = v;
+                heap.push(toKey(distance), target);
+            }
+        }
+    }
+}
+
+void ShortestPaths::deltaStepping(GraphElementId source, double delta, std::vector<double>& distances, std::vector<GraphElementId>& predecessors) const
+{
+    Span<GraphElementId> outOffsets = mpCSRGraph->getOutOffsets();
+    Span<GraphElementId> outTargets = mpCSRGraph->getOutTargets();
+    size_t order = mpCSRGraph->getVertexCount();
+
+    // Each vertex is owned by one partition, which alone updates its
+    // distance and inserts it into the buckets
+    size_t numberOfPartitions = utils::Parallel::getNumberOfThreads();
+    typedef std::map<size_t, std::vector<GraphElementId> > Buckets;
+    std::vector<Buckets> buckets(numberOfPartitions);
+    // Requests per producing and per owning partition
+    std::vector< std::vector< std::vector<Request> > > requests(numberOfPartitions,
+            std::vector< std::vector<Request> >(numberOfPartitions));
+    // Distance at which the light edges of a vertex have been relaxed
+    std::vector<double> relaxedDistances(order, std::numeric_limits<double>::infinity());
+
+    distances[source] = 0;
+    predecessors[source] = source;
+    buckets[source % numberOfPartitions][0].push_back(source);
+
+    // Relax the light or the heavy edges of the given vertices
+    std::function<void(const std::vector<GraphElementId>&, bool)> relax = [&](const std::vector<GraphElementId>& vertices, bool light)
+    {
+        // A single chunk covering all partitions is processed sequentially
+        size_t minChunkSize = vertices.size() < MinParallelFrontierSize ? numberOfPartitions : 1;
+        utils::Parallel::forEachChunk(numberOfPartitions, [&](size_t begin, size_t end)
+        {
+            for(size_t p = begin; p < end; ++p)
+            {
+                size_t first = vertices.size()*p/numberOfPartitions;
+                size_t last = vertices.size()*(p + 1)/numberOfPartitions;
+                for(size_t i = first; i < last; ++i)
+                {
+                    GraphElementId v = vertices[i];
+                    for(GraphElementId e = outOffsets[v]; e < outOffsets[v + 1]; ++e)
+                    {
+                        if((mWeights[e] <= delta) != light)
+                        {
+                            continue;
+                        }
+                        GraphElementId target = outTargets[e];
+                        double distance = distances[v] + mWeights[e];
+                        if(distance < distances[target])
+                        {
+                            requests[p][target % numberOfPartitions].push_back(Request(target, v, distance));
+                        }
+                    }
+                }
+            }
+        }, minChunkSize);
+
+        utils::Parallel::forEachChunk(numberOfPartitions, [&](size_t begin, size_t end)
+        {
+            for(size_t owner = begin; owner < end; ++owner)
+            {
+                for(size_t p = 0; p < numberOfPartitions; ++p)
+                {
+                    for(const Request& request : requests[p][owner])
+                    {
+                        if(request.distance < distances[request.target])
+                        {
+                            distances[request.target] = request.distance;
+                            predecessors[request.target] = request.predecessor;
+                            buckets[owner][ getBucket(request.distance, delta) ].push_back(request.target);
+                        }
+                    }
+                    requests[p][owner].clear();
+                }
+            }
+        }, minChunkSize);
+    };
+
+    while(true)
+    {
+        size_t current = std::numeric_limits<size_t>::max();
+        for(const Buckets& partitionBuckets : buckets)
+        {
+            if(!partitionBuckets.empty())
+            {
+                current = std::min(current, partitionBuckets.begin()->first);
+            }
+        }
+        if(current == std::numeric_limits<size_t>::max())
+        {
+            break;
+        }
+
+        // Light edges can reinsert vertices into the current bucket, so it
+        // is processed until it remains empty
+        std::vector<GraphElementId> settled;
+        while(true)
+        {
+            std::vector<GraphElementId> frontier;
+            for(Buckets& partitionBuckets : buckets)
+            {
+                Buckets::iterator it = partitionBuckets.find(current);
+                if(it == partitionBuckets.end())
+                {
+                    continue;
+                }
+                for(GraphElementId v : it->second)
+                {
+                    // Skip outdated and duplicate entries
+                    if(getBucket(distances[v], delta) == current && relaxedDistances[v] != distances[v])
+                    {
+                        relaxedDistances[v] = distances[v];
+                        frontier.push_back(v);
+                    }
+                }
+                partitionBuckets.erase(it);
+            }
+            if(frontier.empty())
+            {
+                break;
+            }
+
+            settled.insert(settled.end(), frontier.begin(), frontier.end());
+            relax(frontier, true);
+        }
+
+        relax(settled, false);
+    }
+}
+
+} // end namespace algorithms
+} // end namespace graph_analysis
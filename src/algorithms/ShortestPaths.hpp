@@ -0,0 +1,106 @@
+#ifndef GRAPH_ANALYSIS_ALGORITHMS_SHORTEST_PATHS_HPP
+#define GRAPH_ANALYSIS_ALGORITHMS_SHORTEST_PATHS_HPP
+
+#include <vector>
+#include "../BaseGraph.hpp"
+#include "../PropertyMap.hpp"
+
+namespace graph_analysis {
+
+namespace csr {
+    class DirectedGraph;
+}
+
+namespace algorithms {
+
+/**
+ * \class ShortestPaths
+ * \brief Single-source shortest paths for non-negative edge weights
+ * \details
+ * The search runs on the adjacency arrays of a csr::DirectedGraph. If the
+ * given graph is not a csr::DirectedGraph its snapshot at construction
+ * time is used, see BaseGraph::snapshot. The edge weights are retrieved once
+ * at construction into an array indexed by edge id, so that any number of
+ * searches can run without calling the weight function again.
+ *
+ * Two methods are available:
+ *  - DIJKSTRA: sequential Dijkstra using a radix heap, which exploits that
+ *    the extracted distances are monotone
+ *  - DELTA_STEPPING: parallel delta-stepping (Meyer and Sanders), which
+ *    settles all vertices in a distance bucket of width delta concurrently.
+ *    Relaxations are sent to the thread owning the target vertex, so no
+ *    atomic operations are required. Small buckets are relaxed by the
+ *    calling thread only
+ *
+ * The distance and predecessor maps are indexed by the vertex ids of the
+ * given graph.
+ */
+class ShortestPaths
+{
+public:
+    enum Method { DIJKSTRA, DELTA_STEPPING };
+
+    /// Predecessor of unreachable vertices, the source is its own
+    /// predecessor
+    static const GraphElementId NoPredecessor;
+
+    /**
+     * \param graph Graph to search
+     * \param edgeWeightFunction function that allows retrieving the weight of
+     * an edge
+     * \throw std::invalid_argument if the weight of an edge is negative or
+     * not a number
+     */
+    ShortestPaths(const BaseGraph::Ptr& graph, Algorithms::EdgeWeightFunction edgeWeightFunction);
+
+    /**
+     * Compute the distances from the source to all vertices
+     * \param source Source vertex
+     * \param method Method to use
+     * \param delta Bucket width for DELTA_STEPPING, 0 to use the mean edge
+     * weight. Distances beyond 2^63 bucket widths share a single bucket, which
+     * keeps the result exact but degrades the search to label correcting
+     * \throw std::runtime_error if the source is not part of the graph
+     */
+    void run(const Vertex::Ptr& source, Method method = DIJKSTRA, double delta = 0);
+
+    /**
+     * Get the distance of every vertex from the source, infinity for
+     * vertices which are not reachable
+     */
+    const PropertyMap<double>& getDistances() const { return mDistances; }
+
+    /**
+     * Get the id of the predecessor of every vertex on a shortest path from
+     * the source, NoPredecessor for vertices which are not reachable
+     */
+    const PropertyMap<GraphElementId>& getPredecessors() const { return mPredecessors; }
+
+private:
+    /**
+     * Sequential Dijkstra on the dense graph
+     */
+    void dijkstra(GraphElementId source, std::vector<double>& distances, std::vector<GraphElementId>& predecessors) const;
+
+    /**
+     * Parallel delta-stepping on the dense graph
+     */
+    void deltaStepping(GraphElementId source, double delta, std::vector<double>& distances, std::vector<GraphElementId>& predecessors) const;
+
+    BaseGraph::Ptr mpGraph;
+    BaseGraph::Ptr mpDenseGraph;
+    const csr::DirectedGraph* mpCSRGraph;
+    /// Id in the searched graph per vertex id of the dense graph, empty if
+    /// the searched graph is the dense graph
+    std::vector<GraphElementId> mVertexIds;
+    /// Weight per edge id of the dense graph
+    std::vector<double> mWeights;
+    double mMeanWeight;
+
+    PropertyMap<double> mDistances;
+    PropertyMap<GraphElementId> mPredecessors;
+};
+
+} // end namespace algorithms
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_ALGORITHMS_SHORTEST_PATHS_HPP
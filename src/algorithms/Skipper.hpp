@@ -6,7 +6,7 @@ namespace graph_analysis {
 namespace algorithms {
 
 /// Definition of the EdgeSkipper function
-typedef function1<bool,Edge::Ptr> Skipper;
+typedef function1<bool, const Edge::Ptr&> Skipper;
 
 } // end namespace algorithms
 } // end namespace graph_analysis
@@ -0,0 +1,156 @@
+#ifndef GRAPH_ANALYSIS_ALGORITHMS_STATIC_DFS_HPP
+#define GRAPH_ANALYSIS_ALGORITHMS_STATIC_DFS_HPP
+
+#include <vector>
+#include <stdexcept>
+#include "../BaseGraph.hpp"
+#include "../PropertyMap.hpp"
+#include "Skipper.hpp"
+#include "StaticVisitor.hpp"
+
+namespace graph_analysis {
+namespace algorithms {
+
+/**
+  * \class StaticDFS
+  * \brief Depth-First-Search, which calls the visitor without virtual
+  * dispatch
+  * \details The visitor type has to provide the callbacks of StaticVisitor,
+  * usually by deriving from it. The status of the vertices is kept by the
+  * search in a dense map, which is reset on each run, unless the visitor
+  * provides the status to continue from (see StaticVisitor::getVertexStatus).
+  * \tparam VisitorT type of the visitor
+  */
+template<typename VisitorT>
+class StaticDFS
+{
+public:
+    /**
+      * \param graph Graph to search
+      * \param visitor Visitor object, which will be called, when the search
+      * visits a vertex or edge; it has to outlive the search
+      * \param skipper Skipper object to defined, when an edge does not need to
+      * be followed
+      */
+    StaticDFS(const BaseGraph::Ptr& graph, VisitorT& visitor, Skipper skipper = Skipper())
+        : mpGraph(graph)
+        , mVisitor(visitor)
+        , mSkipper(skipper)
+        , mVertexStatus(Visitor::UNKNOWN)
+        , mpVertexStatus(&mVertexStatus)
+    {}
+
+    /**
+      * Start the algorithm beginning at the specified vertex
+      * \details The search borrows the vertices and edges from the graph,
+      * i.e. the visitor receives references which remain valid only as long
+      * as the graph is not modified
+      * \param startVertex Start vertex of the search, by default the first
+      * vertex of the graph
+      */
+    void run(const Vertex::Ptr& startVertex = Vertex::Ptr());
+
+    /**
+      * Get the status of a vertex in the last search
+      */
+    Visitor::Status getStatus(const Vertex::Ptr& vertex) const { return mpVertexStatus->get(mpGraph->getVertexId(vertex)); }
+
+private:
+    BaseGraph::Ptr mpGraph;
+    VisitorT& mVisitor;
+    Skipper mSkipper;
+    Vertex::Ptr mStartVertex;
+    /// Borrowed references to the vertices held by the start vertex and the
+    /// traversed edges, which avoids the reference counting per edge
+    std::vector<const Vertex::Ptr*> mStack;
+    PropertyMap<Visitor::Status> mVertexStatus;
+    /// Status used by the last search, either mVertexStatus or the status
+    /// kept by the visitor
+    PropertyMap<Visitor::Status>* mpVertexStatus;
+};
+
+template<typename VisitorT>
+void StaticDFS<VisitorT>::run(const Vertex::Ptr& startVertex)
+{
+    if(mpGraph->empty())
+    {
+        throw std::invalid_argument("graph_analysis::algorithms::DFS::run: search failed since graph is empty");
+    }
+    // Keep the borrowed vertices and edges alive until the search ends
+    BaseGraph::ElementRetention retention(*mpGraph);
+
+    if(startVertex)
+    {
+        mStartVertex = startVertex;
+    } else {
+        VertexIterator::Ptr vertexIt = mpGraph->getVertexIterator();
+        if(vertexIt->next())
+        {
+            mStartVertex = vertexIt->current();
+        }
+    }
+    // Continue from the status kept by the visitor, if it provides one
+    mpVertexStatus = mVisitor.getVertexStatus();
+    if(!mpVertexStatus)
+    {
+        mVertexStatus = PropertyMap<Visitor::Status>(Visitor::UNKNOWN, mpGraph->getVertexIdUpperBound());
+        mpVertexStatus = &mVertexStatus;
+    }
+    PropertyMap<Visitor::Status>& vertexStatus = *mpVertexStatus;
+
+    mStack.push_back(&mStartVertex);
+    vertexStatus.set(mpGraph->getVertexId(mStartVertex), Visitor::REGISTERED);
+    mVisitor.initializeVertex(mStartVertex);
+
+    while(!mStack.empty())
+    {
+        const Vertex::Ptr& vertex = *mStack.back();
+        mStack.pop_back();
+
+        EdgeIterator::Ptr edgeIt = mpGraph->getOutEdgeIterator(vertex);
+        bool edges = false;
+        while(edgeIt->next())
+        {
+            edges = true;
+            const Edge::Ptr& edge = edgeIt->current();
+            if(mSkipper && mSkipper(edge))
+            {
+                continue;
+            }
+            mVisitor.examineEdge(edge);
+
+            const Vertex::Ptr& targetVertex = edge->getTargetVertex();
+            GraphElementId targetVertexId = mpGraph->getVertexId(targetVertex);
+            switch(vertexStatus[targetVertexId])
+            {
+                case Visitor::UNKNOWN:
+                    mVisitor.treeEdge(edge);
+                    mStack.push_back(&targetVertex);
+                    mVisitor.discoverVertex(targetVertex);
+                    // Set after the callbacks as they might grow the status
+                    // map
+                    vertexStatus.set(targetVertexId, Visitor::REGISTERED);
+                    break;
+                case Visitor::REGISTERED:
+                    mVisitor.backEdge(edge);
+                    break;
+                case Visitor::VISITED:
+                    mVisitor.forwardOrCrossEdge(edge);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        vertexStatus.set(mpGraph->getVertexId(vertex), Visitor::VISITED);
+        if(!edges)
+        {
+            mVisitor.leafVertex(vertex);
+        }
+        mVisitor.finishVertex(vertex);
+    }
+}
+
+} // end namespace algorithms
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_ALGORITHMS_STATIC_DFS_HPP
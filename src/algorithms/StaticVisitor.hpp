@@ -0,0 +1,142 @@
+#ifndef GRAPH_ANALYSIS_ALGORITHMS_STATIC_VISITOR_HPP
+#define GRAPH_ANALYSIS_ALGORITHMS_STATIC_VISITOR_HPP
+
+#include "Visitor.hpp"
+
+namespace graph_analysis {
+namespace algorithms {
+
+/**
+ * \class StaticVisitor
+ * \brief Base class of the visitors for StaticBFS and StaticDFS
+ * \details The traversals are templates on the visitor type and call the
+ * callbacks of the visitor directly, i.e. without virtual dispatch. All
+ * callbacks of this base class are empty, so that a visitor only defines
+ * (i.e. hides) the callbacks it is interested in and all other calls are
+ * optimized away:
+ * \verbatim
+ struct LeafCounter : public StaticVisitor
+ {
+     size_t leafs;
+     LeafCounter() : leafs(0) {}
+     void leafVertex(const Vertex::Ptr& vertex) { ++leafs; }
+ };
+
+ LeafCounter counter;
+ StaticBFS<LeafCounter> bfs(graph, counter);
+ bfs.run(rootVertex);
+ \endverbatim
+ */
+class StaticVisitor
+{
+public:
+    /**
+     * Called when the vertex is initialized
+     */
+    void initializeVertex(const Vertex::Ptr&) {}
+
+    /**
+     * Called when the start vertex is identified
+     */
+    void startVertex(const Vertex::Ptr&) {}
+
+    /**
+     * Called when a vertex is discovered
+     */
+    void discoverVertex(const Vertex::Ptr&) {}
+
+    /**
+     * Called when a vertex has been completely processed
+     */
+    void finishVertex(const Vertex::Ptr&) {}
+
+    /**
+     * Called when a leaf vertex - so no outgoing edges - is discovered
+     */
+    void leafVertex(const Vertex::Ptr&) {}
+
+    /**
+     * Called when examining an edge - after it has been checked whether to
+     * skip the edge or not
+     */
+    void examineEdge(const Edge::Ptr&) {}
+
+    /**
+     * Called when an edge leads to a previously unknown vertex
+     */
+    void treeEdge(const Edge::Ptr&) {}
+
+    /**
+     * Called when an edge has been encountered that leads to an already
+     * visited node
+     */
+    void forwardOrCrossEdge(const Edge::Ptr&) {}
+
+    /**
+     * Called when an edge leads to a vertex which has been discovered, but
+     * not yet finished
+     */
+    void backEdge(const Edge::Ptr&) {}
+
+    /**
+     * Get the status of the vertices to continue a search from
+     * \return status map, which the search updates, or NULL if each search
+     * keeps the status itself and starts with all vertices being unknown
+     */
+    PropertyMap<Visitor::Status>* getVertexStatus() { return NULL; }
+};
+
+/**
+ * \class VisitorAdapter
+ * \brief Forwards the callbacks of a static traversal to a Visitor
+ * \details The search continues from the status of the vertices kept by the
+ * Visitor, i.e. vertices which have been visited by a previous search with
+ * the same visitor are not discovered again, as with the virtual Visitor
+ * API. If the visitor is bound to the searched graph (see
+ * Visitor::setGraph) the search updates its status map directly, otherwise
+ * the adapter sets the status via the Visitor
+ */
+class VisitorAdapter : public StaticVisitor
+{
+public:
+    explicit VisitorAdapter(const Visitor::Ptr& visitor)
+        : mpVisitor(visitor)
+    {}
+
+    void initializeVertex(const Vertex::Ptr& vertex)
+    {
+        mpVisitor->setStatus(vertex, Visitor::REGISTERED);
+        mpVisitor->initializeVertex(vertex);
+    }
+    void startVertex(const Vertex::Ptr& vertex) { mpVisitor->startVertex(vertex); }
+    void discoverVertex(const Vertex::Ptr& vertex)
+    {
+        mpVisitor->discoverVertex(vertex);
+        mpVisitor->setStatus(vertex, Visitor::REGISTERED);
+    }
+    /// A vertex is visited once its edges have been examined, i.e. before
+    /// leafVertex or finishVertex is called
+    void leafVertex(const Vertex::Ptr& vertex)
+    {
+        mpVisitor->setStatus(vertex, Visitor::VISITED);
+        mpVisitor->leafVertex(vertex);
+    }
+    void finishVertex(const Vertex::Ptr& vertex)
+    {
+        mpVisitor->setStatus(vertex, Visitor::VISITED);
+        mpVisitor->finishVertex(vertex);
+    }
+    void examineEdge(const Edge::Ptr& edge) { mpVisitor->examineEdge(edge); }
+    void treeEdge(const Edge::Ptr& edge) { mpVisitor->treeEdge(edge); }
+    void forwardOrCrossEdge(const Edge::Ptr& edge) { mpVisitor->forwardOrCrossEdge(edge); }
+    void backEdge(const Edge::Ptr& edge) { mpVisitor->backEdge(edge); }
+
+    PropertyMap<Visitor::Status>* getVertexStatus() { return mpVisitor->getBoundVertexStatus(); }
+
+private:
+    Visitor::Ptr mpVisitor;
+};
+
+} // end namespace algorithms
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_ALGORITHMS_STATIC_VISITOR_HPP
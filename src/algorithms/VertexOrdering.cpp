@@ -0,0 +1,179 @@
+#include "VertexOrdering.hpp"
+#include "../PropertyMap.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace graph_analysis {
+namespace algorithms {
+
+namespace {
+
+/**
+ * Undirected adjacency of the vertices by their position in the iteration
+ * order, in compressed sparse row layout
+ */
+struct Adjacency
+{
+    std::vector<size_t> offsets;
+    std::vector<size_t> neighbours;
+
+    size_t degree(size_t position) const { return offsets[position + 1] - offsets[position]; }
+};
+
+struct DegreeLess
+{
+    const Adjacency& adjacency;
+    DegreeLess(const Adjacency& a) : adjacency(a) {}
+    bool operator()(size_t a, size_t b) const { return adjacency.degree(a) < adjacency.degree(b); }
+};
+
+struct DegreeGreater
+{
+    const Adjacency& adjacency;
+    DegreeGreater(const Adjacency& a) : adjacency(a) {}
+    bool operator()(size_t a, size_t b) const { return adjacency.degree(a) > adjacency.degree(b); }
+};
+
+/**
+ * Order the vertices breadth-first, starting a new search at the next
+ * unvisited candidate once a component is exhausted
+ * \param sortByDegree if true, the newly discovered neighbours of a vertex
+ * are enqueued by ascending degree, otherwise in adjacency order
+ */
+std::vector<size_t> breadthFirst(const Adjacency& adjacency, const std::vector<size_t>& candidates, bool sortByDegree)
+{
+    size_t order = candidates.size();
+    std::vector<size_t> positions;
+    positions.reserve(order);
+    PropertyMap<bool> visited(false, order);
+
+    std::vector<size_t>::const_iterator cit = candidates.begin();
+    for(; cit != candidates.end(); ++cit)
+    {
+        if(visited.get(*cit))
+        {
+            continue;
+        }
+        visited.set(*cit, true);
+        positions.push_back(*cit);
+
+        // The result serves as queue
+        for(size_t head = positions.size() - 1; head < positions.size(); ++head)
+        {
+            size_t position = positions[head];
+            size_t discovered = positions.size();
+            for(size_t i = adjacency.offsets[position]; i < adjacency.offsets[position + 1]; ++i)
+            {
+                size_t neighbour = adjacency.neighbours[i];
+                if(!visited.get(neighbour))
+                {
+                    visited.set(neighbour, true);
+                    positions.push_back(neighbour);
+                }
+            }
+
+            if(sortByDegree)
+            {
+                std::stable_sort(positions.begin() + discovered, positions.end(), DegreeLess(adjacency));
+            }
+        }
+    }
+    return positions;
+}
+
+} // end anonymous namespace
+
+std::vector<Vertex::Ptr> VertexOrdering::compute(const BaseGraph::Ptr& graph, Strategy strategy)
+{
+    std::vector<Vertex::Ptr> vertices = graph->getAllVertices();
+    size_t order = vertices.size();
+
+    VertexPropertyMap<size_t> positions(graph);
+    for(size_t i = 0; i < order; ++i)
+    {
+        positions.set(vertices[i], i);
+    }
+
+    // Counting sort of the edge endpoints into the undirected adjacency,
+    // self loops do not matter for the order
+    std::vector< std::pair<size_t, size_t> > endpoints;
+    Adjacency adjacency;
+    adjacency.offsets.assign(order + 1, 0);
+    EdgeIterator::Ptr edgeIt = graph->getEdgeIterator();
+    while(edgeIt->next())
+    {
+        const Edge::Ptr& edge = edgeIt->current();
+        size_t source = positions.get(edge->getSourceVertex());
+        size_t target = positions.get(edge->getTargetVertex());
+        if(source != target)
+        {
+            endpoints.push_back(std::make_pair(source, target));
+            ++adjacency.offsets[source + 1];
+            ++adjacency.offsets[target + 1];
+        }
+    }
+    for(size_t v = 0; v < order; ++v)
+    {
+        adjacency.offsets[v + 1] += adjacency.offsets[v];
+    }
+
+    adjacency.neighbours.resize(adjacency.offsets.back());
+    std::vector<size_t> insertPosition(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    std::vector< std::pair<size_t, size_t> >::const_iterator eit = endpoints.begin();
+    for(; eit != endpoints.end(); ++eit)
+    {
+        adjacency.neighbours[ insertPosition[eit->first]++ ] = eit->second;
+        adjacency.neighbours[ insertPosition[eit->second]++ ] = eit->first;
+    }
+
+    std::vector<size_t> iterationOrder(order);
+    for(size_t i = 0; i < order; ++i)
+    {
+        iterationOrder[i] = i;
+    }
+
+    std::vector<size_t> newOrder;
+    switch(strategy)
+    {
+        case DEGREE_DESCENDING:
+            newOrder = iterationOrder;
+            std::stable_sort(newOrder.begin(), newOrder.end(), DegreeGreater(adjacency));
+            break;
+        case REVERSE_CUTHILL_MCKEE:
+        {
+            // Start each component at a vertex of minimum degree
+            std::vector<size_t> candidates = iterationOrder;
+            std::stable_sort(candidates.begin(), candidates.end(), DegreeLess(adjacency));
+            newOrder = breadthFirst(adjacency, candidates, true);
+            std::reverse(newOrder.begin(), newOrder.end());
+            break;
+        }
+        case BREADTH_FIRST:
+        {
+            // Start each component at its hub
+            std::vector<size_t> candidates = iterationOrder;
+            std::stable_sort(candidates.begin(), candidates.end(), DegreeGreater(adjacency));
+            newOrder = breadthFirst(adjacency, candidates, false);
+            break;
+        }
+        default:
+            throw std::invalid_argument("graph_analysis::algorithms::VertexOrdering: unknown ordering strategy");
+    }
+
+    std::vector<Vertex::Ptr> orderedVertices;
+    orderedVertices.reserve(order);
+    std::vector<size_t>::const_iterator cit = newOrder.begin();
+    for(; cit != newOrder.end(); ++cit)
+    {
+        orderedVertices.push_back(vertices[*cit]);
+    }
+    return orderedVertices;
+}
+
+BaseGraph::Ptr VertexOrdering::freeze(const BaseGraph::Ptr& graph, Strategy strategy)
+{
+    return graph->freeze( compute(graph, strategy) );
+}
+
+} // end namespace algorithms
+} // end namespace graph_analysis
@@ -0,0 +1,54 @@
+#ifndef GRAPH_ANALYSIS_ALGORITHMS_VERTEX_ORDERING_HPP
+#define GRAPH_ANALYSIS_ALGORITHMS_VERTEX_ORDERING_HPP
+
+#include <vector>
+#include "../BaseGraph.hpp"
+
+namespace graph_analysis {
+namespace algorithms {
+
+/**
+ * \class VertexOrdering
+ * \brief Compute vertex orders which improve the cache locality of
+ * traversals
+ * \details Vertex ids are assigned in insertion order, which is usually
+ * unrelated to the structure of the graph. A vertex order computed here is a
+ * permutation of all vertices of the graph, which can be applied to a
+ * read-only snapshot via BaseGraph::freeze(vertexOrder). Algorithms which run
+ * on (or export) the snapshot then find adjacent vertices close to each
+ * other.
+ *
+ * All strategies consider the graph as undirected, i.e. in and out edges
+ * both contribute to the degree and the adjacency of a vertex
+ */
+class VertexOrdering
+{
+public:
+    enum Strategy {
+        /// Hubs first, vertices of equal degree keep the iteration order
+        DEGREE_DESCENDING,
+        /// Bandwidth reducing order of the reverse Cuthill-McKee algorithm
+        REVERSE_CUTHILL_MCKEE,
+        /// Breadth-first order starting at the hub of each component
+        BREADTH_FIRST
+    };
+
+    /**
+     * Compute the order of the vertices for the given strategy
+     * \param graph Graph whose vertices shall be ordered
+     * \param strategy Ordering strategy
+     * \return all vertices of the graph in the new order
+     */
+    static std::vector<Vertex::Ptr> compute(const BaseGraph::Ptr& graph, Strategy strategy);
+
+    /**
+     * Create a read-only snapshot of the graph whose vertices are numbered in
+     * the order computed for the given strategy
+     * \return pointer to the immutable graph
+     */
+    static BaseGraph::Ptr freeze(const BaseGraph::Ptr& graph, Strategy strategy);
+};
+
+} // end namespace algorithms
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_ALGORITHMS_VERTEX_ORDERING_HPP
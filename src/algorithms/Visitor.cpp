@@ -3,10 +3,76 @@
 namespace graph_analysis  {
 namespace algorithms {
 
-Visitor::Status Visitor::getStatus(const Vertex::Ptr& edge) const
+Visitor::Visitor()
+    : mpGraph(NULL)
+    , mGraphId(0)
+    , mVertexStatus(UNKNOWN)
+    , mEdgeStatus(UNKNOWN)
+{}
+
+void Visitor::setGraph(const BaseGraph::Ptr& graph)
 {
-    std::unordered_map<Vertex::Ptr, Status>::const_iterator cit = mVertexStatus.find(edge);
-    if(cit != mVertexStatus.end())
+    if(mpGraph == graph.get() && mGraphId == graph->getId())
+    {
+        return;
+    }
+
+    mpGraph = graph.get();
+    mGraphId = graph->getId();
+    mVertexStatus = PropertyMap<Status>(UNKNOWN, graph->getVertexIdUpperBound());
+    mEdgeStatus = PropertyMap<Status>(UNKNOWN, graph->getEdgeIdUpperBound());
+
+    // Carry over the status which has been set before binding
+    std::unordered_map<Vertex::Ptr, Status>::const_iterator vit = mUnboundVertexStatus.begin();
+    for(; vit != mUnboundVertexStatus.end(); ++vit)
+    {
+        if(graph->contains(vit->first))
+        {
+            mVertexStatus.set(graph->getVertexId(vit->first), vit->second);
+        }
+    }
+    mUnboundVertexStatus.clear();
+
+    std::unordered_map<Edge::Ptr, Status>::const_iterator eit = mUnboundEdgeStatus.begin();
+    for(; eit != mUnboundEdgeStatus.end(); ++eit)
+    {
+        if(graph->contains(eit->first))
+        {
+            mEdgeStatus.set(graph->getEdgeId(eit->first), eit->second);
+        }
+    }
+    mUnboundEdgeStatus.clear();
+}
+
+void Visitor::setStatus(const Vertex::Ptr& vertex, Status status)
+{
+    if(mpGraph)
+    {
+        mVertexStatus.set(mpGraph->getVertexId(vertex), status);
+    } else {
+        mUnboundVertexStatus[vertex] = status;
+    }
+}
+
+void Visitor::setStatus(const Edge::Ptr& edge, Status status)
+{
+    if(mpGraph)
+    {
+        mEdgeStatus.set(mpGraph->getEdgeId(edge), status);
+    } else {
+        mUnboundEdgeStatus[edge] = status;
+    }
+}
+
+Visitor::Status Visitor::getStatus(const Vertex::Ptr& vertex) const
+{
+    if(mpGraph)
+    {
+        return mVertexStatus.get( mpGraph->getVertexId(vertex) );
+    }
+
+    std::unordered_map<Vertex::Ptr, Status>::const_iterator cit = mUnboundVertexStatus.find(vertex);
+    if(cit != mUnboundVertexStatus.end())
     {
         return cit->second;
     }
@@ -15,8 +81,13 @@ Visitor::Status Visitor::getStatus(const Vertex::Ptr& edge) const
 
 Visitor::Status Visitor::getStatus(const Edge::Ptr& edge) const
 {
-    std::unordered_map<Edge::Ptr, Status>::const_iterator cit = mEdgeStatus.find(edge);
-    if(cit != mEdgeStatus.end())
+    if(mpGraph)
+    {
+        return mEdgeStatus.get( mpGraph->getEdgeId(edge) );
+    }
+
+    std::unordered_map<Edge::Ptr, Status>::const_iterator cit = mUnboundEdgeStatus.find(edge);
+    if(cit != mUnboundEdgeStatus.end())
     {
         return cit->second;
     }
@@ -2,7 +2,7 @@
 #define GRAPH_ANALYSIS_ALGORITHMS_VISITOR_HPP
 
 #include <unordered_map>
-#include "../Edge.hpp"
+#include "../PropertyMap.hpp"
 
 #define GA_ALGO_NI(X) throw std::runtime_error("graph_analysis::algorithms::Visitor: " X " not implemented");
 
@@ -13,6 +13,8 @@ namespace algorithms {
   * This is an implementation of an Vertex/Edge Visitor
   * Closely related implementation to
   * \see http://www.boost.org/doc/libs/1_57_0/libs/graph/doc/EventVisitor.html
+  * For visitors whose callbacks are dispatched at compile time see
+  * StaticVisitor
   */
 class Visitor
 {
@@ -21,76 +23,136 @@ public:
 
     enum Status { UNKNOWN = 0, REGISTERED, VISITED };
 
+    Visitor();
+
     virtual ~Visitor() {}
 
-    void setStatus(const Vertex::Ptr& vertex, Status status) { mVertexStatus[vertex] = status; }
-    void setStatus(const Edge::Ptr& edge, Status status) { mEdgeStatus[edge] = status; }
+    /**
+     * Bind the visitor to the graph which is searched, so that the status of
+     * vertices and edges can be kept in dense id-indexed maps
+     * \details Traversals bind their visitor when they start, so this does
+     * not need to be called explicitly. The visitor only refers to the graph
+     * (without owning it), thus the graph has to outlive the binding. The
+     * status is kept when the visitor is bound to the same graph again, and
+     * reset when it is bound to another graph. A status that has been set
+     * before the first binding is carried over.
+     */
+    void setGraph(const BaseGraph::Ptr& graph);
+
+    /**
+     * Set the status of a vertex or an edge
+     * \details Without a bound graph, the status is kept per element
+     * \throw std::runtime_error if the element is not part of the bound graph
+     */
+    void setStatus(const Vertex::Ptr& vertex, Status status);
+    void setStatus(const Edge::Ptr& edge, Status status);
 
     Status getStatus(const Vertex::Ptr& vertex) const;
     Status getStatus(const Edge::Ptr& edge) const;
 
+    /**
+     * Get the status map of the vertices of the bound graph, so that a
+     * traversal can read and update the status without a call per vertex
+     * \return status map indexed by the vertex ids of the bound graph, or
+     * NULL if the visitor is not bound to a graph
+     */
+    PropertyMap<Status>* getBoundVertexStatus() { return mpGraph ? &mVertexStatus : NULL; }
+
     /**
      * Called when the vertex is initialized
      */
-    virtual void initializeVertex(Vertex::Ptr& vertex) { GA_ALGO_NI("initializeVertex") }
+    virtual void initializeVertex(const Vertex::Ptr& vertex) { GA_ALGO_NI("initializeVertex") }
 
     /**
      * Called when the start vertex is identified
      */
-    virtual void startVertex(Vertex::Ptr& vertex) { GA_ALGO_NI("startVertex") }
+    virtual void startVertex(const Vertex::Ptr& vertex) { GA_ALGO_NI("startVertex") }
 
     /**
      * Called when a vertex is discovered
      */
-    virtual void discoverVertex(Vertex::Ptr& vertex) { GA_ALGO_NI("discoverVertex") }
+    virtual void discoverVertex(const Vertex::Ptr& vertex) { GA_ALGO_NI("discoverVertex") }
 
     /**
      * Called when a vertex has been completely processed
      */
-    virtual void finishVertex(Vertex::Ptr& vertex) { GA_ALGO_NI("finishVertex") }
+    virtual void finishVertex(const Vertex::Ptr& vertex) { GA_ALGO_NI("finishVertex") }
 
     /**
      * Called when a leaf vertex - so no outgoing edges  - is discovered
      */
-    virtual void leafVertex(Vertex::Ptr& vertex) { GA_ALGO_NI("leafVertex") }
+    virtual void leafVertex(const Vertex::Ptr& vertex) { GA_ALGO_NI("leafVertex") }
 
     /**
      * Called when examining an edge - after it has been checked whether to skip
      * the edge or not
      */
-    virtual void examineEdge(Edge::Ptr& edge) { GA_ALGO_NI("examineEdge") }
+    virtual void examineEdge(const Edge::Ptr& edge) { GA_ALGO_NI("examineEdge") }
 
     /**
      * Called when an edge leads to a previously unknown vertex
      */
-    virtual void treeEdge(Edge::Ptr& edge) { GA_ALGO_NI("treeEdge") }
+    virtual void treeEdge(const Edge::Ptr& edge) { GA_ALGO_NI("treeEdge") }
 
     /**
      * Called when a cycle edge has been detected
      */
-    virtual void cycleEdge(Edge::Ptr& edge) { GA_ALGO_NI("cycleEdge") }
+    virtual void cycleEdge(const Edge::Ptr& edge) { GA_ALGO_NI("cycleEdge") }
 
     /**
      * Called when an edge has been encountered that leads to an already
      * visited node
      */
-    virtual void forwardOrCrossEdge(Edge::Ptr& edge) { GA_ALGO_NI("forwardOrCrossEdge") }
+    virtual void forwardOrCrossEdge(const Edge::Ptr& edge) { GA_ALGO_NI("forwardOrCrossEdge") }
 
     /**
      * Called when an edge in the opposite direction has already been
      * encountered
      */
-    virtual void backEdge(Edge::Ptr& edge) { GA_ALGO_NI("backEdge") }
+    virtual void backEdge(const Edge::Ptr& edge) { GA_ALGO_NI("backEdge") }
 
-    virtual void edgeRelaxed(Edge::Ptr& edge) { GA_ALGO_NI("edgeRelaxed") }
-    virtual void edgeNotRelaxed(Edge::Ptr& edge) { GA_ALGO_NI("edgeNotRelaxed") }
-    virtual void edgeMinimized(Edge::Ptr& edge) { GA_ALGO_NI("edgeMinimized") }
-    virtual void edgeNotMinimized(Edge::Ptr& edge) { GA_ALGO_NI("edgeNotMinimized") }
+    virtual void edgeRelaxed(const Edge::Ptr& edge) { GA_ALGO_NI("edgeRelaxed") }
+    virtual void edgeNotRelaxed(const Edge::Ptr& edge) { GA_ALGO_NI("edgeNotRelaxed") }
+    virtual void edgeMinimized(const Edge::Ptr& edge) { GA_ALGO_NI("edgeMinimized") }
+    virtual void edgeNotMinimized(const Edge::Ptr& edge) { GA_ALGO_NI("edgeNotMinimized") }
 
+    /**
+     * \name Former callback signatures
+     * The callbacks used to take non-const references. These overloads
+     * forward to the const reference callbacks and are final, so that a
+     * visitor which still overrides a former signature fails to compile
+     * instead of silently not being called anymore
+     */
+    ///@{
+    virtual void initializeVertex(Vertex::Ptr& vertex) final { initializeVertex(static_cast<const Vertex::Ptr&>(vertex)); }
+    virtual void startVertex(Vertex::Ptr& vertex) final { startVertex(static_cast<const Vertex::Ptr&>(vertex)); }
+    virtual void discoverVertex(Vertex::Ptr& vertex) final { discoverVertex(static_cast<const Vertex::Ptr&>(vertex)); }
+    virtual void finishVertex(Vertex::Ptr& vertex) final { finishVertex(static_cast<const Vertex::Ptr&>(vertex)); }
+    virtual void leafVertex(Vertex::Ptr& vertex) final { leafVertex(static_cast<const Vertex::Ptr&>(vertex)); }
+    virtual void examineEdge(Edge::Ptr& edge) final { examineEdge(static_cast<const Edge::Ptr&>(edge)); }
+    virtual void treeEdge(Edge::Ptr& edge) final { treeEdge(static_cast<const Edge::Ptr&>(edge)); }
+    virtual void cycleEdge(Edge::Ptr& edge) final { cycleEdge(static_cast<const Edge::Ptr&>(edge)); }
+    virtual void forwardOrCrossEdge(Edge::Ptr& edge) final { forwardOrCrossEdge(static_cast<const Edge::Ptr&>(edge)); }
+    virtual void backEdge(Edge::Ptr& edge) final { backEdge(static_cast<const Edge::Ptr&>(edge)); }
+    virtual void edgeRelaxed(Edge::Ptr& edge) final { edgeRelaxed(static_cast<const Edge::Ptr&>(edge)); }
+    virtual void edgeNotRelaxed(Edge::Ptr& edge) final { edgeNotRelaxed(static_cast<const Edge::Ptr&>(edge)); }
+    virtual void edgeMinimized(Edge::Ptr& edge) final { edgeMinimized(static_cast<const Edge::Ptr&>(edge)); }
+    virtual void edgeNotMinimized(Edge::Ptr& edge) final { edgeNotMinimized(static_cast<const Edge::Ptr&>(edge)); }
+    ///@}
 
 private:
-    std::unordered_map<Vertex::Ptr, Status> mVertexStatus;
-    std::unordered_map<Edge::Ptr, Status> mEdgeStatus;
+    /// Graph the visitor is bound to, not owned since a graph might hold
+    /// its visitors
+    const BaseGraph* mpGraph;
+    /// Id of the bound graph, which identifies the graph even if another
+    /// one has been allocated at the same address
+    GraphId mGraphId;
+    PropertyMap<Status> mVertexStatus;
+    PropertyMap<Status> mEdgeStatus;
+
+    /// Status of elements as long as the visitor is not bound to a graph
+    std::unordered_map<Vertex::Ptr, Status> mUnboundVertexStatus;
+    std::unordered_map<Edge::Ptr, Status> mUnboundEdgeStatus;
 };
 
 } // end namespace algorithms
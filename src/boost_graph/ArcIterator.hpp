@@ -39,6 +39,25 @@ public:
         return false;
     }
 
+    size_t nextBatch(Edge::Ptr* out, size_t max)
+    {
+        size_t count = 0;
+        for(; count < max && mCurrent != mEnd; ++mCurrent)
+        {
+            const Edge::Ptr& edge = mGraph.raw()[*mCurrent];
+            if(skip(edge))
+            {
+                continue;
+            }
+            out[count++] = edge;
+        }
+        if(count > 0)
+        {
+            setNext(out[count - 1]);
+        }
+        return count;
+    }
+
 private:
     EdgeIteratorImpl mCurrent;
     EdgeIteratorImpl mStart;
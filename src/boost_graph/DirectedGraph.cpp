@@ -8,15 +8,20 @@
 #include "../filters/CommonFilters.hpp"
 
 #include <boost/graph/incremental_components.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/graph/strong_components.hpp>
+#include <boost/graph/topological_sort.hpp>
 #include <boost/pending/disjoint_sets.hpp>
 #include <boost/foreach.hpp>
+#include <boost/unordered_set.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
 
 namespace graph_analysis {
 namespace boost_graph {
 
-std::map<GraphId, GraphElementId> DirectedGraph::msNewVertexId;
-std::map<GraphId, GraphElementId> DirectedGraph::msNewEdgeId;
-
 BaseGraph::Ptr DirectedGraph::copy() const
 {
     return BaseGraph::Ptr(new DirectedGraph(*this));
@@ -28,14 +33,33 @@ BaseGraph::Ptr DirectedGraph::newInstance() const
 }
 
 DirectedGraph::DirectedGraph()
-    : TypedGraph(BOOST_DIRECTED_GRAPH, true)
+    : CopyOnWriteGraph(BOOST_DIRECTED_GRAPH, true)
 {
 }
 
 DirectedGraph::DirectedGraph(const DirectedGraph& other)
-    : TypedGraph(BOOST_DIRECTED_GRAPH, true)
+    : CopyOnWriteGraph(BOOST_DIRECTED_GRAPH, true)
+    , mEdgeMap(other.mEdgeMap)
+    , mVertexMap(other.mVertexMap)
+    , mVertexIds(other.mVertexIds)
+    , mEdgeIds(other.mEdgeIds)
+    , mEdgeIndexIds(other.mEdgeIndexIds)
 {
-    *this = other;
+    shareRaw(other);
+
+    const graph_t& graph = other.raw();
+    VertexMap::const_iterator vit = mVertexMap.begin();
+    for(; vit != mVertexMap.end(); ++vit)
+    {
+        graph[vit->second]->associate(getId(), vit->first);
+    }
+
+    EdgeMap::const_iterator eit = mEdgeMap.begin();
+    for(; eit != mEdgeMap.end(); ++eit)
+    {
+        graph[eit->second]->associate(getId(), eit->first);
+    }
+    setEdgeIndexEnabled(other.isEdgeIndexEnabled());
 }
 
 DirectedGraph::~DirectedGraph()
@@ -55,14 +79,15 @@ DirectedGraph::Ptr DirectedGraph::validateType(const BaseGraph::Ptr& baseGraph)
 
 GraphElementId DirectedGraph::addVertexInternal(const Vertex::Ptr& vertex)
 {
+    graph_t& graph = raw();
     // Add a new vertex to the Graph
-    VertexDescriptor vertexDescriptor = boost::add_vertex(mGraph);
-    mGraph[vertexDescriptor] = vertex;
+    VertexDescriptor vertexDescriptor = boost::add_vertex(graph);
+    graph[vertexDescriptor] = vertex;
 
-    GraphElementId newVertexId = msNewVertexId[getId()]++;
+    GraphElementId newVertexId = mVertexIds.allocate();
 
-    // Set the internal index property (This probably shouldn't be done.)
-    //::boost::put( index, vertexDescriptor, newVertexId);
+    // The vertex_index is given by the vertex descriptor of the vector-based
+    // vertex list, and thus remains dense when vertices are removed
 
     // Insert to ID-Vertex map and memorize last added vertex
     mVertexMap.insert(VertexMap::value_type(newVertexId, vertexDescriptor));
@@ -73,11 +98,114 @@ GraphElementId DirectedGraph::addVertexInternal(const Vertex::Ptr& vertex)
 
 void DirectedGraph::removeVertexInternal(const Vertex::Ptr& vertex)
 {
-    int vertexId = getVertexId(vertex);
-    VertexDescriptor vertexDescriptor = mVertexMap[vertexId];
-    mVertexMap.erase(vertexId);
-    boost::clear_vertex(vertexDescriptor, mGraph);
-    boost::remove_vertex(vertexDescriptor, mGraph);
+    removeVerticesInternal(std::vector<Vertex::Ptr>(1, vertex));
+}
+
+void DirectedGraph::removeVerticesInternal(const std::vector<Vertex::Ptr>& vertices)
+{
+    typedef boost::graph_traits<graph_t>::out_edge_iterator OutEdgeIteratorImpl;
+    typedef boost::graph_traits<graph_t>::in_edge_iterator InEdgeIteratorImpl;
+
+    graph_t& graph = raw();
+    std::vector<VertexDescriptor> vertexDescriptors;
+    vertexDescriptors.reserve(vertices.size());
+    std::vector<Edge::Ptr> incidentEdges;
+    boost::unordered_set<Edge*> knownEdges;
+
+    std::vector<Vertex::Ptr>::const_iterator cit = vertices.begin();
+    for(; cit != vertices.end(); ++cit)
+    {
+        VertexMap::iterator it = mVertexMap.find( getVertexId(*cit) );
+        VertexDescriptor vertexDescriptor = it->second;
+        vertexDescriptors.push_back(vertexDescriptor);
+        mVertexIds.release(it->first);
+        mVertexMap.erase(it);
+
+        // Incident edges are dropped along with the vertex
+        OutEdgeIteratorImpl oit, oitEnd;
+        for(boost::tie(oit, oitEnd) = boost::out_edges(vertexDescriptor, graph); oit != oitEnd; ++oit)
+        {
+            if(knownEdges.insert( graph[*oit].get() ).second)
+            {
+                incidentEdges.push_back( graph[*oit] );
+            }
+        }
+        InEdgeIteratorImpl iit, iitEnd;
+        for(boost::tie(iit, iitEnd) = boost::in_edges(vertexDescriptor, graph); iit != iitEnd; ++iit)
+        {
+            if(knownEdges.insert( graph[*iit].get() ).second)
+            {
+                incidentEdges.push_back( graph[*iit] );
+            }
+        }
+    }
+
+    if(!incidentEdges.empty())
+    {
+        removeEdgesInternal(incidentEdges);
+    }
+
+    // Remove from the back of the vector-based vertex list, so that the
+    // descriptors of the vertices which still have to be removed remain valid
+    std::sort(vertexDescriptors.begin(), vertexDescriptors.end(), std::greater<VertexDescriptor>());
+    std::vector<VertexDescriptor>::const_iterator vit = vertexDescriptors.begin();
+    for(; vit != vertexDescriptors.end(); ++vit)
+    {
+        boost::remove_vertex(*vit, graph);
+    }
+
+    if(!vertexDescriptors.empty())
+    {
+        updateDescriptors(vertexDescriptors.back());
+    }
+}
+
+void DirectedGraph::rawDetached()
+{
+    updateDescriptors(0);
+}
+
+void DirectedGraph::updateDescriptors(VertexDescriptor firstVertex)
+{
+    typedef boost::graph_traits<graph_t>::out_edge_iterator OutEdgeIteratorImpl;
+    typedef boost::graph_traits<graph_t>::in_edge_iterator InEdgeIteratorImpl;
+
+    graph_t& graph = raw();
+    VertexDescriptor numberOfVertices = boost::num_vertices(graph);
+    for(VertexDescriptor vertexDescriptor = firstVertex; vertexDescriptor < numberOfVertices; ++vertexDescriptor)
+    {
+        mVertexMap[getVertexId(graph[vertexDescriptor])] = vertexDescriptor;
+
+        OutEdgeIteratorImpl oit, oitEnd;
+        for(boost::tie(oit, oitEnd) = boost::out_edges(vertexDescriptor, graph); oit != oitEnd; ++oit)
+        {
+            mEdgeMap[getEdgeId(graph[*oit])] = *oit;
+        }
+
+        // In edges from a source above firstVertex are covered as out edges
+        InEdgeIteratorImpl iit, iitEnd;
+        for(boost::tie(iit, iitEnd) = boost::in_edges(vertexDescriptor, graph); iit != iitEnd; ++iit)
+        {
+            if(boost::source(*iit, graph) < firstVertex)
+            {
+                mEdgeMap[getEdgeId(graph[*iit])] = *iit;
+            }
+        }
+    }
+}
+
+void DirectedGraph::updateEdgeIndex()
+{
+    graph_t& graph = raw();
+    mEdgeIndexIds.clear();
+    mEdgeIndexIds.reserve(boost::num_edges(graph));
+
+    EdgeIteratorImpl eit, eitEnd;
+    for(boost::tie(eit, eitEnd) = boost::edges(graph); eit != eitEnd; ++eit)
+    {
+        boost::put(boost::edge_index, graph, *eit, mEdgeIndexIds.size());
+        mEdgeIndexIds.push_back(getEdgeId(graph[*eit]));
+    }
 }
 
 Vertex::Ptr DirectedGraph::getVertex(GraphElementId id) const
@@ -86,7 +214,7 @@ Vertex::Ptr DirectedGraph::getVertex(GraphElementId id) const
     if(cit != mVertexMap.end())
     {
         VertexDescriptor vertexDescriptor = cit->second;
-        return mGraph[ vertexDescriptor ];
+        return raw()[ vertexDescriptor ];
     }
 
     std::stringstream ss;
@@ -120,11 +248,13 @@ EdgeDescriptor DirectedGraph::getEdgeDescriptor(const Edge::Ptr& edge) const
 
 GraphElementId DirectedGraph::addEdgeInternal(const Edge::Ptr& edge, GraphElementId sourceVertexId, GraphElementId targetVertexId)
 {
-    GraphElementId newEdgeId = msNewEdgeId[getId()]++;
-    std::pair<EdgeDescriptor, bool> result = boost::add_edge(mVertexMap[sourceVertexId], mVertexMap[targetVertexId], mGraph);
+    graph_t& graph = raw();
+    GraphElementId newEdgeId = mEdgeIds.allocate();
+    std::pair<EdgeDescriptor, bool> result = boost::add_edge(mVertexMap[sourceVertexId], mVertexMap[targetVertexId], graph);
     EdgeDescriptor edgeDescriptor = result.first;
-    mGraph[edgeDescriptor] = edge;
-    //::boost::put(::boost::edge_index_t(), mGraph, edgeDescriptor, newEdgeId);
+    graph[edgeDescriptor] = edge;
+    boost::put(boost::edge_index, graph, edgeDescriptor, mEdgeIndexIds.size());
+    mEdgeIndexIds.push_back(newEdgeId);
     edge->associate(getId(), newEdgeId);
     mEdgeMap.insert(EdgeMap::value_type(newEdgeId, edgeDescriptor));
     return newEdgeId;
@@ -132,12 +262,128 @@ GraphElementId DirectedGraph::addEdgeInternal(const Edge::Ptr& edge, GraphElemen
 
 void DirectedGraph::removeEdgeInternal(const Edge::Ptr& edge)
 {
+    graph_t& graph = raw();
     int edgeId = getEdgeId(edge);
     EdgeDescriptor edgeDescriptor = mEdgeMap[edgeId];
     mEdgeMap.erase(edgeId);
-    boost::remove_edge(edgeDescriptor, mGraph);
+    mEdgeIds.release(edgeId);
+
+    // Keep the edge_index dense by moving the last edge into the gap
+    size_t edgeIndex = boost::get(boost::edge_index, graph, edgeDescriptor);
+    GraphElementId lastEdgeId = mEdgeIndexIds.back();
+    if(lastEdgeId != static_cast<GraphElementId>(edgeId))
+    {
+        boost::put(boost::edge_index, graph, mEdgeMap[lastEdgeId], edgeIndex);
+        mEdgeIndexIds[edgeIndex] = lastEdgeId;
+    }
+    mEdgeIndexIds.pop_back();
+
+    boost::remove_edge(edgeDescriptor, graph);
 }
 
+void DirectedGraph::reserveInternal(size_t numberOfVertices, size_t numberOfEdges)
+{
+    mVertexMap.reserve(mVertexMap.size() + numberOfVertices);
+    mEdgeMap.reserve(mEdgeMap.size() + numberOfEdges);
+}
+
+std::vector<GraphElementId> DirectedGraph::addVerticesInternal(const std::vector<Vertex::Ptr>& vertices)
+{
+    graph_t& graph = raw();
+    std::vector<GraphElementId> vertexIds;
+    vertexIds.reserve(vertices.size());
+
+    std::vector<Vertex::Ptr>::const_iterator cit = vertices.begin();
+    for(; cit != vertices.end(); ++cit)
+    {
+        VertexDescriptor vertexDescriptor = boost::add_vertex(graph);
+        graph[vertexDescriptor] = *cit;
+
+        GraphElementId newVertexId = mVertexIds.allocate();
+        mVertexMap.insert(VertexMap::value_type(newVertexId, vertexDescriptor));
+        (*cit)->associate(getId(), newVertexId);
+        vertexIds.push_back(newVertexId);
+    }
+    return vertexIds;
+}
+
+std::vector<GraphElementId> DirectedGraph::addEdgesInternal(const std::vector<Edge::Ptr>& edges, const std::vector<GraphElementId>& sourceVertexIds, const std::vector<GraphElementId>& targetVertexIds)
+{
+    graph_t& graph = raw();
+    std::vector<GraphElementId> edgeIds;
+    edgeIds.reserve(edges.size());
+
+    for(size_t i = 0; i < edges.size(); ++i)
+    {
+        std::pair<EdgeDescriptor, bool> result = boost::add_edge(mVertexMap[sourceVertexIds[i]], mVertexMap[targetVertexIds[i]], graph);
+        EdgeDescriptor edgeDescriptor = result.first;
+        graph[edgeDescriptor] = edges[i];
+
+        GraphElementId newEdgeId = mEdgeIds.allocate();
+        boost::put(boost::edge_index, graph, edgeDescriptor, mEdgeIndexIds.size());
+        mEdgeIndexIds.push_back(newEdgeId);
+        edges[i]->associate(getId(), newEdgeId);
+        mEdgeMap.insert(EdgeMap::value_type(newEdgeId, edgeDescriptor));
+        edgeIds.push_back(newEdgeId);
+    }
+    return edgeIds;
+}
+
+/**
+ * Order (id, descriptor) pairs by id
+ */
+template<typename Descriptor>
+struct LessById
+{
+    bool operator()(const std::pair<GraphElementId, Descriptor>& a, const std::pair<GraphElementId, Descriptor>& b) const
+    {
+        return a.first < b.first;
+    }
+};
+
+/**
+ * Predicate to identify the edges of a batch removal
+ */
+struct RemovedEdgePredicate
+{
+    RemovedEdgePredicate(const BidirectionalGraph& graph, const boost::unordered_set<Edge*>& edges)
+        : graph(graph)
+        , edges(edges)
+    {}
+
+    bool operator()(const EdgeDescriptor& edgeDescriptor) const
+    {
+        return edges.count( graph[edgeDescriptor].get() );
+    }
+
+    const BidirectionalGraph& graph;
+    const boost::unordered_set<Edge*>& edges;
+};
+
+void DirectedGraph::removeEdgesInternal(const std::vector<Edge::Ptr>& edges)
+{
+    graph_t& graph = raw();
+    boost::unordered_set<Edge*> removedEdges(edges.size());
+    boost::unordered_set<VertexDescriptor> sourceVertices;
+
+    std::vector<Edge::Ptr>::const_iterator cit = edges.begin();
+    for(; cit != edges.end(); ++cit)
+    {
+        EdgeMap::iterator it = mEdgeMap.find( getEdgeId(*cit) );
+        sourceVertices.insert( boost::source(it->second, graph) );
+        removedEdges.insert( cit->get() );
+        mEdgeIds.release(it->first);
+        mEdgeMap.erase(it);
+    }
+
+    RemovedEdgePredicate predicate(graph, removedEdges);
+    boost::unordered_set<VertexDescriptor>::const_iterator vit = sourceVertices.begin();
+    for(; vit != sourceVertices.end(); ++vit)
+    {
+        boost::remove_out_edge_if(*vit, predicate, graph);
+    }
+    updateEdgeIndex();
+}
 
 Edge::Ptr DirectedGraph::getEdge(GraphElementId id) const
 {
@@ -145,7 +391,7 @@ Edge::Ptr DirectedGraph::getEdge(GraphElementId id) const
     if(cit != mEdgeMap.end())
     {
         EdgeDescriptor descriptor = cit->second;
-        return mGraph[descriptor];
+        return raw()[descriptor];
     }
 
     std::stringstream ss;
@@ -153,6 +399,75 @@ Edge::Ptr DirectedGraph::getEdge(GraphElementId id) const
     throw std::invalid_argument("graph_analysis::boost::DirectedGraph::getEdge with id '" + ss.str() +"' does not exist");
 }
 
+GraphElementId DirectedGraph::getVertexIdUpperBound() const
+{
+    return mVertexIds.getUpperBound();
+}
+
+GraphElementId DirectedGraph::getEdgeIdUpperBound() const
+{
+    return mEdgeIds.getUpperBound();
+}
+
+size_t DirectedGraph::getStorageSize() const
+{
+    // Each map entry is a node linked into a bucket list
+    return mVertexMap.bucket_count()*sizeof(void*) + mVertexMap.size()*(sizeof(VertexMap::value_type) + sizeof(void*))
+        + mEdgeMap.bucket_count()*sizeof(void*) + mEdgeMap.size()*(sizeof(EdgeMap::value_type) + sizeof(void*))
+        + mEdgeIndexIds.capacity()*sizeof(GraphElementId);
+}
+
+IdRemapping DirectedGraph::compactInternal()
+{
+    graph_t& graph = raw();
+    IdRemapping remapping(mVertexIds.getUpperBound(), mEdgeIds.getUpperBound());
+
+    // Assign new ids in the order of the old ids
+    std::vector< std::pair<GraphElementId, VertexDescriptor> > vertices;
+    vertices.reserve(mVertexMap.size());
+    VertexIteratorImpl vit, vitEnd;
+    for(boost::tie(vit, vitEnd) = boost::vertices(graph); vit != vitEnd; ++vit)
+    {
+        vertices.push_back( std::make_pair(getVertexId(graph[*vit]), *vit) );
+    }
+    std::sort(vertices.begin(), vertices.end(), LessById<VertexDescriptor>());
+
+    VertexMap vertexMap(vertices.size());
+    for(size_t i = 0; i < vertices.size(); ++i)
+    {
+        const VertexDescriptor& vertexDescriptor = vertices[i].second;
+        vertexMap.insert(VertexMap::value_type(i, vertexDescriptor));
+        graph[vertexDescriptor]->associate(getId(), i);
+        remapping.setVertexId(vertices[i].first, i);
+    }
+    mVertexMap.swap(vertexMap);
+    mVertexIds.reset(vertices.size());
+
+    std::vector< std::pair<GraphElementId, EdgeDescriptor> > edges;
+    edges.reserve(mEdgeMap.size());
+    EdgeIteratorImpl eit, eitEnd;
+    for(boost::tie(eit, eitEnd) = boost::edges(graph); eit != eitEnd; ++eit)
+    {
+        edges.push_back( std::make_pair(getEdgeId(graph[*eit]), *eit) );
+    }
+    std::sort(edges.begin(), edges.end(), LessById<EdgeDescriptor>());
+
+    EdgeMap edgeMap(edges.size());
+    for(size_t i = 0; i < edges.size(); ++i)
+    {
+        const EdgeDescriptor& edgeDescriptor = edges[i].second;
+        edgeMap.insert(EdgeMap::value_type(i, edgeDescriptor));
+        graph[edgeDescriptor]->associate(getId(), i);
+        remapping.setEdgeId(edges[i].first, i);
+    }
+    mEdgeMap.swap(edgeMap);
+    mEdgeIds.reset(edges.size());
+    updateEdgeIndex();
+    mEdgeIndexIds.shrink_to_fit();
+
+    return remapping;
+}
+
 VertexIterator::Ptr DirectedGraph::getVertexIterator() const
 {
     NodeIterator<DirectedGraph>* it = new NodeIterator<DirectedGraph>(*this);
@@ -183,18 +498,90 @@ SubGraph::Ptr DirectedGraph::identifyConnectedComponents(const BaseGraph::Ptr& b
 
 
     boost::disjoint_sets< VertexIndex*, VertexDescriptor* > ds(&rank[0], &parent[0]);
-    boost::initialize_incremental_components(mGraph, ds);
-    boost::incremental_components(mGraph, ds);
+    boost::initialize_incremental_components(raw(), ds);
+    boost::incremental_components(raw(), ds);
 
     std::vector<VertexDescriptor>::const_iterator cit = parent.begin();
     for(; cit != parent.end(); ++cit)
     {
-        Vertex::Ptr v = mGraph[*cit];
+        Vertex::Ptr v = raw()[*cit];
         subgraph->enable(v);
     }
     return subgraph;
 }
 
+std::vector<double> DirectedGraph::computeShortestPathDistances(const Vertex::Ptr& source, const EdgeWeightFunction& edgeWeightFunction) const
+{
+    const graph_t& graph = raw();
+
+    std::vector<double> weights(boost::num_edges(graph));
+    EdgeIteratorImpl eit, eitEnd;
+    for(boost::tie(eit, eitEnd) = boost::edges(graph); eit != eitEnd; ++eit)
+    {
+        double weight = edgeWeightFunction(graph[*eit]);
+        if(weight < 0)
+        {
+            throw std::invalid_argument("graph_analysis::boost_graph::DirectedGraph::computeShortestPathDistances: edge '" + graph[*eit]->toString() + "' has a negative weight");
+        }
+        weights[ boost::get(boost::edge_index, graph, *eit) ] = weight;
+    }
+
+    std::vector<double> distances(boost::num_vertices(graph));
+    boost::dijkstra_shortest_paths(graph, getVertexDescriptor(source),
+            boost::weight_map( boost::make_iterator_property_map(weights.begin(), boost::get(boost::edge_index, graph)) )
+            .distance_map( boost::make_iterator_property_map(distances.begin(), boost::get(boost::vertex_index, graph)) )
+            .distance_inf( std::numeric_limits<double>::infinity() ));
+
+    std::vector<double> vertexDistances(getVertexIdUpperBound(), std::numeric_limits<double>::infinity());
+    VertexIteratorImpl vit, vitEnd;
+    for(boost::tie(vit, vitEnd) = boost::vertices(graph); vit != vitEnd; ++vit)
+    {
+        vertexDistances[ getVertexId(graph[*vit]) ] = distances[*vit];
+    }
+    return vertexDistances;
+}
+
+std::vector< std::vector<Vertex::Ptr> > DirectedGraph::identifyStronglyConnectedComponents() const
+{
+    const graph_t& graph = raw();
+
+    std::vector<size_t> component(boost::num_vertices(graph));
+    size_t numberOfComponents = boost::strong_components(graph,
+            boost::make_iterator_property_map(component.begin(), boost::get(boost::vertex_index, graph)));
+
+    std::vector< std::vector<Vertex::Ptr> > components(numberOfComponents);
+    VertexIteratorImpl vit, vitEnd;
+    for(boost::tie(vit, vitEnd) = boost::vertices(graph); vit != vitEnd; ++vit)
+    {
+        components[ component[*vit] ].push_back( graph[*vit] );
+    }
+    return components;
+}
+
+std::vector<Vertex::Ptr> DirectedGraph::topologicalSort() const
+{
+    const graph_t& graph = raw();
+
+    std::vector<VertexDescriptor> order;
+    order.reserve(boost::num_vertices(graph));
+    try {
+        boost::topological_sort(graph, std::back_inserter(order));
+    } catch(const boost::not_a_dag& e)
+    {
+        throw std::runtime_error("graph_analysis::boost_graph::DirectedGraph::topologicalSort: graph contains a cycle");
+    }
+
+    // topological_sort reports the vertices in reverse order
+    std::vector<Vertex::Ptr> vertices;
+    vertices.reserve(order.size());
+    std::vector<VertexDescriptor>::const_reverse_iterator rit = order.rbegin();
+    for(; rit != order.rend(); ++rit)
+    {
+        vertices.push_back( graph[*rit] );
+    }
+    return vertices;
+}
+
 SubGraph::Ptr DirectedGraph::createSubGraph(const BaseGraph::Ptr& baseGraph) const
 {
     DirectedGraph::Ptr directedGraph = validateType(baseGraph);
@@ -236,7 +623,7 @@ std::vector<Edge::Ptr> DirectedGraph::getEdges(VertexDescriptor source, VertexDe
     return edges;
 }
 
-std::vector<Edge::Ptr> DirectedGraph::getEdges(const Vertex::Ptr& source, const Vertex::Ptr& target) const
+std::vector<Edge::Ptr> DirectedGraph::getEdgesInternal(const Vertex::Ptr& source, const Vertex::Ptr& target) const
 {
     VertexDescriptor sourceVertexDescriptor = getVertexDescriptor(source);
     VertexDescriptor targetVertexDescriptor = getVertexDescriptor(target);
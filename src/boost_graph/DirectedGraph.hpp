@@ -3,6 +3,8 @@
 
 #include "../Graph.hpp"
 #include "../BaseGraph.hpp"
+#include "../IdPool.hpp"
+#include "../CopyOnWriteGraph.hpp"
 #include "../boost_graph/ArcIterator.hpp"
 #include <boost/graph/adjacency_list.hpp>
 #include <base-logging/Logging.hpp>
@@ -40,7 +42,7 @@ typedef std::pair<EdgeIterator, EdgeIterator> EdgeRange;
 typedef boost::graph_traits<BidirectionalGraph>::adjacency_iterator AdjacencyIterator;
 typedef std::pair<AdjacencyIterator, AdjacencyIterator> AdjacencyRange;
 
-class DirectedGraph : public TypedGraph< BidirectionalGraph, graph_analysis::BaseGraph>
+class DirectedGraph : public CopyOnWriteGraph< BidirectionalGraph, graph_analysis::BaseGraph>
 {
     friend class OutArcIterator<DirectedGraph>;
     friend class InArcIterator<DirectedGraph>;
@@ -70,10 +72,26 @@ public:
      */
     EdgeDescriptor getEdgeDescriptor(const Edge::Ptr& edge) const;
 
+    /**
+     * Create a copy of the graph, which shares the underlying boost graph
+     * with the other graph until either of them is modified, see
+     * CopyOnWriteGraph for the costs
+     * Vertices and edges keep their ids in the copy
+     */
     DirectedGraph(const DirectedGraph& other);
 
     void write(std::ostream& ostream = std::cout) const;
 
+    GraphElementId getVertexIdUpperBound() const;
+    GraphElementId getEdgeIdUpperBound() const;
+
+    /**
+     * Estimate the storage of the vertex and edge map
+     * \details The vector-based vertex list and the edge lists do not leave
+     * holes on removal, but the buckets of the id maps do not shrink
+     */
+    size_t getStorageSize() const;
+
     /**
      * Get the vertex iterator for this implementation
      */
@@ -101,6 +119,22 @@ public:
      */
     SubGraph::Ptr identifyConnectedComponents(const BaseGraph::Ptr& baseGraph) const;
 
+    /**
+     * Compute the shortest path distances using boost::dijkstra_shortest_paths
+     */
+    std::vector<double> computeShortestPathDistances(const Vertex::Ptr& source, const EdgeWeightFunction& edgeWeightFunction) const;
+
+    /**
+     * Identify the strongly connected components using
+     * boost::strong_components
+     */
+    std::vector< std::vector<Vertex::Ptr> > identifyStronglyConnectedComponents() const;
+
+    /**
+     * Order the vertices topologically using boost::topological_sort
+     */
+    std::vector<Vertex::Ptr> topologicalSort() const;
+
     /**
      * Get the subgraph -- by default all vertices and edges of the
      * base graph are available (enabled)
@@ -114,10 +148,16 @@ public:
      */
     std::vector<Edge::Ptr> getEdges(VertexDescriptor source, VertexDescriptor target) const;
 
-    std::vector<Edge::Ptr> getEdges(const Vertex::Ptr& source, const Vertex::Ptr& target) const;
+    using BaseGraph::getEdges;
 
 protected:
 
+    /**
+     * Get edges between two given vertices by scanning the in-edges of the
+     * target
+     */
+    std::vector<Edge::Ptr> getEdgesInternal(const Vertex::Ptr& source, const Vertex::Ptr& target) const;
+
     DirectedGraph::Ptr validateType(const BaseGraph::Ptr& baseGraph) const;
 
     /**
@@ -143,11 +183,69 @@ protected:
      */
     virtual void removeEdgeInternal(const Edge::Ptr&);
 
+    /**
+     * Reserve the id maps for the given number of additional vertices and edges
+     */
+    virtual void reserveInternal(size_t numberOfVertices, size_t numberOfEdges);
+
+    /**
+     * \brief Add a list of vertices using a single range of ids
+     * \return the ids of the created vertices
+     */
+    virtual std::vector<GraphElementId> addVerticesInternal(const std::vector<Vertex::Ptr>& vertices);
+
+    /**
+     * \brief Add a list of edges using a single range of ids
+     * \return the ids of the created edges
+     */
+    virtual std::vector<GraphElementId> addEdgesInternal(const std::vector<Edge::Ptr>& edges, const std::vector<GraphElementId>& sourceVertexIds, const std::vector<GraphElementId>& targetVertexIds);
+
+    /**
+     * Remove a list of edges, so that the out edge list of each affected
+     * source vertex is cleaned up only once
+     */
+    virtual void removeEdgesInternal(const std::vector<Edge::Ptr>& edges);
+
+    /**
+     * Remove a list of vertices along with their incident edges, so that the
+     * descriptors are refreshed only once and only for the vertices behind the
+     * first removed one
+     */
+    virtual void removeVerticesInternal(const std::vector<Vertex::Ptr>& vertices);
+
+    /**
+     * Renumber vertices and edges to dense ids
+     */
+    virtual IdRemapping compactInternal();
+
+    /**
+     * Refresh the descriptors stored in the vertex and edge map, starting
+     * from the given position of the vertex list
+     * \details Removing a vertex renumbers all subsequent vertex descriptors
+     * of the underlying vector-based vertex list, which also invalidates the
+     * source and target stored in the edge descriptors of their incident edges
+     */
+    void updateDescriptors(VertexDescriptor firstVertex);
+
+    /**
+     * Renumber the edge_index property of all edges, so that it is dense
+     * again
+     */
+    void updateEdgeIndex();
+
+    /**
+     * Edge descriptors refer to the storage of the boost graph, thus refresh
+     * them after detaching from a shared graph
+     */
+    void rawDetached();
+
     // Property maps to store data associated with vertices and edges
     EdgeMap mEdgeMap;
     VertexMap mVertexMap;
-    static std::map<GraphId, GraphElementId> msNewVertexId;
-    static std::map<GraphId, GraphElementId> msNewEdgeId;
+    IdPool mVertexIds;
+    IdPool mEdgeIds;
+    /// Edge ids by edge_index
+    std::vector<GraphElementId> mEdgeIndexIds;
 };
 
 } // end namespace boost_graph
@@ -33,6 +33,25 @@ public:
         }
         return false;
     }
+
+    size_t nextBatch(Vertex::Ptr* out, size_t max)
+    {
+        size_t count = 0;
+        for(; count < max && mCurrent != mEnd; ++mCurrent)
+        {
+            const Vertex::Ptr& vertex = mGraph.raw()[*mCurrent];
+            if(skip(vertex))
+            {
+                continue;
+            }
+            out[count++] = vertex;
+        }
+        if(count > 0)
+        {
+            setNext(out[count - 1]);
+        }
+        return count;
+    }
 private:
     const T& mGraph;
 
@@ -0,0 +1,528 @@
+#include "DirectedGraph.hpp"
+#include "../PropertyMap.hpp"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <base-logging/Logging.hpp>
+
+namespace graph_analysis {
+namespace compressed {
+
+namespace {
+
+/**
+ * Encoded adjacency which is owned by the graph
+ */
+struct EncodedAdjacency
+{
+    std::vector<uint64_t> outOffsets;
+    std::vector<GraphElementId> edgeOffsets;
+    std::vector<uint8_t> outData;
+    std::vector<uint64_t> inOffsets;
+    std::vector<uint8_t> inData;
+};
+
+struct EdgeOrder
+{
+    const std::vector<DirectedGraph::EdgeIds>& edges;
+    EdgeOrder(const std::vector<DirectedGraph::EdgeIds>& e) : edges(e) {}
+    bool operator()(size_t a, size_t b) const { return edges[a] < edges[b]; }
+};
+
+} // end anonymous namespace
+
+DirectedGraph::DirectedGraph()
+    : BaseGraph(BaseGraph::COMPRESSED_DIRECTED_GRAPH, true)
+    , mRetentions(0)
+{
+    build(0, std::vector<EdgeIds>());
+}
+
+DirectedGraph::DirectedGraph(BaseGraph::ImplementationType type)
+    : BaseGraph(type, true)
+    , mRetentions(0)
+{
+    build(0, std::vector<EdgeIds>());
+}
+
+DirectedGraph::DirectedGraph(size_t numberOfVertices, const std::vector<EdgeIds>& edges, const VertexFactory& vertexFactory)
+    : BaseGraph(BaseGraph::COMPRESSED_DIRECTED_GRAPH, true)
+    , mVertexFactory(vertexFactory)
+    , mRetentions(0)
+{
+    std::vector<EdgeIds>::const_iterator cit = edges.begin();
+    for(; cit != edges.end(); ++cit)
+    {
+        if(cit->first >= numberOfVertices || cit->second >= numberOfVertices)
+        {
+            throw std::invalid_argument("graph_analysis::compressed::DirectedGraph: edge refers to an invalid vertex id");
+        }
+    }
+
+    build(numberOfVertices, edges);
+}
+
+DirectedGraph::DirectedGraph(const BaseGraph& graph, const VertexFactory& vertexFactory)
+    : BaseGraph(BaseGraph::COMPRESSED_DIRECTED_GRAPH, true)
+    , mVertexFactory(vertexFactory)
+    , mRetentions(0)
+{
+    // Number the vertices in iteration order
+    PropertyMap<GraphElementId> positions(0, graph.getVertexIdUpperBound());
+    GraphElementId numberOfVertices = 0;
+    VertexIterator::Ptr vertexIt = graph.getVertexIterator();
+    while(vertexIt->next())
+    {
+        positions.set(graph.getVertexId(vertexIt->current()), numberOfVertices++);
+    }
+
+    std::vector<EdgeIds> edges;
+    edges.reserve(graph.getEdgeCount());
+    graph_analysis::EdgeIterator::Ptr edgeIt = graph.getEdgeIterator();
+    while(edgeIt->next())
+    {
+        const Edge::Ptr& edge = edgeIt->current();
+        edges.push_back(EdgeIds( positions.get(graph.getVertexId(edge->getSourceVertex())),
+                    positions.get(graph.getVertexId(edge->getTargetVertex())) ));
+    }
+
+    build(numberOfVertices, edges);
+}
+
+DirectedGraph::DirectedGraph(const DirectedGraph& other)
+    : BaseGraph(other.getImplementationType(), true)
+    , mVertexFactory(other.mVertexFactory)
+    , mRetentions(0)
+{
+    setAdjacency(other.mAdjacency, other.mpStorage);
+    setEdgeIndexEnabled(other.isEdgeIndexEnabled());
+}
+
+DirectedGraph::~DirectedGraph()
+{
+    releaseElements();
+}
+
+std::vector<GraphElementId> DirectedGraph::build(size_t numberOfVertices, const std::vector<EdgeIds>& edges)
+{
+    // Edge ids follow the order by source and target, so that the out lists
+    // are ascending
+    size_t size = edges.size();
+    std::vector<size_t> sortedEdges(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        sortedEdges[i] = i;
+    }
+    std::stable_sort(sortedEdges.begin(), sortedEdges.end(), EdgeOrder(edges));
+
+    std::vector<GraphElementId> edgeIds(size);
+    for(size_t e = 0; e < size; ++e)
+    {
+        edgeIds[ sortedEdges[e] ] = e;
+    }
+
+    shared_ptr<EncodedAdjacency> encoded(new EncodedAdjacency());
+    std::vector<GraphElementId>& edgeOffsets = encoded->edgeOffsets;
+    edgeOffsets.assign(numberOfVertices + 1, 0);
+    for(size_t i = 0; i < size; ++i)
+    {
+        ++edgeOffsets[edges[i].first + 1];
+    }
+    for(size_t v = 0; v < numberOfVertices; ++v)
+    {
+        edgeOffsets[v + 1] += edgeOffsets[v];
+    }
+
+    std::vector<uint64_t>& outOffsets = encoded->outOffsets;
+    std::vector<uint8_t>& outData = encoded->outData;
+    outOffsets.assign(numberOfVertices + 1, 0);
+    outData.reserve(size*2);
+    for(GraphElementId v = 0; v < numberOfVertices; ++v)
+    {
+        outOffsets[v] = outData.size();
+        GraphElementId previous = v;
+        for(GraphElementId e = edgeOffsets[v]; e < edgeOffsets[v + 1]; ++e)
+        {
+            GraphElementId target = edges[ sortedEdges[e] ].second;
+            if(e == edgeOffsets[v])
+            {
+                encodeVarInt(outData, encodeZigZag(static_cast<int64_t>(target) - static_cast<int64_t>(v)));
+            } else {
+                encodeVarInt(outData, target - previous);
+            }
+            previous = target;
+        }
+    }
+    outOffsets[numberOfVertices] = outData.size();
+
+    // Counting sort of the edge ids by target, which keeps the in lists
+    // ascending by source
+    std::vector<GraphElementId> inOffsets(numberOfVertices + 1, 0);
+    for(size_t i = 0; i < size; ++i)
+    {
+        ++inOffsets[edges[i].second + 1];
+    }
+    for(size_t v = 0; v < numberOfVertices; ++v)
+    {
+        inOffsets[v + 1] += inOffsets[v];
+    }
+    std::vector<GraphElementId> inEdges(size);
+    std::vector<GraphElementId> inPosition(inOffsets.begin(), inOffsets.end() - 1);
+    for(GraphElementId e = 0; e < size; ++e)
+    {
+        inEdges[ inPosition[ edges[ sortedEdges[e] ].second ]++ ] = e;
+    }
+
+    std::vector<uint64_t>& inByteOffsets = encoded->inOffsets;
+    std::vector<uint8_t>& inData = encoded->inData;
+    inByteOffsets.assign(numberOfVertices + 1, 0);
+    inData.reserve(size*3);
+    for(GraphElementId v = 0; v < numberOfVertices; ++v)
+    {
+        inByteOffsets[v] = inData.size();
+        GraphElementId previous = v;
+        for(GraphElementId i = inOffsets[v]; i < inOffsets[v + 1]; ++i)
+        {
+            GraphElementId edgeId = inEdges[i];
+            GraphElementId source = edges[ sortedEdges[edgeId] ].first;
+            if(i == inOffsets[v])
+            {
+                encodeVarInt(inData, encodeZigZag(static_cast<int64_t>(source) - static_cast<int64_t>(v)));
+            } else {
+                encodeVarInt(inData, source - previous);
+            }
+            encodeVarInt(inData, edgeId - edgeOffsets[source]);
+            previous = source;
+        }
+    }
+    inByteOffsets[numberOfVertices] = inData.size();
+
+    outData.shrink_to_fit();
+    inData.shrink_to_fit();
+
+    Adjacency adjacency;
+    adjacency.outOffsets = Span<uint64_t>(outOffsets.data(), outOffsets.size());
+    adjacency.edgeOffsets = Span<GraphElementId>(edgeOffsets.data(), edgeOffsets.size());
+    adjacency.outData = Span<uint8_t>(outData.data(), outData.size());
+    adjacency.inOffsets = Span<uint64_t>(inByteOffsets.data(), inByteOffsets.size());
+    adjacency.inData = Span<uint8_t>(inData.data(), inData.size());
+    setAdjacency(adjacency, encoded);
+
+    LOG_DEBUG_S << "graph_analysis::compressed::DirectedGraph: encoded " << numberOfVertices << " vertices and "
+        << size << " edges in " << outData.size() + inData.size() << " bytes";
+    return edgeIds;
+}
+
+void DirectedGraph::setAdjacency(const Adjacency& adjacency, const shared_ptr<void>& storage)
+{
+    releaseElements();
+    mAdjacency = adjacency;
+    mpStorage = storage;
+}
+
+GapDecoder DirectedGraph::getOutDecoder(GraphElementId vertexId) const
+{
+    // The offsets are validated on access, since an external adjacency is
+    // not validated as a whole
+    uint64_t begin = mAdjacency.outOffsets[vertexId];
+    uint64_t end = mAdjacency.outOffsets[vertexId + 1];
+    if(begin > end || end > mAdjacency.outData.size()
+            || mAdjacency.edgeOffsets[vertexId] > mAdjacency.edgeOffsets[vertexId + 1]
+            || mAdjacency.edgeOffsets[vertexId + 1] > getEdgeCount())
+    {
+        throw std::runtime_error("graph_analysis::compressed::DirectedGraph::getOutDecoder: corrupt adjacency");
+    }
+    const uint8_t* data = mAdjacency.outData.data();
+    return GapDecoder(data + begin, data + end, vertexId, getVertexCount());
+}
+
+GapDecoder DirectedGraph::getInDecoder(GraphElementId vertexId) const
+{
+    uint64_t begin = mAdjacency.inOffsets[vertexId];
+    uint64_t end = mAdjacency.inOffsets[vertexId + 1];
+    if(begin > end || end > mAdjacency.inData.size())
+    {
+        throw std::runtime_error("graph_analysis::compressed::DirectedGraph::getInDecoder: corrupt adjacency");
+    }
+    const uint8_t* data = mAdjacency.inData.data();
+    return GapDecoder(data + begin, data + end, vertexId, getVertexCount());
+}
+
+GraphElementId DirectedGraph::getOutEdgeId(GraphElementId sourceVertexId, uint64_t position) const
+{
+    GraphElementId firstEdgeId = mAdjacency.edgeOffsets[sourceVertexId];
+    if(firstEdgeId > mAdjacency.edgeOffsets[sourceVertexId + 1]
+            || position >= mAdjacency.edgeOffsets[sourceVertexId + 1] - firstEdgeId)
+    {
+        throw std::runtime_error("graph_analysis::compressed::DirectedGraph::getOutEdgeId: corrupt adjacency");
+    }
+    return firstEdgeId + static_cast<GraphElementId>(position);
+}
+
+Vertex::Ptr DirectedGraph::materializeVertex(GraphElementId vertexId) const
+{
+    {
+        std::lock_guard<std::mutex> lock(mElementMutex);
+        Vertex::Ptr vertex = mVertices.get(vertexId, mRetentions > 0);
+        if(vertex)
+        {
+            return vertex;
+        }
+    }
+
+    // The factory is called without holding the lock, since it might access
+    // this graph
+    Vertex::Ptr created = createVertex(vertexId);
+
+    std::lock_guard<std::mutex> lock(mElementMutex);
+    // Another thread might have created the vertex meanwhile
+    bool retain = mRetentions > 0;
+    Vertex::Ptr vertex = mVertices.get(vertexId, retain);
+    if(!vertex)
+    {
+        vertex = created;
+        vertex->associate(getId(), vertexId);
+        mVertices.insert(vertexId, vertex, retain);
+    }
+    return vertex;
+}
+
+Edge::Ptr DirectedGraph::materializeEdge(GraphElementId edgeId, GraphElementId sourceVertexId, GraphElementId targetVertexId) const
+{
+    // An out list with more entries than edge ids would exceed the edges
+    if(edgeId >= getEdgeCount())
+    {
+        throw std::runtime_error("graph_analysis::compressed::DirectedGraph::materializeEdge: corrupt adjacency");
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mElementMutex);
+        Edge::Ptr edge = mEdges.get(edgeId, mRetentions > 0);
+        if(edge)
+        {
+            return edge;
+        }
+    }
+
+    Vertex::Ptr source = materializeVertex(sourceVertexId);
+    Vertex::Ptr target = materializeVertex(targetVertexId);
+    Edge::Ptr created = createEdge(edgeId, source, target);
+
+    std::lock_guard<std::mutex> lock(mElementMutex);
+    // Another thread might have created the edge meanwhile
+    bool retain = mRetentions > 0;
+    Edge::Ptr edge = mEdges.get(edgeId, retain);
+    if(!edge)
+    {
+        edge = created;
+        edge->associate(getId(), edgeId);
+        mEdges.insert(edgeId, edge, retain);
+    }
+    return edge;
+}
+
+Vertex::Ptr DirectedGraph::createVertex(GraphElementId vertexId) const
+{
+    if(mVertexFactory)
+    {
+        return mVertexFactory(vertexId);
+    }
+    return Vertex::Ptr(new Vertex());
+}
+
+Edge::Ptr DirectedGraph::createEdge(GraphElementId edgeId, const Vertex::Ptr& sourceVertex, const Vertex::Ptr& targetVertex) const
+{
+    (void) edgeId;
+    return Edge::Ptr(new Edge(sourceVertex, targetVertex));
+}
+
+void DirectedGraph::releaseElements()
+{
+    // Declared before the lock, so that the elements are destroyed after it
+    // has been released
+    std::vector<Edge::Ptr> edges;
+    std::vector<Vertex::Ptr> vertices;
+    std::lock_guard<std::mutex> lock(mElementMutex);
+    mEdges.clear(getId(), edges);
+    mVertices.clear(getId(), vertices);
+}
+
+void DirectedGraph::retainElements(bool retain) const
+{
+    std::vector<Edge::Ptr> edges;
+    std::vector<Vertex::Ptr> vertices;
+    std::lock_guard<std::mutex> lock(mElementMutex);
+    if(retain)
+    {
+        ++mRetentions;
+        return;
+    }
+
+    // Ending a retention which has not been started is a usage error, which
+    // cannot be thrown from the destructor of ElementRetention
+    assert(mRetentions > 0);
+    if(mRetentions > 0 && --mRetentions == 0)
+    {
+        mEdges.release(edges);
+        mVertices.release(vertices);
+    }
+}
+
+GraphElementId DirectedGraph::getSourceVertexId(GraphElementId edgeId) const
+{
+    if(edgeId >= getEdgeCount())
+    {
+        throw std::invalid_argument("graph_analysis::compressed::DirectedGraph::getSourceVertexId: invalid edge id");
+    }
+    // The source is the last vertex whose first edge id is not larger
+    Span<GraphElementId>::const_iterator cit = std::upper_bound(mAdjacency.edgeOffsets.begin(), mAdjacency.edgeOffsets.end(), edgeId);
+    return static_cast<GraphElementId>(cit - mAdjacency.edgeOffsets.begin()) - 1;
+}
+
+GraphElementId DirectedGraph::getTargetVertexId(GraphElementId edgeId) const
+{
+    GraphElementId sourceVertexId = getSourceVertexId(edgeId);
+    GapDecoder decoder = getOutDecoder(sourceVertexId);
+    GraphElementId targetVertexId = decoder.next();
+    for(GraphElementId e = getFirstOutEdgeId(sourceVertexId); e < edgeId; ++e)
+    {
+        targetVertexId = decoder.next();
+    }
+    return targetVertexId;
+}
+
+std::vector<GraphElementId> DirectedGraph::getOutNeighbours(GraphElementId vertexId) const
+{
+    std::vector<GraphElementId> neighbours;
+    neighbours.reserve(getFirstOutEdgeId(vertexId + 1) - getFirstOutEdgeId(vertexId));
+    GapDecoder decoder = getOutDecoder(vertexId);
+    while(decoder.hasNext())
+    {
+        neighbours.push_back(decoder.next());
+    }
+    return neighbours;
+}
+
+std::vector<GraphElementId> DirectedGraph::getInNeighbours(GraphElementId vertexId) const
+{
+    std::vector<GraphElementId> neighbours;
+    GapDecoder decoder = getInDecoder(vertexId);
+    while(decoder.hasNext())
+    {
+        neighbours.push_back(decoder.next());
+        decoder.nextValue();
+    }
+    return neighbours;
+}
+
+size_t DirectedGraph::getStorageSize() const
+{
+    std::lock_guard<std::mutex> lock(mElementMutex);
+    // A cache entry is a node linked into a bucket list, a retained element
+    // additionally costs the object
+    return mAdjacency.outData.size() + mAdjacency.inData.size()
+        + (mAdjacency.outOffsets.size() + mAdjacency.inOffsets.size())*sizeof(uint64_t)
+        + mAdjacency.edgeOffsets.size()*sizeof(GraphElementId)
+        + mVertices.entries.size()*(sizeof(ElementCache<Vertex>::Entries::value_type) + 2*sizeof(void*))
+        + mEdges.entries.size()*(sizeof(ElementCache<Edge>::Entries::value_type) + 2*sizeof(void*))
+        + mVertices.numberOfRetained*sizeof(Vertex) + mEdges.numberOfRetained*sizeof(Edge);
+}
+
+BaseGraph::Ptr DirectedGraph::copy() const
+{
+    return BaseGraph::Ptr(new DirectedGraph(*this));
+}
+
+BaseGraph::Ptr DirectedGraph::newInstance() const
+{
+    return BaseGraph::Ptr(new DirectedGraph());
+}
+
+GraphElementId DirectedGraph::addVertexInternal(const Vertex::Ptr& vertex)
+{
+    (void) vertex;
+    throw std::runtime_error("graph_analysis::compressed::DirectedGraph::addVertex: graph is read-only");
+}
+
+void DirectedGraph::removeVertexInternal(const Vertex::Ptr& vertex)
+{
+    (void) vertex;
+    throw std::runtime_error("graph_analysis::compressed::DirectedGraph::removeVertex: graph is read-only");
+}
+
+GraphElementId DirectedGraph::addEdgeInternal(const Edge::Ptr& edge, GraphElementId sourceVertexId, GraphElementId targetVertexId)
+{
+    (void) edge; (void) sourceVertexId; (void) targetVertexId;
+    throw std::runtime_error("graph_analysis::compressed::DirectedGraph::addEdge: graph is read-only");
+}
+
+void DirectedGraph::removeEdgeInternal(const Edge::Ptr& edge)
+{
+    (void) edge;
+    throw std::runtime_error("graph_analysis::compressed::DirectedGraph::removeEdge: graph is read-only");
+}
+
+Vertex::Ptr DirectedGraph::getVertex(GraphElementId id) const
+{
+    if(id >= getVertexCount())
+    {
+        throw std::invalid_argument("graph_analysis::compressed::DirectedGraph::getVertex: invalid vertex id");
+    }
+    return materializeVertex(id);
+}
+
+Edge::Ptr DirectedGraph::getEdge(GraphElementId id) const
+{
+    if(id >= getEdgeCount())
+    {
+        throw std::invalid_argument("graph_analysis::compressed::DirectedGraph::getEdge: invalid edge id");
+    }
+    return materializeEdge(id, getSourceVertexId(id), getTargetVertexId(id));
+}
+
+VertexIterator::Ptr DirectedGraph::getVertexIterator() const
+{
+    NodeIterator<DirectedGraph>* it = new NodeIterator<DirectedGraph>(*this);
+    return VertexIterator::Ptr(it);
+}
+
+graph_analysis::EdgeIterator::Ptr DirectedGraph::getEdgeIterator() const
+{
+    EdgeIterator<DirectedGraph>* it = new EdgeIterator<DirectedGraph>(*this);
+    return graph_analysis::EdgeIterator::Ptr(it);
+}
+
+graph_analysis::EdgeIterator::Ptr DirectedGraph::getEdgeIterator(const Vertex::Ptr& vertex) const
+{
+    InOutEdgeIterator<DirectedGraph>* it = new InOutEdgeIterator<DirectedGraph>(*this, vertex);
+    return graph_analysis::EdgeIterator::Ptr(it);
+}
+
+graph_analysis::EdgeIterator::Ptr DirectedGraph::getOutEdgeIterator(const Vertex::Ptr& vertex) const
+{
+    OutEdgeIterator<DirectedGraph>* it = new OutEdgeIterator<DirectedGraph>(*this, vertex);
+    return graph_analysis::EdgeIterator::Ptr(it);
+}
+
+graph_analysis::EdgeIterator::Ptr DirectedGraph::getInEdgeIterator(const Vertex::Ptr& vertex) const
+{
+    InEdgeIterator<DirectedGraph>* it = new InEdgeIterator<DirectedGraph>(*this, vertex);
+    return graph_analysis::EdgeIterator::Ptr(it);
+}
+
+SubGraph::Ptr DirectedGraph::createSubGraph(const BaseGraph::Ptr& baseGraph) const
+{
+    DirectedGraph::Ptr diGraph = dynamic_pointer_cast<DirectedGraph>(baseGraph);
+    if(!diGraph)
+    {
+        throw
+            std::invalid_argument("graph_analysis::compressed::DirectedGraph::createSubGraph:"
+                    " can only create a subgraph for a compressed graph, but"
+                    " casting of argument failed");
+    }
+    // Enable all nodes and edges
+    return make_shared<SubGraph>(baseGraph);
+}
+
+} // end namespace compressed
+} // end namespace graph_analysis
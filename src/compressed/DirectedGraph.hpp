@@ -0,0 +1,413 @@
+#ifndef GRAPH_ANALYSIS_COMPRESSED_DIRECTED_GRAPH_HPP
+#define GRAPH_ANALYSIS_COMPRESSED_DIRECTED_GRAPH_HPP
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include "../BaseGraph.hpp"
+#include "../Span.hpp"
+#include "GapCoding.hpp"
+#include "NodeIterator.hpp"
+#include "EdgeIterator.hpp"
+
+namespace graph_analysis {
+namespace compressed {
+
+/**
+ * \class DirectedGraph
+ * \brief Immutable directed graph, which stores the adjacency in compressed
+ * form and materializes vertices and edges lazily
+ * \details
+ * The graph stores only its structure: vertices are numbered densely
+ * 0..order-1, edges 0..size-1 sorted by source and target vertex. The
+ * neighbour lists are encoded as varint gap sequences (see GapDecoder), so
+ * that an edge typically costs two to four bytes instead of an Edge object
+ * plus the nodes of a graph library.
+ *
+ \verbatim
+   out offsets  (order + 1): start of the out list of each vertex in bytes
+   edge offsets (order + 1): id of the first out edge of each vertex
+   out data:                 gap encoded target ids
+   in offsets   (order + 1): start of the in list of each vertex in bytes
+   in data:                  gap encoded source ids, each followed by the
+                             position of the edge in the out list of the source
+ \endverbatim
+ *
+ * Vertex and Edge objects are only created once an iterator reaches them or
+ * they are requested by id, iterators skip elements by id before creating
+ * them (see SubGraph). The graph does not hold the materialized elements:
+ * an element lives as long as it is referenced outside of the graph, and
+ * requesting its id meanwhile returns the same instance. Algorithms which
+ * borrow references to elements, as BFS and DFS do, keep them alive with a
+ * BaseGraph::ElementRetention for the duration of the search. Thus memory is
+ * spent only on the elements in use, at the cost of creating elements again
+ * which are requested repeatedly.
+ * Vertices are created by the vertex factory, which allows to attach the
+ * data of a vertex (e.g. its label) on demand.
+ *
+ * The encoded adjacency is immutable and thus shared between copies of the
+ * graph. Subclasses can provide it from external storage, see
+ * mapped::DirectedGraph.
+ *
+ * All operations that modify the graph throw a std::runtime_error
+ */
+class DirectedGraph : public BaseGraph
+{
+public:
+    typedef shared_ptr<DirectedGraph> Ptr;
+    typedef std::pair<GraphElementId, GraphElementId> EdgeIds;
+    typedef function1<Vertex::Ptr, GraphElementId> VertexFactory;
+
+    friend class NodeIterator<DirectedGraph>;
+    friend class EdgeIterator<DirectedGraph>;
+    friend class OutEdgeIterator<DirectedGraph>;
+    friend class InEdgeIterator<DirectedGraph>;
+
+    /**
+     * \brief Create an empty graph
+     */
+    DirectedGraph();
+
+    /**
+     * \brief Create a graph from a list of edges
+     * \param numberOfVertices number of vertices, i.e. the vertex ids are
+     * 0..numberOfVertices-1
+     * \param edges list of (source, target) vertex id pairs
+     * \param vertexFactory function to create the vertex with the given id,
+     * by default a plain Vertex is created
+     * \throw std::invalid_argument if an edge refers to an invalid vertex id
+     */
+    DirectedGraph(size_t numberOfVertices, const std::vector<EdgeIds>& edges, const VertexFactory& vertexFactory = VertexFactory());
+
+    /**
+     * \brief Create the compressed representation of the structure of the
+     * given graph
+     * \details The vertices are numbered in the iteration order of the
+     * given graph. Vertices and edges of the given graph are not referenced,
+     * use the vertex factory to restore their data
+     */
+    explicit DirectedGraph(const BaseGraph& graph, const VertexFactory& vertexFactory = VertexFactory());
+
+    /**
+     * \brief Create a copy which shares the encoded adjacency, but
+     * materializes its own elements
+     */
+    DirectedGraph(const DirectedGraph& other);
+
+    /**
+     * The destructor disassociates all materialized vertices and edges from
+     * this graph
+     */
+    ~DirectedGraph();
+
+    BaseGraph::Ptr copy() const;
+
+    BaseGraph::Ptr newInstance() const;
+
+    Vertex::Ptr getVertex(GraphElementId id) const;
+    Edge::Ptr getEdge(GraphElementId id) const;
+
+    /**
+     * Get the number of vertices in O(1)
+     */
+    uint64_t getVertexCount() const { return mAdjacency.outOffsets.size() - 1; }
+
+    /**
+     * Get the number of edges in O(1)
+     */
+    uint64_t getEdgeCount() const { return mAdjacency.edgeOffsets[getVertexCount()]; }
+
+    GraphElementId getVertexIdUpperBound() const { return getVertexCount(); }
+    GraphElementId getEdgeIdUpperBound() const { return getEdgeCount(); }
+
+    /**
+     * Get the number of bytes of the encoded adjacency, of the cache of the
+     * materialized elements and of the elements which are retained
+     */
+    size_t getStorageSize() const;
+
+    /**
+     * Get the vertex iterator for this implementation
+     */
+    VertexIterator::Ptr getVertexIterator() const;
+
+    /**
+     * Get the edge iterator for this implementation
+     */
+    graph_analysis::EdgeIterator::Ptr getEdgeIterator() const;
+
+    graph_analysis::EdgeIterator::Ptr getEdgeIterator(const Vertex::Ptr& vertex) const;
+
+    graph_analysis::EdgeIterator::Ptr getOutEdgeIterator(const Vertex::Ptr& vertex) const;
+
+    graph_analysis::EdgeIterator::Ptr getInEdgeIterator(const Vertex::Ptr& vertex) const;
+
+    /**
+     * Get the ids of the target vertices of the out edges of a vertex,
+     * without materializing any element
+     * The i-th entry belongs to the edge with id getFirstOutEdgeId(vertexId) + i
+     */
+    std::vector<GraphElementId> getOutNeighbours(GraphElementId vertexId) const;
+
+    /**
+     * Get the ids of the source vertices of the in edges of a vertex,
+     * without materializing any element
+     */
+    std::vector<GraphElementId> getInNeighbours(GraphElementId vertexId) const;
+
+    /**
+     * Get the id of the first out edge of a vertex
+     */
+    GraphElementId getFirstOutEdgeId(GraphElementId vertexId) const { return mAdjacency.edgeOffsets[vertexId]; }
+
+    /**
+     * Get the id of the source vertex of the edge with the given id
+     */
+    GraphElementId getSourceVertexId(GraphElementId edgeId) const;
+
+    /**
+     * Get the id of the target vertex of the edge with the given id
+     */
+    GraphElementId getTargetVertexId(GraphElementId edgeId) const;
+
+    /**
+     * Disassociate the materialized vertices and edges from this graph
+     * \details Elements which are still referenced elsewhere remain valid,
+     * but a later request creates a new instance for the same id. Do not call
+     * while an algorithm borrows references to the elements of this graph
+     */
+    void releaseElements();
+
+protected:
+    /**
+     * \brief Arrays of the encoded adjacency
+     */
+    struct Adjacency
+    {
+        Span<uint64_t> outOffsets;
+        Span<GraphElementId> edgeOffsets;
+        Span<uint8_t> outData;
+        Span<uint64_t> inOffsets;
+        Span<uint8_t> inData;
+    };
+
+    /**
+     * \brief Create an empty graph of the given implementation type
+     */
+    explicit DirectedGraph(BaseGraph::ImplementationType type);
+
+    /**
+     * Encode the given edges
+     * \return the ids of the edges in the order of the given list
+     */
+    std::vector<GraphElementId> build(size_t numberOfVertices, const std::vector<EdgeIds>& edges);
+
+    /**
+     * Use the given adjacency, whose arrays have to remain valid as long as
+     * the storage exists
+     */
+    void setAdjacency(const Adjacency& adjacency, const shared_ptr<void>& storage);
+
+    const Adjacency& getAdjacency() const { return mAdjacency; }
+
+    /**
+     * Create the vertex with the given id, by default using the vertex
+     * factory
+     */
+    virtual Vertex::Ptr createVertex(GraphElementId vertexId) const;
+
+    /**
+     * Create the edge with the given id between the given vertices
+     */
+    virtual Edge::Ptr createEdge(GraphElementId edgeId, const Vertex::Ptr& sourceVertex, const Vertex::Ptr& targetVertex) const;
+
+    /**
+     * \throw std::runtime_error since the graph is read-only
+     */
+    virtual GraphElementId addVertexInternal(const Vertex::Ptr& vertex);
+
+    /**
+     * \throw std::runtime_error since the graph is read-only
+     */
+    virtual void removeVertexInternal(const Vertex::Ptr& vertex);
+
+    /**
+     * \throw std::runtime_error since the graph is read-only
+     */
+    virtual GraphElementId addEdgeInternal(const Edge::Ptr& edge, GraphElementId sourceVertexId, GraphElementId targetVertexId);
+
+    /**
+     * \throw std::runtime_error since the graph is read-only
+     */
+    virtual void removeEdgeInternal(const Edge::Ptr& edge);
+
+    virtual SubGraph::Ptr createSubGraph(const BaseGraph::Ptr& baseGraph) const;
+
+    /**
+     * Hold the materialized elements until the last retention ends
+     */
+    virtual void retainElements(bool retain) const;
+
+private:
+    /**
+     * \brief Materialized elements by id, which are held by the cache only
+     * while they are retained
+     * \details Entries of expired elements are dropped once the cache has
+     * doubled in size since the last time
+     */
+    template<typename T>
+    struct ElementCache
+    {
+        struct Entry
+        {
+            weak_ptr<T> element;
+            shared_ptr<T> retained;
+        };
+        typedef boost::unordered_map<GraphElementId, Entry> Entries;
+
+        Entries entries;
+        size_t numberOfRetained;
+        size_t pruneSize;
+
+        ElementCache()
+            : numberOfRetained(0)
+            , pruneSize(1024)
+        {}
+
+        /**
+         * Get the element with the given id if it is in use
+         */
+        shared_ptr<T> get(GraphElementId id, bool retain)
+        {
+            typename Entries::iterator it = entries.find(id);
+            if(it == entries.end())
+            {
+                return shared_ptr<T>();
+            }
+            shared_ptr<T> element = it->second.element.lock();
+            if(element && retain && !it->second.retained)
+            {
+                it->second.retained = element;
+                ++numberOfRetained;
+            }
+            return element;
+        }
+
+        void insert(GraphElementId id, const shared_ptr<T>& element, bool retain)
+        {
+            if(entries.size() >= pruneSize)
+            {
+                prune();
+            }
+            Entry& entry = entries[id];
+            entry.element = element;
+            if(retain)
+            {
+                entry.retained = element;
+                ++numberOfRetained;
+            }
+        }
+
+        /**
+         * End the retention, the retained elements are moved to the given
+         * list so that they can be destroyed outside of the lock
+         */
+        void release(std::vector< shared_ptr<T> >& released)
+        {
+            released.reserve(numberOfRetained);
+            typename Entries::iterator it = entries.begin();
+            for(; it != entries.end(); ++it)
+            {
+                if(it->second.retained)
+                {
+                    released.push_back(it->second.retained);
+                    it->second.retained.reset();
+                }
+            }
+            numberOfRetained = 0;
+        }
+
+        /**
+         * Disassociate the elements in use from the graph and empty the
+         * cache
+         */
+        void clear(GraphId graphId, std::vector< shared_ptr<T> >& released)
+        {
+            typename Entries::iterator it = entries.begin();
+            for(; it != entries.end(); ++it)
+            {
+                shared_ptr<T> element = it->second.element.lock();
+                if(element)
+                {
+                    element->disassociate(graphId);
+                    released.push_back(element);
+                }
+            }
+            entries.clear();
+            numberOfRetained = 0;
+        }
+
+        void prune()
+        {
+            typename Entries::iterator it = entries.begin();
+            while(it != entries.end())
+            {
+                if(it->second.element.expired())
+                {
+                    it = entries.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            pruneSize = std::max<size_t>(1024, 2*entries.size());
+        }
+    };
+
+    /**
+     * Get the decoder for the out list of a vertex
+     * \throw std::runtime_error if the offsets of the vertex are corrupt
+     */
+    GapDecoder getOutDecoder(GraphElementId vertexId) const;
+
+    /**
+     * Get the decoder for the in list of a vertex, each entry is followed by
+     * the position of the edge in the out list of the source
+     * \throw std::runtime_error if the offsets of the vertex are corrupt
+     */
+    GapDecoder getInDecoder(GraphElementId vertexId) const;
+
+    /**
+     * Get the id of the edge at the given position in the out list of its
+     * source vertex
+     * \throw std::runtime_error if the position exceeds the out list
+     */
+    GraphElementId getOutEdgeId(GraphElementId sourceVertexId, uint64_t position) const;
+
+    /**
+     * Get or create the vertex with the given id
+     */
+    Vertex::Ptr materializeVertex(GraphElementId vertexId) const;
+
+    /**
+     * Get or create the edge with the given id
+     */
+    Edge::Ptr materializeEdge(GraphElementId edgeId, GraphElementId sourceVertexId, GraphElementId targetVertexId) const;
+
+    VertexFactory mVertexFactory;
+
+    Adjacency mAdjacency;
+    shared_ptr<void> mpStorage;
+
+    /// Guards the materialized elements, so that concurrent readers are
+    /// supported as for the other read-only graphs
+    mutable std::mutex mElementMutex;
+    mutable ElementCache<Vertex> mVertices;
+    mutable ElementCache<Edge> mEdges;
+    /// Number of active retentions
+    mutable size_t mRetentions;
+};
+
+} // end namespace compressed
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_COMPRESSED_DIRECTED_GRAPH_HPP
@@ -0,0 +1,193 @@
+#ifndef GRAPH_ANALYSIS_COMPRESSED_EDGE_ITERATOR_HPP
+#define GRAPH_ANALYSIS_COMPRESSED_EDGE_ITERATOR_HPP
+
+#include "../EdgeIterator.hpp"
+#include "GapCoding.hpp"
+
+namespace graph_analysis {
+namespace compressed {
+
+template<typename T> class InOutEdgeIterator;
+
+/**
+ * Iterate over the out edges of a vertex by decoding its out list
+ * Edges are only materialized if they are not skipped by their id
+ */
+template<typename T>
+class OutEdgeIterator : public graph_analysis::EdgeIterator
+{
+    friend class InOutEdgeIterator<T>;
+
+public:
+    OutEdgeIterator(const T& graph, const Vertex::Ptr& vertex)
+        : mGraph(graph)
+    {
+        reset(mGraph.getVertexId(vertex));
+    }
+
+    bool next()
+    {
+        while( mDecoder.hasNext() )
+        {
+            GraphElementId targetVertexId = mDecoder.next();
+            GraphElementId edgeId = mCurrentIndex++;
+            if(skipId(edgeId))
+            {
+                continue;
+            }
+            Edge::Ptr edge = mGraph.materializeEdge(edgeId, mVertexId, targetVertexId);
+            if(skip(edge))
+            {
+                continue;
+            }
+            setNext(edge);
+            return true;
+        }
+        return false;
+    }
+
+protected:
+    OutEdgeIterator(const T& graph)
+        : mGraph(graph)
+        , mVertexId(0)
+        , mCurrentIndex(0)
+    {}
+
+    /**
+     * Continue with the out edges of the given vertex
+     */
+    void reset(GraphElementId vertexId)
+    {
+        mVertexId = vertexId;
+        mCurrentIndex = mGraph.getFirstOutEdgeId(vertexId);
+        mDecoder = mGraph.getOutDecoder(vertexId);
+    }
+
+    const T& mGraph;
+    GraphElementId mVertexId;
+    GraphElementId mCurrentIndex;
+    GapDecoder mDecoder;
+};
+
+/**
+ * Iterate over all edges in the order of their ids, i.e. over the out edges
+ * of all vertices
+ */
+template<typename T>
+class EdgeIterator : public OutEdgeIterator<T>
+{
+public:
+    EdgeIterator(const T& graph)
+        : OutEdgeIterator<T>(graph)
+    {
+        if(graph.getVertexCount() > 0)
+        {
+            this->reset(0);
+        }
+    }
+
+    bool next()
+    {
+        while(!OutEdgeIterator<T>::next())
+        {
+            if(this->mVertexId + 1 >= this->mGraph.getVertexCount())
+            {
+                return false;
+            }
+            this->reset(this->mVertexId + 1);
+        }
+        return true;
+    }
+};
+
+/**
+ * Iterate over the in edges of a vertex by decoding its in list
+ * Edges are only materialized if they are not skipped by their id
+ */
+template<typename T>
+class InEdgeIterator : public graph_analysis::EdgeIterator
+{
+    friend class InOutEdgeIterator<T>;
+
+public:
+    InEdgeIterator(const T& graph, const Vertex::Ptr& vertex)
+        : mGraph(graph)
+        , mVertexId(graph.getVertexId(vertex))
+        , mDecoder(graph.getInDecoder(mVertexId))
+    {}
+
+    bool next()
+    {
+        while( mDecoder.hasNext() )
+        {
+            GraphElementId sourceVertexId = mDecoder.next();
+            GraphElementId edgeId = mGraph.getOutEdgeId(sourceVertexId, mDecoder.nextValue());
+            if(skipId(edgeId))
+            {
+                continue;
+            }
+            Edge::Ptr edge = mGraph.materializeEdge(edgeId, sourceVertexId, mVertexId);
+            if(skip(edge))
+            {
+                continue;
+            }
+            setNext(edge);
+            return true;
+        }
+        return false;
+    }
+
+protected:
+    const T& mGraph;
+    GraphElementId mVertexId;
+    GapDecoder mDecoder;
+};
+
+template<typename T>
+class InOutEdgeIterator : public graph_analysis::EdgeIterator
+{
+public:
+    InOutEdgeIterator(const T& graph, const Vertex::Ptr& vertex)
+        : mInEdgeIterator(graph, vertex)
+        , mOutEdgeIterator(graph, vertex)
+    {
+        // Apply the id skip function of this iterator before the edges are
+        // materialized
+        IdSkipFunction idSkipFunction = [this](GraphElementId id) { return skipId(id); };
+        mInEdgeIterator.setIdSkipFunction(idSkipFunction);
+        mOutEdgeIterator.setIdSkipFunction(idSkipFunction);
+    }
+
+    bool next()
+    {
+        while(mInEdgeIterator.next())
+        {
+            if(skip(mInEdgeIterator.current()))
+            {
+                continue;
+            }
+            setNext( mInEdgeIterator.current() );
+            return true;
+        }
+
+        while(mOutEdgeIterator.next())
+        {
+            if(skip(mOutEdgeIterator.current()))
+            {
+                continue;
+            }
+            setNext( mOutEdgeIterator.current() );
+            return true;
+        }
+
+        return false;
+    }
+
+protected:
+    InEdgeIterator<T> mInEdgeIterator;
+    OutEdgeIterator<T> mOutEdgeIterator;
+};
+
+} // end namespace compressed
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_COMPRESSED_EDGE_ITERATOR_HPP
@@ -0,0 +1,144 @@
+#ifndef GRAPH_ANALYSIS_COMPRESSED_GAP_CODING_HPP
+#define GRAPH_ANALYSIS_COMPRESSED_GAP_CODING_HPP
+
+#include <stdexcept>
+#include <vector>
+#include <stdint.h>
+#include "../GraphElement.hpp"
+
+namespace graph_analysis {
+namespace compressed {
+
+/**
+ * Append an unsigned integer in varint encoding, i.e. 7 bits per byte
+ * starting with the least significant bits, where the high bit of a byte
+ * marks that more bytes follow
+ */
+inline void encodeVarInt(std::vector<uint8_t>& data, uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        data.push_back( static_cast<uint8_t>(value | 0x80) );
+        value >>= 7;
+    }
+    data.push_back( static_cast<uint8_t>(value) );
+}
+
+/**
+ * Read a varint encoded unsigned integer and advance the data pointer
+ * \param end end of the encoded data, which must not be read
+ * \throw std::runtime_error if the value is truncated or exceeds 64 bits
+ */
+inline uint64_t decodeVarInt(const uint8_t*& data, const uint8_t* end)
+{
+    uint64_t value = 0;
+    for(unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if(data >= end)
+        {
+            break;
+        }
+        uint8_t byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if(!(byte & 0x80))
+        {
+            return value;
+        }
+    }
+    throw std::runtime_error("graph_analysis::compressed::decodeVarInt: invalid encoded value");
+}
+
+/**
+ * Map a signed difference to an unsigned integer, so that small negative
+ * differences are encoded in few bytes as well
+ */
+inline uint64_t encodeZigZag(int64_t value) { return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+inline int64_t decodeZigZag(uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+/**
+ * \class GapDecoder
+ * \brief Decode the ascending list of neighbours of a vertex
+ * \details Neighbour lists are encoded in WebGraph style as gap sequence: the
+ * first neighbour as (zigzag encoded) difference to the vertex itself, all
+ * following neighbours as difference to their predecessor. Every entry can
+ * be followed by a fixed number of additional varint values, which can be
+ * read with nextValue.
+ *
+ * The decoder never reads beyond the end of the list and rejects neighbour
+ * ids outside of the graph, so that corrupt data raises a std::runtime_error
+ */
+class GapDecoder
+{
+public:
+    GapDecoder()
+        : mpData(NULL)
+        , mpEnd(NULL)
+        , mVertexId(0)
+        , mNumberOfVertices(0)
+        , mNeighbourId(0)
+        , mFirst(true)
+    {}
+
+    /**
+     * \param numberOfVertices number of vertices of the graph, i.e. the
+     * upper bound of the neighbour ids
+     */
+    GapDecoder(const uint8_t* begin, const uint8_t* end, GraphElementId vertexId, uint64_t numberOfVertices)
+        : mpData(begin)
+        , mpEnd(end)
+        , mVertexId(vertexId)
+        , mNumberOfVertices(numberOfVertices)
+        , mNeighbourId(0)
+        , mFirst(true)
+    {}
+
+    /**
+     * Test if there is a next neighbour
+     */
+    bool hasNext() const { return mpData < mpEnd; }
+
+    /**
+     * Decode the next neighbour
+     * \return id of the neighbour
+     * \throw std::runtime_error if the list is corrupt
+     */
+    GraphElementId next()
+    {
+        uint64_t value = decodeVarInt(mpData, mpEnd);
+        uint64_t neighbourId;
+        if(mFirst)
+        {
+            neighbourId = static_cast<uint64_t>(mVertexId) + static_cast<uint64_t>(decodeZigZag(value));
+            mFirst = false;
+        } else if(value < mNumberOfVertices - mNeighbourId)
+        {
+            neighbourId = mNeighbourId + value;
+        } else {
+            neighbourId = mNumberOfVertices;
+        }
+        if(neighbourId >= mNumberOfVertices)
+        {
+            throw std::runtime_error("graph_analysis::compressed::GapDecoder: invalid neighbour id");
+        }
+        mNeighbourId = static_cast<GraphElementId>(neighbourId);
+        return mNeighbourId;
+    }
+
+    /**
+     * Decode an additional value of the current entry
+     * \throw std::runtime_error if the list is corrupt
+     */
+    uint64_t nextValue() { return decodeVarInt(mpData, mpEnd); }
+
+private:
+    const uint8_t* mpData;
+    const uint8_t* mpEnd;
+    GraphElementId mVertexId;
+    uint64_t mNumberOfVertices;
+    GraphElementId mNeighbourId;
+    bool mFirst;
+};
+
+} // end namespace compressed
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_COMPRESSED_GAP_CODING_HPP
@@ -0,0 +1,49 @@
+#ifndef GRAPH_ANALYSIS_COMPRESSED_NODE_ITERATOR_HPP
+#define GRAPH_ANALYSIS_COMPRESSED_NODE_ITERATOR_HPP
+
+#include "../VertexIterator.hpp"
+
+namespace graph_analysis {
+namespace compressed {
+
+/**
+ * Iterate over the vertex ids of a compressed graph, materializing each
+ * vertex which is not skipped by its id when the iterator advances to it
+ */
+template<typename T>
+class NodeIterator : public VertexIterator
+{
+public:
+    NodeIterator(const T& graph)
+        : mGraph(graph)
+        , mCurrentIndex(0)
+    {}
+
+    bool next()
+    {
+        while( mCurrentIndex < mGraph.getVertexCount() )
+        {
+            GraphElementId vertexId = mCurrentIndex++;
+            if(skipId(vertexId))
+            {
+                continue;
+            }
+            Vertex::Ptr vertex = mGraph.materializeVertex(vertexId);
+            if(skip(vertex))
+            {
+                continue;
+            }
+            setNext(vertex);
+            return true;
+        }
+        return false;
+    }
+
+protected:
+    const T& mGraph;
+    GraphElementId mCurrentIndex;
+};
+
+} // end namespace compressed
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_COMPRESSED_NODE_ITERATOR_HPP
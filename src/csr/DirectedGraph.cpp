@@ -0,0 +1,337 @@
+#include "DirectedGraph.hpp"
+#include "../PropertyMap.hpp"
+#include <base-logging/Logging.hpp>
+#include <stdexcept>
+
+namespace graph_analysis {
+namespace csr {
+
+DirectedGraph::DirectedGraph()
+    : BaseGraph(BaseGraph::CSR_DIRECTED_GRAPH, true)
+    , mDetached(false)
+    , mOutOffsets(1, 0)
+    , mInOffsets(1, 0)
+{
+}
+
+DirectedGraph::DirectedGraph(const BaseGraph& graph, bool detached)
+    : BaseGraph(BaseGraph::CSR_DIRECTED_GRAPH, true)
+    , mDetached(detached)
+{
+    build( Structure(graph, graph.getAllVertices()) );
+}
+
+DirectedGraph::DirectedGraph(const BaseGraph& graph, const std::vector<Vertex::Ptr>& vertexOrder, bool detached)
+    : BaseGraph(BaseGraph::CSR_DIRECTED_GRAPH, true)
+    , mDetached(detached)
+{
+    // The order has to contain every vertex of the graph exactly once
+    bool isPermutation = vertexOrder.size() == graph.order();
+    PropertyMap<bool> seen(false, graph.getVertexIdUpperBound());
+    std::vector<Vertex::Ptr>::const_iterator cit = vertexOrder.begin();
+    for(; isPermutation && cit != vertexOrder.end(); ++cit)
+    {
+        // A vertex of another graph has no id in this graph
+        if(!*cit || !graph.contains(*cit))
+        {
+            isPermutation = false;
+            break;
+        }
+        GraphElementId vertexId = graph.getVertexId(*cit);
+        isPermutation = vertexId < seen.size() && !seen.get(vertexId);
+        if(isPermutation)
+        {
+            seen.set(vertexId, true);
+        }
+    }
+
+    if(!isPermutation)
+    {
+        throw std::invalid_argument("graph_analysis::csr::DirectedGraph: vertex order is not a permutation of the vertices of graph '"
+                + graph.getImplementationTypeName() + "'");
+    }
+    build( Structure(graph, vertexOrder) );
+}
+
+DirectedGraph::DirectedGraph(const Structure& structure, bool detached)
+    : BaseGraph(BaseGraph::CSR_DIRECTED_GRAPH, true)
+    , mDetached(detached)
+{
+    build(structure);
+}
+
+DirectedGraph::DirectedGraph(const DirectedGraph& other)
+    : BaseGraph(BaseGraph::CSR_DIRECTED_GRAPH, true)
+    , mDetached(other.mDetached)
+{
+    build( Structure(other, other.mVertices) );
+    setEdgeIndexEnabled(other.isEdgeIndexEnabled());
+}
+
+DirectedGraph::Structure::Structure(const BaseGraph& graph, const std::vector<Vertex::Ptr>& vertexOrder)
+    : graphName(graph.getImplementationTypeName())
+    , vertices(vertexOrder)
+{
+    // Map the ids of the graph to the positions in the list
+    std::vector<GraphElementId> positions(graph.getVertexIdUpperBound());
+    for(size_t i = 0; i < vertices.size(); ++i)
+    {
+        positions[ graph.getVertexId(vertices[i]) ] = i;
+    }
+
+    graph_analysis::EdgeIterator::Ptr edgeIt = graph.getEdgeIterator();
+    while(edgeIt->next())
+    {
+        const Edge::Ptr& edge = edgeIt->current();
+        edges.push_back(edge);
+        sources.push_back( positions[ graph.getVertexId(edge->getSourceVertex()) ] );
+        targets.push_back( positions[ graph.getVertexId(edge->getTargetVertex()) ] );
+    }
+}
+
+DirectedGraph::~DirectedGraph()
+{
+    if(mDetached)
+    {
+        return;
+    }
+
+    std::vector<Edge::Ptr>::const_iterator eit = mEdges.begin();
+    for(; eit != mEdges.end(); ++eit)
+    {
+        (*eit)->disassociate(getId());
+    }
+
+    std::vector<Vertex::Ptr>::const_iterator vit = mVertices.begin();
+    for(; vit != mVertices.end(); ++vit)
+    {
+        (*vit)->disassociate(getId());
+    }
+}
+
+void DirectedGraph::build(const Structure& structure)
+{
+    const std::vector<Edge::Ptr>& edges = structure.edges;
+    const std::vector<GraphElementId>& sources = structure.sources;
+    const std::vector<GraphElementId>& targets = structure.targets;
+
+    // Assign dense vertex ids in the given order
+    mVertices.reserve(structure.vertices.size());
+    std::vector<Vertex::Ptr>::const_iterator vit = structure.vertices.begin();
+    for(; vit != structure.vertices.end(); ++vit)
+    {
+        assignId(*vit, mVertices.size());
+        mVertices.push_back(*vit);
+    }
+
+    size_t order = mVertices.size();
+    size_t size = edges.size();
+
+    // Counting sort of the edges by source (out) and target (in) vertex
+    mOutOffsets.assign(order + 1, 0);
+    mInOffsets.assign(order + 1, 0);
+    for(size_t i = 0; i < size; ++i)
+    {
+        ++mOutOffsets[sources[i] + 1];
+        ++mInOffsets[targets[i] + 1];
+    }
+    for(size_t v = 0; v < order; ++v)
+    {
+        mOutOffsets[v + 1] += mOutOffsets[v];
+        mInOffsets[v + 1] += mInOffsets[v];
+    }
+
+    mEdges.resize(size);
+    mOutTargets.resize(size);
+    mEdgeSources.resize(size);
+    std::vector<GraphElementId> outPosition(mOutOffsets.begin(), mOutOffsets.end() - 1);
+    for(size_t i = 0; i < size; ++i)
+    {
+        GraphElementId edgeId = outPosition[sources[i]]++;
+        mEdges[edgeId] = edges[i];
+        mOutTargets[edgeId] = targets[i];
+        mEdgeSources[edgeId] = sources[i];
+        assignId(edges[i], edgeId);
+    }
+
+    // Iterate by edge id, so that in edges appear in out edge order
+    mInSources.resize(size);
+    mInEdges.resize(size);
+    std::vector<GraphElementId> inPosition(mInOffsets.begin(), mInOffsets.end() - 1);
+    for(GraphElementId edgeId = 0; edgeId < size; ++edgeId)
+    {
+        GraphElementId position = inPosition[mOutTargets[edgeId]]++;
+        mInSources[position] = mEdgeSources[edgeId];
+        mInEdges[position] = edgeId;
+    }
+
+    LOG_DEBUG_S << "graph_analysis::csr::DirectedGraph: built from '" << structure.graphName
+        << "' with " << order << " vertices and " << size << " edges";
+}
+
+void DirectedGraph::assignId(const Vertex::Ptr& vertex, GraphElementId id)
+{
+    if(mDetached)
+    {
+        mVertexIndex[vertex.get()] = id;
+    } else {
+        vertex->associate(getId(), id);
+    }
+}
+
+void DirectedGraph::assignId(const Edge::Ptr& edge, GraphElementId id)
+{
+    if(mDetached)
+    {
+        mEdgeIndex[edge.get()] = id;
+    } else {
+        edge->associate(getId(), id);
+    }
+}
+
+GraphElementId DirectedGraph::getVertexId(const Vertex::Ptr& vertex) const
+{
+    if(!mDetached)
+    {
+        return BaseGraph::getVertexId(vertex);
+    }
+
+    boost::unordered_map<const Vertex*, GraphElementId>::const_iterator cit = mVertexIndex.find(vertex.get());
+    if(cit == mVertexIndex.end())
+    {
+        throw std::runtime_error("graph_analysis::csr::DirectedGraph::getVertexId: vertex is not part of this graph");
+    }
+    return cit->second;
+}
+
+GraphElementId DirectedGraph::getEdgeId(const Edge::Ptr& edge) const
+{
+    if(!mDetached)
+    {
+        return BaseGraph::getEdgeId(edge);
+    }
+
+    boost::unordered_map<const Edge*, GraphElementId>::const_iterator cit = mEdgeIndex.find(edge.get());
+    if(cit == mEdgeIndex.end())
+    {
+        throw std::runtime_error("graph_analysis::csr::DirectedGraph::getEdgeId: edge is not part of this graph");
+    }
+    return cit->second;
+}
+
+BaseGraph::Ptr DirectedGraph::copy() const
+{
+    return BaseGraph::Ptr(new DirectedGraph(*this));
+}
+
+BaseGraph::Ptr DirectedGraph::newInstance() const
+{
+    return BaseGraph::Ptr(new DirectedGraph());
+}
+
+GraphElementId DirectedGraph::addVertexInternal(const Vertex::Ptr& vertex)
+{
+    (void) vertex;
+    throw std::runtime_error("graph_analysis::csr::DirectedGraph::addVertex: graph is read-only");
+}
+
+void DirectedGraph::removeVertexInternal(const Vertex::Ptr& vertex)
+{
+    (void) vertex;
+    throw std::runtime_error("graph_analysis::csr::DirectedGraph::removeVertex: graph is read-only");
+}
+
+GraphElementId DirectedGraph::addEdgeInternal(const Edge::Ptr& edge, GraphElementId sourceVertexId, GraphElementId targetVertexId)
+{
+    (void) edge; (void) sourceVertexId; (void) targetVertexId;
+    throw std::runtime_error("graph_analysis::csr::DirectedGraph::addEdge: graph is read-only");
+}
+
+void DirectedGraph::removeEdgeInternal(const Edge::Ptr& edge)
+{
+    (void) edge;
+    throw std::runtime_error("graph_analysis::csr::DirectedGraph::removeEdge: graph is read-only");
+}
+
+Vertex::Ptr DirectedGraph::getVertex(GraphElementId id) const
+{
+    if(id >= mVertices.size())
+    {
+        throw std::invalid_argument("graph_analysis::csr::DirectedGraph::getVertex: invalid vertex id");
+    }
+    return mVertices[id];
+}
+
+Edge::Ptr DirectedGraph::getEdge(GraphElementId id) const
+{
+    if(id >= mEdges.size())
+    {
+        throw std::invalid_argument("graph_analysis::csr::DirectedGraph::getEdge: invalid edge id");
+    }
+    return mEdges[id];
+}
+
+Span<GraphElementId> DirectedGraph::getOutNeighbours(GraphElementId vertexId) const
+{
+    const GraphElementId* data = mOutTargets.data();
+    return Span<GraphElementId>(data + mOutOffsets[vertexId], data + mOutOffsets[vertexId + 1]);
+}
+
+Span<GraphElementId> DirectedGraph::getInNeighbours(GraphElementId vertexId) const
+{
+    const GraphElementId* data = mInSources.data();
+    return Span<GraphElementId>(data + mInOffsets[vertexId], data + mInOffsets[vertexId + 1]);
+}
+
+Span<GraphElementId> DirectedGraph::getInEdgeIds(GraphElementId vertexId) const
+{
+    const GraphElementId* data = mInEdges.data();
+    return Span<GraphElementId>(data + mInOffsets[vertexId], data + mInOffsets[vertexId + 1]);
+}
+
+VertexIterator::Ptr DirectedGraph::getVertexIterator() const
+{
+    NodeIterator<DirectedGraph>* it = new NodeIterator<DirectedGraph>(*this);
+    return VertexIterator::Ptr(it);
+}
+
+graph_analysis::EdgeIterator::Ptr DirectedGraph::getEdgeIterator() const
+{
+    EdgeIterator<DirectedGraph>* it = new EdgeIterator<DirectedGraph>(*this);
+    return graph_analysis::EdgeIterator::Ptr(it);
+}
+
+graph_analysis::EdgeIterator::Ptr DirectedGraph::getEdgeIterator(const Vertex::Ptr& vertex) const
+{
+    InOutEdgeIterator<DirectedGraph>* it = new InOutEdgeIterator<DirectedGraph>(*this, vertex);
+    return graph_analysis::EdgeIterator::Ptr(it);
+}
+
+graph_analysis::EdgeIterator::Ptr DirectedGraph::getOutEdgeIterator(const Vertex::Ptr& vertex) const
+{
+    OutEdgeIterator<DirectedGraph>* it = new OutEdgeIterator<DirectedGraph>(*this, vertex);
+    return graph_analysis::EdgeIterator::Ptr(it);
+}
+
+graph_analysis::EdgeIterator::Ptr DirectedGraph::getInEdgeIterator(const Vertex::Ptr& vertex) const
+{
+    InEdgeIterator<DirectedGraph>* it = new InEdgeIterator<DirectedGraph>(*this, vertex);
+    return graph_analysis::EdgeIterator::Ptr(it);
+}
+
+SubGraph::Ptr DirectedGraph::createSubGraph(const BaseGraph::Ptr& baseGraph) const
+{
+    DirectedGraph::Ptr diGraph = dynamic_pointer_cast<DirectedGraph>(baseGraph);
+    if(!diGraph)
+    {
+        throw
+            std::invalid_argument("graph_analysis::csr::DirectedGraph::createSubGraph:"
+                    " can only create a subgraph for a csr graph, but"
+                    " casting of argument failed");
+    }
+    // Enable all nodes and edges
+    return make_shared<SubGraph>(baseGraph);
+}
+
+} // end namespace csr
+} // end namespace graph_analysis
@@ -0,0 +1,269 @@
+#ifndef GRAPH_ANALYSIS_CSR_DIRECTED_GRAPH_HPP
+#define GRAPH_ANALYSIS_CSR_DIRECTED_GRAPH_HPP
+
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include "../BaseGraph.hpp"
+#include "../Span.hpp"
+#include "NodeIterator.hpp"
+#include "EdgeIterator.hpp"
+
+namespace graph_analysis {
+namespace csr {
+
+/**
+ * \class DirectedGraph
+ * \brief Immutable directed graph in compressed sparse row (CSR) format
+ * \details
+ * The graph is built in a single pass from any other BaseGraph, see
+ * BaseGraph::freeze. Vertices are numbered densely 0..order-1 in the
+ * iteration order of the source graph (or in an explicitly given order),
+ * edges are numbered 0..size-1 sorted by their source vertex, so that the out
+ * edges of vertex v are the edge ids in [getOutOffsets()[v],
+ * getOutOffsets()[v+1]).
+ *
+ * The adjacency is stored in contiguous arrays:
+ \verbatim
+   out offsets  (order + 1): start of the out edges of each vertex
+   out targets  (size):      target vertex id per edge id
+   in offsets   (order + 1): start of the in edges of each vertex
+   in sources   (size):      source vertex id of each in edge
+   in edges     (size):      edge id of each in edge
+ \endverbatim
+ * which can be accessed via the span API to implement algorithms that scan
+ * the adjacency without virtual calls or reference counting.
+ *
+ * All operations that modify the graph throw a std::runtime_error
+ *
+ * A detached graph (as created by BaseGraph::snapshot) does not associate
+ * the vertices and edges with itself, but resolves their ids via an
+ * internal index, so that it can be used concurrently to modifications of
+ * the source graph
+ */
+class DirectedGraph : public BaseGraph
+{
+public:
+    typedef shared_ptr<DirectedGraph> Ptr;
+
+    friend class NodeIterator<DirectedGraph>;
+    friend class EdgeIterator<DirectedGraph>;
+    friend class OutEdgeIterator<DirectedGraph>;
+    friend class InEdgeIterator<DirectedGraph>;
+
+    /**
+     * \brief Copy of the structure of a graph, i.e. its vertices and edges
+     * along with the endpoints of each edge
+     * \details Taking the structure requires only a single pass over the
+     * graph, while the csr arrays and the id index are built from it
+     * afterwards, so that the source graph is accessed only briefly (see
+     * BaseGraph::snapshot)
+     */
+    struct Structure
+    {
+        /**
+         * Copy the structure of the graph, numbering the vertices in the
+         * order of the given list
+         */
+        Structure(const BaseGraph& graph, const std::vector<Vertex::Ptr>& vertexOrder);
+
+        std::string graphName;
+        std::vector<Vertex::Ptr> vertices;
+        std::vector<Edge::Ptr> edges;
+        /// Position of the source and target vertex of each edge in vertices
+        std::vector<GraphElementId> sources;
+        std::vector<GraphElementId> targets;
+    };
+
+    /**
+     * \brief Create an empty graph
+     */
+    DirectedGraph();
+
+    /**
+     * \brief Create the csr representation of the given graph
+     * \param detached if true, vertices and edges will not be associated
+     * with this graph
+     */
+    explicit DirectedGraph(const BaseGraph& graph, bool detached = false);
+
+    /**
+     * \brief Create the csr representation of the given graph, where the
+     * vertices are numbered in the given order
+     * \details Use a locality improving order (see algorithms::VertexOrdering)
+     * to place vertices which are traversed together close to each other
+     * \param vertexOrder all vertices of the graph, each listed exactly once
+     * \param detached if true, vertices and edges will not be associated
+     * with this graph
+     * \throw std::invalid_argument if vertexOrder is not a permutation of the
+     * vertices of the graph
+     */
+    DirectedGraph(const BaseGraph& graph, const std::vector<Vertex::Ptr>& vertexOrder, bool detached = false);
+
+    /**
+     * \brief Create the csr representation from a copy of the structure of
+     * a graph
+     * \param detached if true, vertices and edges will not be associated
+     * with this graph
+     */
+    explicit DirectedGraph(const Structure& structure, bool detached = false);
+
+    DirectedGraph(const DirectedGraph& other);
+
+    /**
+     * The destructor disassociates all vertices and edges from this graph,
+     * unless the graph is detached
+     */
+    ~DirectedGraph();
+
+    BaseGraph::Ptr copy() const;
+
+    BaseGraph::Ptr newInstance() const;
+
+    /**
+     * Test if this graph does not associate its vertices and edges
+     */
+    bool isDetached() const { return mDetached; }
+
+    GraphElementId getVertexId(const Vertex::Ptr& vertex) const;
+    GraphElementId getEdgeId(const Edge::Ptr& edge) const;
+
+    Vertex::Ptr getVertex(GraphElementId id) const;
+    Edge::Ptr getEdge(GraphElementId id) const;
+
+    /**
+     * Get the number of vertices in O(1)
+     */
+    uint64_t getVertexCount() const { return mVertices.size(); }
+
+    /**
+     * Get the number of edges in O(1)
+     */
+    uint64_t getEdgeCount() const { return mEdges.size(); }
+
+    GraphElementId getVertexIdUpperBound() const { return mVertices.size(); }
+    GraphElementId getEdgeIdUpperBound() const { return mEdges.size(); }
+
+    std::vector<Vertex::Ptr> getAllVertices() const { return mVertices; }
+    std::vector<Edge::Ptr> getAllEdges() const { return mEdges; }
+
+    /**
+     * Get the vertex iterator for this implementation
+     */
+    VertexIterator::Ptr getVertexIterator() const;
+
+    /**
+     * Get the edge iterator for this implementation
+     */
+    graph_analysis::EdgeIterator::Ptr getEdgeIterator() const;
+
+    graph_analysis::EdgeIterator::Ptr getEdgeIterator(const Vertex::Ptr& vertex) const;
+
+    graph_analysis::EdgeIterator::Ptr getOutEdgeIterator(const Vertex::Ptr& vertex) const;
+
+    graph_analysis::EdgeIterator::Ptr getInEdgeIterator(const Vertex::Ptr& vertex) const;
+
+    /**
+     * Get the id of the source vertex of the edge with the given id
+     */
+    GraphElementId getSourceVertexId(GraphElementId edgeId) const { return mEdgeSources[edgeId]; }
+
+    /**
+     * Get the id of the target vertex of the edge with the given id
+     */
+    GraphElementId getTargetVertexId(GraphElementId edgeId) const { return mOutTargets[edgeId]; }
+
+    /**
+     * Get the out offsets, i.e. order + 1 entries
+     */
+    Span<GraphElementId> getOutOffsets() const { return Span<GraphElementId>(mOutOffsets.data(), mOutOffsets.size()); }
+
+    /**
+     * Get the target vertex id for all edges (indexed by edge id)
+     */
+    Span<GraphElementId> getOutTargets() const { return Span<GraphElementId>(mOutTargets.data(), mOutTargets.size()); }
+
+    /**
+     * Get the in offsets, i.e. order + 1 entries
+     */
+    Span<GraphElementId> getInOffsets() const { return Span<GraphElementId>(mInOffsets.data(), mInOffsets.size()); }
+
+    /**
+     * Get the source vertex ids of all in edges (indexed by in offsets)
+     */
+    Span<GraphElementId> getInSources() const { return Span<GraphElementId>(mInSources.data(), mInSources.size()); }
+
+    /**
+     * Get the edge ids of all in edges (indexed by in offsets)
+     */
+    Span<GraphElementId> getInEdgeIds() const { return Span<GraphElementId>(mInEdges.data(), mInEdges.size()); }
+
+    /**
+     * Get the ids of all target vertices of the out edges of a vertex
+     * The i-th entry belongs to edge id getOutOffsets()[vertexId] + i
+     */
+    Span<GraphElementId> getOutNeighbours(GraphElementId vertexId) const;
+
+    /**
+     * Get the ids of all source vertices of the in edges of a vertex
+     */
+    Span<GraphElementId> getInNeighbours(GraphElementId vertexId) const;
+
+    /**
+     * Get the edge ids of all in edges of a vertex
+     */
+    Span<GraphElementId> getInEdgeIds(GraphElementId vertexId) const;
+
+protected:
+    /**
+     * \throw std::runtime_error since the graph is read-only
+     */
+    virtual GraphElementId addVertexInternal(const Vertex::Ptr& vertex);
+
+    /**
+     * \throw std::runtime_error since the graph is read-only
+     */
+    virtual void removeVertexInternal(const Vertex::Ptr& vertex);
+
+    /**
+     * \throw std::runtime_error since the graph is read-only
+     */
+    virtual GraphElementId addEdgeInternal(const Edge::Ptr& edge, GraphElementId sourceVertexId, GraphElementId targetVertexId);
+
+    /**
+     * \throw std::runtime_error since the graph is read-only
+     */
+    virtual void removeEdgeInternal(const Edge::Ptr& edge);
+
+    virtual SubGraph::Ptr createSubGraph(const BaseGraph::Ptr& baseGraph) const;
+
+private:
+    /**
+     * Build the arrays from the structure of a graph
+     */
+    void build(const Structure& structure);
+
+    /**
+     * Assign the id to a vertex or edge (depending on the detached mode)
+     */
+    void assignId(const Vertex::Ptr& vertex, GraphElementId id);
+    void assignId(const Edge::Ptr& edge, GraphElementId id);
+
+    bool mDetached;
+    boost::unordered_map<const Vertex*, GraphElementId> mVertexIndex;
+    boost::unordered_map<const Edge*, GraphElementId> mEdgeIndex;
+
+    std::vector<Vertex::Ptr> mVertices;
+    std::vector<Edge::Ptr> mEdges;
+
+    std::vector<GraphElementId> mOutOffsets;
+    std::vector<GraphElementId> mOutTargets;
+    std::vector<GraphElementId> mEdgeSources;
+
+    std::vector<GraphElementId> mInOffsets;
+    std::vector<GraphElementId> mInSources;
+    std::vector<GraphElementId> mInEdges;
+};
+
+} // end namespace csr
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_CSR_DIRECTED_GRAPH_HPP
@@ -0,0 +1,178 @@
+#ifndef GRAPH_ANALYSIS_CSR_EDGE_ITERATOR_HPP
+#define GRAPH_ANALYSIS_CSR_EDGE_ITERATOR_HPP
+
+#include "../EdgeIterator.hpp"
+
+namespace graph_analysis {
+namespace csr {
+
+/**
+ * Iterate over the id-indexed edge array of a csr graph
+ */
+template<typename T>
+class EdgeIterator : public graph_analysis::EdgeIterator
+{
+public:
+    EdgeIterator(const T& graph)
+        : mGraph(graph)
+        , mCurrentIndex(0)
+    {}
+
+    bool next()
+    {
+        while( mCurrentIndex < mGraph.mEdges.size() )
+        {
+            const Edge::Ptr& edge = mGraph.mEdges[mCurrentIndex];
+            ++mCurrentIndex;
+            if(skip(edge))
+            {
+                continue;
+            }
+            setNext(edge);
+            return true;
+        }
+        return false;
+    }
+
+    size_t nextBatch(Edge::Ptr* out, size_t max)
+    {
+        size_t count = 0;
+        for(; count < max && mCurrentIndex < mGraph.mEdges.size(); ++mCurrentIndex)
+        {
+            const Edge::Ptr& edge = mGraph.mEdges[mCurrentIndex];
+            if(skip(edge))
+            {
+                continue;
+            }
+            out[count++] = edge;
+        }
+        if(count > 0)
+        {
+            setNext(out[count - 1]);
+        }
+        return count;
+    }
+
+protected:
+    const T& mGraph;
+    size_t mCurrentIndex;
+};
+
+/**
+ * Iterate over the out edges of a vertex, i.e. the contiguous edge id
+ * range [outOffset(v), outOffset(v+1))
+ */
+template<typename T>
+class OutEdgeIterator : public graph_analysis::EdgeIterator
+{
+public:
+    OutEdgeIterator(const T& graph, const Vertex::Ptr& vertex)
+        : mGraph(graph)
+    {
+        GraphElementId vertexId = mGraph.getVertexId(vertex);
+        mCurrentIndex = mGraph.mOutOffsets[vertexId];
+        mEndIndex = mGraph.mOutOffsets[vertexId + 1];
+    }
+
+    bool next()
+    {
+        while( mCurrentIndex < mEndIndex )
+        {
+            const Edge::Ptr& edge = mGraph.mEdges[mCurrentIndex];
+            ++mCurrentIndex;
+            if(skip(edge))
+            {
+                continue;
+            }
+            setNext(edge);
+            return true;
+        }
+        return false;
+    }
+
+protected:
+    const T& mGraph;
+    GraphElementId mCurrentIndex;
+    GraphElementId mEndIndex;
+};
+
+/**
+ * Iterate over the in edges of a vertex using the edge ids that are
+ * stored in the in-adjacency array
+ */
+template<typename T>
+class InEdgeIterator : public graph_analysis::EdgeIterator
+{
+public:
+    InEdgeIterator(const T& graph, const Vertex::Ptr& vertex)
+        : mGraph(graph)
+    {
+        GraphElementId vertexId = mGraph.getVertexId(vertex);
+        mCurrentIndex = mGraph.mInOffsets[vertexId];
+        mEndIndex = mGraph.mInOffsets[vertexId + 1];
+    }
+
+    bool next()
+    {
+        while( mCurrentIndex < mEndIndex )
+        {
+            const Edge::Ptr& edge = mGraph.mEdges[ mGraph.mInEdges[mCurrentIndex] ];
+            ++mCurrentIndex;
+            if(skip(edge))
+            {
+                continue;
+            }
+            setNext(edge);
+            return true;
+        }
+        return false;
+    }
+
+protected:
+    const T& mGraph;
+    GraphElementId mCurrentIndex;
+    GraphElementId mEndIndex;
+};
+
+template<typename T>
+class InOutEdgeIterator : public graph_analysis::EdgeIterator
+{
+public:
+    InOutEdgeIterator(const T& graph, const Vertex::Ptr& vertex)
+        : mInEdgeIterator(graph, vertex)
+        , mOutEdgeIterator(graph, vertex)
+    {}
+
+    bool next()
+    {
+        while(mInEdgeIterator.next())
+        {
+            if(skip(mInEdgeIterator.current()))
+            {
+                continue;
+            }
+            setNext( mInEdgeIterator.current() );
+            return true;
+        }
+
+        while(mOutEdgeIterator.next())
+        {
+            if(skip(mOutEdgeIterator.current()))
+            {
+                continue;
+            }
+            setNext( mOutEdgeIterator.current() );
+            return true;
+        }
+
+        return false;
+    }
+
+protected:
+    InEdgeIterator<T> mInEdgeIterator;
+    OutEdgeIterator<T> mOutEdgeIterator;
+};
+
+} // end namespace csr
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_CSR_EDGE_ITERATOR_HPP
@@ -0,0 +1,63 @@
+#ifndef GRAPH_ANALYSIS_CSR_NODE_ITERATOR_HPP
+#define GRAPH_ANALYSIS_CSR_NODE_ITERATOR_HPP
+
+#include "../VertexIterator.hpp"
+
+namespace graph_analysis {
+namespace csr {
+
+/**
+ * Iterate over the id-indexed vertex array of a csr graph
+ */
+template<typename T>
+class NodeIterator : public VertexIterator
+{
+public:
+    NodeIterator(const T& graph)
+        : mGraph(graph)
+        , mCurrentIndex(0)
+    {}
+
+    bool next()
+    {
+        while( mCurrentIndex < mGraph.mVertices.size() )
+        {
+            const Vertex::Ptr& vertex = mGraph.mVertices[mCurrentIndex];
+            ++mCurrentIndex;
+            if(skip(vertex))
+            {
+                continue;
+            }
+            setNext(vertex);
+            return true;
+        }
+        return false;
+    }
+
+    size_t nextBatch(Vertex::Ptr* out, size_t max)
+    {
+        size_t count = 0;
+        for(; count < max && mCurrentIndex < mGraph.mVertices.size(); ++mCurrentIndex)
+        {
+            const Vertex::Ptr& vertex = mGraph.mVertices[mCurrentIndex];
+            if(skip(vertex))
+            {
+                continue;
+            }
+            out[count++] = vertex;
+        }
+        if(count > 0)
+        {
+            setNext(out[count - 1]);
+        }
+        return count;
+    }
+
+protected:
+    const T& mGraph;
+    size_t mCurrentIndex;
+};
+
+} // end namespace csr
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_CSR_NODE_ITERATOR_HPP
@@ -5,7 +5,10 @@
 #include "../Edge.hpp"
 #include "CommonFilters.hpp"
 #include <base-logging/Logging.hpp>
+#include <mutex>
 #include <regex>
+#include <typeindex>
+#include <unordered_map>
 
 namespace graph_analysis {
 namespace filters {
@@ -23,12 +26,23 @@ protected:
     Type mType;
     bool mInverted;
 
+    /// Match results of CLASS filters per dynamic type of the element, since
+    /// the class name is constant for a type
+    struct ClassMatches
+    {
+        std::mutex mutex;
+        std::unordered_map<std::type_index, bool> matches;
+    };
+    /// Shared between copies, since they use the same regex
+    shared_ptr<ClassMatches> mpClassMatches;
+
 public:
     RegexFilter(const std::string& regex, Type type, bool invert)
         : mRegexStr(regex)
         , mRegex(regex)
         , mType(type)
         , mInverted(invert)
+        , mpClassMatches(new ClassMatches())
     {}
 
     virtual std::string getName() const { return "graph_analysis::filters::RegexFilter: '" + toString() + "'"; }
@@ -54,8 +68,19 @@ public:
                 result = regex_match(element->toString(), mRegex);
                 break;
             case CLASS:
-                result = regex_match(element->getClassName(), mRegex);
+            {
+                std::type_index type = typeid(*element);
+                std::lock_guard<std::mutex> lock(mpClassMatches->mutex);
+                typename std::unordered_map<std::type_index, bool>::const_iterator cit = mpClassMatches->matches.find(type);
+                if(cit == mpClassMatches->matches.end())
+                {
+                    result = regex_match(element->getClassName(), mRegex);
+                    mpClassMatches->matches[type] = result;
+                } else {
+                    result = cit->second;
+                }
                 break;
+            }
             default:
                 throw std::runtime_error("graph_analysis::filters::RegexFilter unknown filter type provided");
         }
@@ -67,6 +92,8 @@ public:
             return result;
         }
     }
+
+    virtual bool isClassFilter() const { return mType == CLASS; }
 };
 
 /**
@@ -150,7 +150,7 @@ void Player::identifyPlaylist()
     mPlayList = playlist;
 }
 
-void Player::discoverVertex(Vertex::Ptr& vertex)
+void Player::discoverVertex(const Vertex::Ptr& vertex)
 {
     mIdentifiedVertices.insert(vertex);
     appendUnique(mPlayList, vertex);
@@ -53,7 +53,7 @@ public:
 
     void identifyPlaylist();
 
-    void discoverVertex(Vertex::Ptr& vertex);
+    void discoverVertex(const Vertex::Ptr& vertex);
 
 private:
     GraphWidget* mpGraphWidget;
@@ -0,0 +1,15 @@
+#include "MappedReader.hpp"
+#include "../mapped/DirectedGraph.hpp"
+
+namespace graph_analysis {
+namespace io {
+
+void MappedReader::read(const std::string& filename, BaseGraph::Ptr graph)
+{
+    mapped::DirectedGraph mappedGraph(filename);
+    graph->addVertices(mappedGraph.getAllVertices());
+    graph->addEdges(mappedGraph.getAllEdges());
+}
+
+} // end namespace io
+} // end namespace graph_analysis
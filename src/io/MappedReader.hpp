@@ -0,0 +1,30 @@
+#ifndef GRAPH_ANALYSIS_IO_MAPPED_READER_HPP
+#define GRAPH_ANALYSIS_IO_MAPPED_READER_HPP
+
+#include <string>
+#include "../GraphIO.hpp"
+
+namespace graph_analysis {
+namespace io {
+
+/**
+ * \file MappedReader.hpp
+ * \class MappedReader
+ * \brief Reads a graph file as written by MappedWriter into a graph
+ * \details This loads all vertices and edges into the given graph, use
+ * mapped::DirectedGraph to open the file without loading it
+ */
+class MappedReader : public Reader
+{
+public:
+    /**
+     * \brief reads the graph from the given file and stores it to the provided graph argument
+     * \param filename provided input filename
+     * \param graph target graph to store the graph
+     */
+    void read(const std::string& filename, BaseGraph::Ptr graph);
+};
+
+} // end namespace io
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_IO_MAPPED_READER_HPP
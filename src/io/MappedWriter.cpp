@@ -0,0 +1,13 @@
+#include "MappedWriter.hpp"
+#include "../mapped/DirectedGraph.hpp"
+
+namespace graph_analysis {
+namespace io {
+
+void MappedWriter::write(const std::string& filename, const BaseGraph::Ptr& graph) const
+{
+    mapped::DirectedGraph::write(filename, *graph);
+}
+
+} // end namespace io
+} // end namespace graph_analysis
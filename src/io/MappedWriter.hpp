@@ -0,0 +1,28 @@
+#ifndef GRAPH_ANALYSIS_IO_MAPPED_WRITER_HPP
+#define GRAPH_ANALYSIS_IO_MAPPED_WRITER_HPP
+
+#include <string>
+#include "../GraphIO.hpp"
+
+namespace graph_analysis {
+namespace io {
+
+/**
+ * \file MappedWriter.hpp
+ * \class MappedWriter
+ * \brief Writes a graph file which can be opened as mapped::DirectedGraph
+ */
+class MappedWriter : public Writer
+{
+public:
+    /**
+     * \brief outputs the given graph to the given file
+     * \param filename requested output filename
+     * \param graph smart pointer to the requested graph to be written
+     */
+    void write(const std::string& filename, const BaseGraph::Ptr& graph) const;
+};
+
+} // end namespace io
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_IO_MAPPED_WRITER_HPP
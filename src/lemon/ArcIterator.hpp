@@ -20,7 +20,7 @@ public:
     {
         while( mArcIt != ::lemon::INVALID )
         {
-            Edge::Ptr edge = mGraph.mEdgeMap[mArcIt];
+            Edge::Ptr edge = mGraph.mpStorage->edgeMap[mArcIt];
             ++mArcIt;
             if(skip(edge))
             {
@@ -32,6 +32,25 @@ public:
         return false;
     }
 
+    size_t nextBatch(Edge::Ptr* out, size_t max)
+    {
+        size_t count = 0;
+        for(; count < max && mArcIt != ::lemon::INVALID; ++mArcIt)
+        {
+            const Edge::Ptr& edge = mGraph.mpStorage->edgeMap[mArcIt];
+            if(skip(edge))
+            {
+                continue;
+            }
+            out[count++] = edge;
+        }
+        if(count > 0)
+        {
+            setNext(out[count - 1]);
+        }
+        return count;
+    }
+
 protected:
     const T& mGraph;
     typename T::graph_t::ArcIt mArcIt;
@@ -51,7 +70,7 @@ public:
     {
         while( mOutArcIt != ::lemon::INVALID )
         {
-            Edge::Ptr edge = mGraph.mEdgeMap[mOutArcIt];
+            Edge::Ptr edge = mGraph.mpStorage->edgeMap[mOutArcIt];
             ++mOutArcIt;
             if(skip(edge))
             {
@@ -83,7 +102,7 @@ public:
     {
         while( mInArcIt != ::lemon::INVALID )
         {
-            Edge::Ptr edge = mGraph.mEdgeMap[mInArcIt];
+            Edge::Ptr edge = mGraph.mpStorage->edgeMap[mInArcIt];
             if(skip(edge))
             {
                 continue;
@@ -7,17 +7,16 @@ namespace graph_analysis {
 namespace lemon {
 
 DirectedGraph::DirectedGraph()
-    : TypedGraph(LEMON_DIRECTED_GRAPH, true)
-    , mEdgeMap(raw())
-    , mVertexMap(raw())
+    : BaseGraph(LEMON_DIRECTED_GRAPH, true)
+    , mpStorage(new Storage())
 {}
 
 DirectedGraph::DirectedGraph(const DirectedGraph& other)
-    : TypedGraph(LEMON_DIRECTED_GRAPH, true)
-    , mEdgeMap(raw())
-    , mVertexMap(raw())
+    : BaseGraph(LEMON_DIRECTED_GRAPH, true)
+    , mpStorage(new Storage())
 {
     *this = other;
+    setEdgeIndexEnabled(other.isEdgeIndexEnabled());
 }
 
 DirectedGraph::~DirectedGraph()
@@ -25,9 +24,9 @@ DirectedGraph::~DirectedGraph()
 
 GraphElementId DirectedGraph::addVertexInternal(const Vertex::Ptr& vertex)
 {
-    graph_t::Node node = mGraph.addNode();
-    int nodeId = mGraph.id(node);
-    mVertexMap[node] = vertex;
+    graph_t::Node node = raw().addNode();
+    int nodeId = raw().id(node);
+    mpStorage->vertexMap[node] = vertex;
 
     vertex->associate(getId(), nodeId);
     return nodeId;
@@ -36,19 +35,19 @@ GraphElementId DirectedGraph::addVertexInternal(const Vertex::Ptr& vertex)
 void DirectedGraph::removeVertexInternal(const Vertex::Ptr& vertex)
 {
     int nodeId = getVertexId( vertex );
-    graph_t::Node node = mGraph.nodeFromId(nodeId);
-    mGraph.erase(node);
+    graph_t::Node node = raw().nodeFromId(nodeId);
+    raw().erase(node);
 }
 
 GraphElementId DirectedGraph::addEdgeInternal(const Edge::Ptr& edge, GraphElementId sourceVertexId, GraphElementId targetVertexId)
 {
-    graph_t::Node sourceNode = mGraph.nodeFromId( sourceVertexId );
-    graph_t::Node targetNode = mGraph.nodeFromId( targetVertexId );
+    graph_t::Node sourceNode = raw().nodeFromId( sourceVertexId );
+    graph_t::Node targetNode = raw().nodeFromId( targetVertexId );
 
-    graph_t::Arc arc = mGraph.addArc(sourceNode, targetNode);
-    int arcId = mGraph.id(arc);
+    graph_t::Arc arc = raw().addArc(sourceNode, targetNode);
+    int arcId = raw().id(arc);
     edge->associate(getId(), arcId);
-    mEdgeMap[arc] = edge;
+    mpStorage->edgeMap[arc] = edge;
 
     return arcId;
 }
@@ -56,52 +55,60 @@ GraphElementId DirectedGraph::addEdgeInternal(const Edge::Ptr& edge, GraphElemen
 void DirectedGraph::removeEdgeInternal(const Edge::Ptr& edge)
 {
     int edgeId = getEdgeId(edge);
-    graph_t::Arc arc = mGraph.arcFromId(edgeId);
-    mGraph.erase(arc);
+    graph_t::Arc arc = raw().arcFromId(edgeId);
+    raw().erase(arc);
+}
+
+void DirectedGraph::reserveInternal(size_t numberOfVertices, size_t numberOfEdges)
+{
+    // ListDigraph reserves the total number of nodes and arcs, including
+    // the ones that have been erased
+    raw().reserveNode(raw().maxNodeId() + 1 + numberOfVertices);
+    raw().reserveArc(raw().maxArcId() + 1 + numberOfEdges);
 }
 
 DirectedGraph::graph_t::Node DirectedGraph::getNode(const Vertex::Ptr& vertex) const
 {
-    return mGraph.nodeFromId(vertex->getId(this->getId()));
+    return raw().nodeFromId(vertex->getId(this->getId()));
 }
 
 DirectedGraph::graph_t::Arc DirectedGraph::getArc(const Edge::Ptr& edge) const
 {
-    return mGraph.arcFromId(edge->getId(this->getId()));
+    return raw().arcFromId(edge->getId(this->getId()));
 }
 
 /// \relates graph_analysis::lemon::DirectedGraph
 Vertex::Ptr DirectedGraph::getVertex(DirectedGraph::graph_t::Node node) const
 {
-    return getVertex( mGraph.id(node) );
+    return getVertex( raw().id(node) );
 }
 
 /// \relates graph_analysis::lemon::DirectedGraph
 Edge::Ptr DirectedGraph::getEdge(DirectedGraph::graph_t::Arc arc) const
 {
-    return getEdge( mGraph.id(arc) );
+    return getEdge( raw().id(arc) );
 }
 
 Vertex::Ptr DirectedGraph::getVertex(GraphElementId id) const
 {
-    return mVertexMap[ mGraph.nodeFromId(id) ];
+    return mpStorage->vertexMap[ raw().nodeFromId(id) ];
 }
 
 Edge::Ptr DirectedGraph::getEdge(GraphElementId id) const
 {
-    return mEdgeMap[ mGraph.arcFromId(id) ];
+    return mpStorage->edgeMap[ raw().arcFromId(id) ];
 }
 
 Vertex::Ptr DirectedGraph::getSourceVertex(const Edge::Ptr& e) const
 {
     GraphElementId edgeId = getEdgeId(e);
-    return mVertexMap[ mGraph.source( mGraph.arcFromId(edgeId)) ];
+    return mpStorage->vertexMap[ raw().source( raw().arcFromId(edgeId)) ];
 }
 
 Vertex::Ptr DirectedGraph::getTargetVertex(const Edge::Ptr& e) const
 {
     GraphElementId edgeId = getEdgeId(e);
-    return mVertexMap[ mGraph.target( mGraph.arcFromId(edgeId)) ];
+    return mpStorage->vertexMap[ raw().target( raw().arcFromId(edgeId)) ];
 }
 
 /**
@@ -110,21 +117,21 @@ Vertex::Ptr DirectedGraph::getTargetVertex(const Edge::Ptr& e) const
  */
 DirectedGraph& DirectedGraph::operator=(const DirectedGraph& other)
 {
-    ::lemon::digraphCopy(other.mGraph, this->mGraph).
-        nodeMap(other.mVertexMap, this->mVertexMap).
-        arcMap(other.mEdgeMap, this->mEdgeMap).
+    ::lemon::digraphCopy(other.raw(), raw()).
+        nodeMap(other.mpStorage->vertexMap, mpStorage->vertexMap).
+        arcMap(other.mpStorage->edgeMap, mpStorage->edgeMap).
         run();
 
-    for( graph_t::NodeIt n(this->mGraph); n != ::lemon::INVALID; ++n)
+    for( graph_t::NodeIt n(raw()); n != ::lemon::INVALID; ++n)
     {
-        Vertex::Ptr vertex = mVertexMap[n];
-        vertex->associate(this->getId(), this->mGraph.id(n));
+        Vertex::Ptr vertex = mpStorage->vertexMap[n];
+        vertex->associate(this->getId(), raw().id(n));
     }
 
-    for( graph_t::ArcIt a(this->mGraph); a != ::lemon::INVALID; ++a)
+    for( graph_t::ArcIt a(raw()); a != ::lemon::INVALID; ++a)
     {
-        Edge::Ptr edge = mEdgeMap[a];
-        edge->associate(this->getId(), this->mGraph.id(a));
+        Edge::Ptr edge = mpStorage->edgeMap[a];
+        edge->associate(this->getId(), raw().id(a));
     }
 
     return *this;
@@ -137,14 +144,14 @@ void DirectedGraph::write(std::ostream& ostream) const
     // will be overloaded ambiguously due to using shared_ptr
     // Use explicit conversion to string map first
 
-    EdgeStringMap edgeStringMap(mGraph);
-    VertexStringMap vertexStringMap(mGraph);
-    EdgeIdMap edgeIdMap(mGraph);
-    VertexIdMap vertexIdMap(mGraph);
+    EdgeStringMap edgeStringMap(raw());
+    VertexStringMap vertexStringMap(raw());
+    EdgeIdMap edgeIdMap(raw());
+    VertexIdMap vertexIdMap(raw());
 
-    for(graph_t::ArcIt a(mGraph); a != ::lemon::INVALID; ++a)
+    for(graph_t::ArcIt a(raw()); a != ::lemon::INVALID; ++a)
     {
-        Edge::Ptr edge = mEdgeMap[a];
+        Edge::Ptr edge = mpStorage->edgeMap[a];
         if(edge)
         {
             edgeStringMap[a] = edge->toString();
@@ -152,9 +159,9 @@ void DirectedGraph::write(std::ostream& ostream) const
         }
     }
 
-    for(graph_t::NodeIt n(mGraph); n != ::lemon::INVALID; ++n)
+    for(graph_t::NodeIt n(raw()); n != ::lemon::INVALID; ++n)
     {
-        Vertex::Ptr vertex = mVertexMap[n];
+        Vertex::Ptr vertex = mpStorage->vertexMap[n];
         if(vertex)
         {
             vertexStringMap[n] = vertex->toString();
@@ -162,7 +169,7 @@ void DirectedGraph::write(std::ostream& ostream) const
         }
     }
 
-    ::lemon::digraphWriter(mGraph, ostream).
+    ::lemon::digraphWriter(raw(), ostream).
         arcMap("edges", edgeStringMap).
         nodeMap("vertices", vertexStringMap).
         arcMap("edgeId", edgeIdMap).
@@ -171,6 +178,80 @@ void DirectedGraph::write(std::ostream& ostream) const
         run();
 }
 
+GraphElementId DirectedGraph::getVertexIdUpperBound() const
+{
+    return raw().maxNodeId() + 1;
+}
+
+GraphElementId DirectedGraph::getEdgeIdUpperBound() const
+{
+    return raw().maxArcId() + 1;
+}
+
+size_t DirectedGraph::getStorageSize() const
+{
+    // ListDigraph links each node with 4 and each arc with 6 integers
+    size_t nodeSize = 4*sizeof(int) + sizeof(Vertex::Ptr);
+    size_t arcSize = 6*sizeof(int) + sizeof(Edge::Ptr);
+    return getVertexIdUpperBound()*nodeSize + getEdgeIdUpperBound()*arcSize;
+}
+
+IdRemapping DirectedGraph::defragmentInternal()
+{
+    IdRemapping remapping(getVertexIdUpperBound(), getEdgeIdUpperBound());
+    const graph_t& graph = raw();
+    const VertexMap& vertexMap = mpStorage->vertexMap;
+    const EdgeMap& edgeMap = mpStorage->edgeMap;
+
+    std::vector<int> nodeIds;
+    std::vector<size_t> nodeIndices(getVertexIdUpperBound());
+    for(graph_t::NodeIt n(graph); n != ::lemon::INVALID; ++n)
+    {
+        nodeIndices[graph.id(n)] = nodeIds.size();
+        nodeIds.push_back(graph.id(n));
+    }
+
+    std::vector<int> arcIds;
+    for(graph_t::ArcIt a(graph); a != ::lemon::INVALID; ++a)
+    {
+        arcIds.push_back(graph.id(a));
+    }
+
+    // The lists and maps of the current storage keep the slots of erased
+    // nodes and arcs, thus a new storage is built and swapped in
+    shared_ptr<Storage> storage(new Storage());
+    storage->graph.reserveNode(nodeIds.size());
+    storage->graph.reserveArc(arcIds.size());
+
+    // ListDigraph prepends new nodes and arcs to its lists, thus add them in
+    // reverse order to keep the iteration order
+    std::vector<graph_t::Node> nodes(nodeIds.size());
+    for(size_t i = nodeIds.size(); i-- > 0;)
+    {
+        const Vertex::Ptr& vertex = vertexMap[graph.nodeFromId(nodeIds[i])];
+        nodes[i] = storage->graph.addNode();
+        storage->vertexMap[nodes[i]] = vertex;
+        int nodeId = storage->graph.id(nodes[i]);
+        vertex->associate(getId(), nodeId);
+        remapping.setVertexId(nodeIds[i], nodeId);
+    }
+
+    for(size_t i = arcIds.size(); i-- > 0;)
+    {
+        graph_t::Arc oldArc = graph.arcFromId(arcIds[i]);
+        const Edge::Ptr& edge = edgeMap[oldArc];
+        graph_t::Arc arc = storage->graph.addArc(nodes[ nodeIndices[graph.id(graph.source(oldArc))] ],
+                nodes[ nodeIndices[graph.id(graph.target(oldArc))] ]);
+        storage->edgeMap[arc] = edge;
+        int arcId = storage->graph.id(arc);
+        edge->associate(getId(), arcId);
+        remapping.setEdgeId(arcIds[i], arcId);
+    }
+
+    mpStorage.swap(storage);
+    return remapping;
+}
+
 VertexIterator::Ptr DirectedGraph::getVertexIterator() const
 {
     NodeIterator<DirectedGraph>* it = new NodeIterator<DirectedGraph>(*this);
@@ -237,7 +318,7 @@ SubGraph::Ptr DirectedGraph::identifyConnectedComponents(const BaseGraph::Ptr& b
             bool isComponentNode = false;
             for(int a = 0; a < componentCount; ++a)
             {
-                if(sourceVertex->getUid() == components[a]->getUid())
+                if(sourceVertex == components[a])
                 {
                     isComponentNode = true;
                     break;
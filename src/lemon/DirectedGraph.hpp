@@ -14,11 +14,16 @@ namespace lemon {
 /**
  * \class DirectedGraph
  * \brief Directed graph implementation based on lemon library
+ * \details The ListDigraph and the vertex and edge map attached to it are
+ * held in a separately allocated storage, which is replaced as a whole by
+ * defragment. A DirectedSubGraph keeps the storage it has been created on,
+ * i.e. subgraphs have to be created again after defragmentation
  */
-class DirectedGraph : public TypedGraph< ::lemon::ListDigraph, graph_analysis::BaseGraph >
+class DirectedGraph : public graph_analysis::BaseGraph
 {
 public:
     typedef shared_ptr<DirectedGraph> Ptr;
+    typedef ::lemon::ListDigraph graph_t;
 
     /**
      * \brief Default constructor of the graph
@@ -56,6 +61,14 @@ public:
     friend class ArcIterator<DirectedGraph>;
     friend class InArcIterator<DirectedGraph>;
     friend class OutArcIterator<DirectedGraph>;
+    friend class DirectedSubGraph;
+
+    /**
+     * Return underlying raw graph instance
+     */
+    graph_t& raw() { return mpStorage->graph; }
+
+    const graph_t& raw() const { return mpStorage->graph; }
 
     /**
      * Translate between wrapper and native formats
@@ -100,6 +113,15 @@ public:
 
     void write(std::ostream& ostream = std::cout) const;
 
+    GraphElementId getVertexIdUpperBound() const;
+    GraphElementId getEdgeIdUpperBound() const;
+
+    /**
+     * Estimate the storage of the node and arc lists including the slots of
+     * erased nodes and arcs, and of the vertex and edge map
+     */
+    size_t getStorageSize() const;
+
     /**
      * Get the vertex iterator for this implementation
      */
@@ -149,16 +171,41 @@ protected:
      */
     virtual void removeEdgeInternal(const Edge::Ptr&);
 
+    /**
+     * Reserve storage for the given number of additional nodes and arcs
+     */
+    virtual void reserveInternal(size_t numberOfVertices, size_t numberOfEdges);
+
+    /**
+     * Rebuild the node and arc lists without the slots of erased nodes and
+     * arcs into a new storage, so that nodes and arcs are stored in
+     * iteration order and the former storage is released
+     */
+    virtual IdRemapping defragmentInternal();
+
     /**
      * Get the subgraph -- by default all vertices and edges of the
      * base graph are available (enabled)
      */
     virtual SubGraph::Ptr createSubGraph(const BaseGraph::Ptr& graph) const;
 
-    // Property maps to store data associated with vertices and edges
-    EdgeMap mEdgeMap;
-    VertexMap mVertexMap;
+    /**
+     * \brief The lemon graph along with the property maps to store the data
+     * associated with vertices and edges
+     */
+    struct Storage
+    {
+        graph_t graph;
+        EdgeMap edgeMap;
+        VertexMap vertexMap;
+
+        Storage()
+            : edgeMap(graph)
+            , vertexMap(graph)
+        {}
+    };
 
+    shared_ptr<Storage> mpStorage;
 };
 
 } // end namespace lemon
@@ -7,6 +7,7 @@ namespace lemon {
 DirectedSubGraph::DirectedSubGraph(const DirectedGraph::Ptr& graph)
     : SubGraphImpl(graph)
     , mpDirectedGraph(graph)
+    , mpStorage(graph->mpStorage)
     , mNodeMap(graph->raw())
     , mArcMap(graph->raw())
 {
@@ -22,6 +22,9 @@ typedef ::lemon::SubDigraph< ::lemon::ListDigraph, ::lemon::ListDigraph::NodeMap
 class DirectedSubGraph : public SubGraphImpl< SubGraphLemon >
 {
     shared_ptr<DirectedGraph> mpDirectedGraph;
+    /// Storage of the graph the maps are attached to, which is kept alive
+    /// if the graph is defragmented meanwhile
+    shared_ptr<const void> mpStorage;
 
 public:
     DirectedSubGraph(const shared_ptr<DirectedGraph>& graph);
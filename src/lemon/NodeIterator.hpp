@@ -20,7 +20,7 @@ public:
     {
         while( mNodeIt != ::lemon::INVALID)
         {
-            Vertex::Ptr vertex = mGraph.mVertexMap[mNodeIt];
+            Vertex::Ptr vertex = mGraph.mpStorage->vertexMap[mNodeIt];
             ++mNodeIt;
             if(skip(vertex))
             {
@@ -32,6 +32,25 @@ public:
         return false;
     }
 
+    size_t nextBatch(Vertex::Ptr* out, size_t max)
+    {
+        size_t count = 0;
+        for(; count < max && mNodeIt != ::lemon::INVALID; ++mNodeIt)
+        {
+            const Vertex::Ptr& vertex = mGraph.mpStorage->vertexMap[mNodeIt];
+            if(skip(vertex))
+            {
+                continue;
+            }
+            out[count++] = vertex;
+        }
+        if(count > 0)
+        {
+            setNext(out[count - 1]);
+        }
+        return count;
+    }
+
 protected:
     const T& mGraph;
     typename T::graph_t::NodeIt mNodeIt;
@@ -0,0 +1,374 @@
+#include "DirectedGraph.hpp"
+#include "../PropertyMap.hpp"
+#include "../VertexTypeManager.hpp"
+#include "../EdgeTypeManager.hpp"
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <base-logging/Logging.hpp>
+
+namespace graph_analysis {
+namespace mapped {
+
+namespace {
+
+const char MAGIC[8] = { 'G', 'A', 'M', 'A', 'P', 'P', 'E', 'D' };
+const uint32_t VERSION = 1;
+/// Sections start at multiples of this alignment
+const uint64_t ALIGNMENT = 8;
+
+enum Section { OUT_OFFSETS, EDGE_OFFSETS, OUT_DATA, IN_OFFSETS, IN_DATA,
+    CLASS_NAME_OFFSETS, CLASS_NAMES,
+    VERTEX_CLASSES, VERTEX_LABEL_OFFSETS, VERTEX_LABELS,
+    EDGE_CLASSES, EDGE_LABEL_OFFSETS, EDGE_LABELS,
+    SECTION_END };
+
+/**
+ * Header at the beginning of a graph file, which locates the sections by
+ * byte offset and size
+ */
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t elementIdSize;
+    uint64_t numberOfVertices;
+    uint64_t numberOfEdges;
+    uint64_t sectionOffsets[SECTION_END];
+    uint64_t sectionSizes[SECTION_END];
+};
+
+/**
+ * Keeps the file mapped as long as a graph refers to it
+ */
+struct MappedFile
+{
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+};
+
+void writeSection(std::ofstream& out, Header& header, Section section, const void* data, uint64_t size)
+{
+    uint64_t offset = out.tellp();
+    uint64_t padding = (ALIGNMENT - offset % ALIGNMENT) % ALIGNMENT;
+    const char zeros[ALIGNMENT] = { 0 };
+    out.write(zeros, padding);
+
+    header.sectionOffsets[section] = offset + padding;
+    header.sectionSizes[section] = size;
+    out.write(static_cast<const char*>(data), size);
+}
+
+template<typename T>
+void writeSection(std::ofstream& out, Header& header, Section section, const Span<T>& span)
+{
+    writeSection(out, header, section, span.data(), span.size()*sizeof(T));
+}
+
+template<typename T>
+void writeSection(std::ofstream& out, Header& header, Section section, const std::vector<T>& values)
+{
+    writeSection(out, header, section, values.data(), values.size()*sizeof(T));
+}
+
+/**
+ * Element table while writing, where class names are stored only once
+ */
+struct ElementTableWriter
+{
+    std::map<std::string, uint32_t>& classIds;
+    std::vector<uint32_t> classes;
+    std::vector<uint64_t> labelOffsets;
+    std::string labels;
+
+    ElementTableWriter(std::map<std::string, uint32_t>& ids)
+        : classIds(ids)
+        , labelOffsets(1, 0)
+    {}
+
+    void append(const GraphElement& element)
+    {
+        std::map<std::string, uint32_t>::const_iterator cit = classIds.insert(std::make_pair(element.getClassName(), classIds.size())).first;
+        classes.push_back(cit->second);
+        labels += element.getLabel();
+        labelOffsets.push_back(labels.size());
+    }
+
+    void write(std::ofstream& out, Header& header, Section classSection, Section labelOffsetSection, Section labelSection) const
+    {
+        writeSection(out, header, classSection, classes);
+        writeSection(out, header, labelOffsetSection, labelOffsets);
+        writeSection(out, header, labelSection, labels.data(), labels.size());
+    }
+};
+
+/**
+ * Get a section of a mapped file with any number of entries
+ */
+template<typename T>
+Span<T> getSection(const Header& header, const uint8_t* data, size_t fileSize, Section section, const std::string& filename)
+{
+    uint64_t offset = header.sectionOffsets[section];
+    uint64_t size = header.sectionSizes[section];
+    if(offset > fileSize || size > fileSize - offset || offset % ALIGNMENT != 0 || size % sizeof(T) != 0)
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph: file '" + filename + "' is corrupt");
+    }
+    return Span<T>(reinterpret_cast<const T*>(data + offset), size/sizeof(T));
+}
+
+/**
+ * Get a section of a mapped file
+ * \param count expected number of entries
+ */
+template<typename T>
+Span<T> getSection(const Header& header, const uint8_t* data, size_t fileSize, Section section, uint64_t count, const std::string& filename)
+{
+    Span<T> span = getSection<T>(header, data, fileSize, section, filename);
+    // Compare the number of entries, since count*sizeof(T) may wrap
+    if(count > fileSize / sizeof(T) || span.size() != count)
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph: file '" + filename + "' is corrupt");
+    }
+    return span;
+}
+
+} // end anonymous namespace
+
+DirectedGraph::DirectedGraph()
+    : compressed::DirectedGraph(BaseGraph::MAPPED_DIRECTED_GRAPH)
+{
+}
+
+DirectedGraph::DirectedGraph(const std::string& filename)
+    : compressed::DirectedGraph(BaseGraph::MAPPED_DIRECTED_GRAPH)
+    , mFilename(filename)
+{
+    shared_ptr<MappedFile> mappedFile(new MappedFile());
+    try {
+        boost::interprocess::file_mapping file(filename.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+        mappedFile->file.swap(file);
+        mappedFile->region.swap(region);
+    } catch(const boost::interprocess::interprocess_exception& e)
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph: failed to map file '" + filename + "': " + e.what());
+    }
+
+    const uint8_t* data = static_cast<const uint8_t*>(mappedFile->region.get_address());
+    size_t fileSize = mappedFile->region.get_size();
+    if(fileSize < sizeof(Header))
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph: file '" + filename + "' is not a graph file");
+    }
+
+    Header header;
+    memcpy(&header, data, sizeof(Header));
+    if(memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+            || header.elementIdSize != sizeof(GraphElementId))
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph: file '" + filename + "' is not a graph file of a supported version");
+    }
+
+    // Only the sizes and the bounds of the offsets are validated, so that
+    // opening does not depend on the size of the graph. The offsets of a
+    // single element and the encoded lists are validated on access
+    uint64_t order = header.numberOfVertices;
+    uint64_t size = header.numberOfEdges;
+    // Each vertex and edge requires at least one offset entry, which also
+    // prevents order + 1 and size + 1 from wrapping
+    if(order >= fileSize || size >= fileSize)
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph: file '" + filename + "' is corrupt");
+    }
+    Adjacency adjacency;
+    adjacency.outOffsets = getSection<uint64_t>(header, data, fileSize, OUT_OFFSETS, order + 1, filename);
+    adjacency.edgeOffsets = getSection<GraphElementId>(header, data, fileSize, EDGE_OFFSETS, order + 1, filename);
+    adjacency.outData = getSection<uint8_t>(header, data, fileSize, OUT_DATA, filename);
+    adjacency.inOffsets = getSection<uint64_t>(header, data, fileSize, IN_OFFSETS, order + 1, filename);
+    adjacency.inData = getSection<uint8_t>(header, data, fileSize, IN_DATA, filename);
+    Span<uint64_t> classNameOffsets = getSection<uint64_t>(header, data, fileSize, CLASS_NAME_OFFSETS, filename);
+    Span<char> classNames = getSection<char>(header, data, fileSize, CLASS_NAMES, filename);
+    mVertexTable.classes = getSection<uint32_t>(header, data, fileSize, VERTEX_CLASSES, order, filename);
+    mVertexTable.labelOffsets = getSection<uint64_t>(header, data, fileSize, VERTEX_LABEL_OFFSETS, order + 1, filename);
+    mVertexTable.labels = getSection<char>(header, data, fileSize, VERTEX_LABELS, filename);
+    mEdgeTable.classes = getSection<uint32_t>(header, data, fileSize, EDGE_CLASSES, size, filename);
+    mEdgeTable.labelOffsets = getSection<uint64_t>(header, data, fileSize, EDGE_LABEL_OFFSETS, size + 1, filename);
+    mEdgeTable.labels = getSection<char>(header, data, fileSize, EDGE_LABELS, filename);
+
+    if(adjacency.edgeOffsets[0] != 0 || adjacency.edgeOffsets[order] != size
+            || adjacency.outOffsets[0] != 0 || adjacency.outOffsets[order] != adjacency.outData.size()
+            || adjacency.inOffsets[0] != 0 || adjacency.inOffsets[order] != adjacency.inData.size()
+            || mVertexTable.labelOffsets[0] != 0 || mVertexTable.labelOffsets[order] != mVertexTable.labels.size()
+            || mEdgeTable.labelOffsets[0] != 0 || mEdgeTable.labelOffsets[size] != mEdgeTable.labels.size()
+            || classNameOffsets.empty() || classNameOffsets[classNameOffsets.size() - 1] != classNames.size())
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph: file '" + filename + "' is corrupt");
+    }
+
+    // The distinct class names are few, so they are decoded upfront
+    for(size_t i = 0; i + 1 < classNameOffsets.size(); ++i)
+    {
+        if(classNameOffsets[i] > classNameOffsets[i + 1])
+        {
+            throw std::runtime_error("graph_analysis::mapped::DirectedGraph: file '" + filename + "' is corrupt");
+        }
+        mClassNames.push_back(std::string(classNames.data() + classNameOffsets[i], classNames.data() + classNameOffsets[i + 1]));
+    }
+
+    setAdjacency(adjacency, mappedFile);
+    LOG_DEBUG_S << "graph_analysis::mapped::DirectedGraph: mapped '" << filename << "' with "
+        << order << " vertices and " << size << " edges";
+}
+
+DirectedGraph::DirectedGraph(const DirectedGraph& other)
+    : compressed::DirectedGraph(other)
+    , mFilename(other.mFilename)
+    , mClassNames(other.mClassNames)
+    , mVertexTable(other.mVertexTable)
+    , mEdgeTable(other.mEdgeTable)
+{
+}
+
+BaseGraph::Ptr DirectedGraph::copy() const
+{
+    return BaseGraph::Ptr(new DirectedGraph(*this));
+}
+
+BaseGraph::Ptr DirectedGraph::newInstance() const
+{
+    return BaseGraph::Ptr(new DirectedGraph());
+}
+
+Vertex::Ptr DirectedGraph::createVertex(GraphElementId vertexId) const
+{
+    if(mVertexTable.classes.empty())
+    {
+        return compressed::DirectedGraph::createVertex(vertexId);
+    }
+    return VertexTypeManager::getInstance()->createVertex(getClassName(mVertexTable.classes[vertexId]), getLabel(mVertexTable, vertexId));
+}
+
+const std::string& DirectedGraph::getClassName(uint32_t classIndex) const
+{
+    if(classIndex >= mClassNames.size())
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph: file '" + mFilename + "' is corrupt");
+    }
+    return mClassNames[classIndex];
+}
+
+std::string DirectedGraph::getLabel(const ElementTable& table, GraphElementId id) const
+{
+    uint64_t begin = table.labelOffsets[id];
+    uint64_t end = table.labelOffsets[id + 1];
+    if(begin > end || end > table.labels.size())
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph: file '" + mFilename + "' is corrupt");
+    }
+    return std::string(table.labels.data() + begin, table.labels.data() + end);
+}
+
+Edge::Ptr DirectedGraph::createEdge(GraphElementId edgeId, const Vertex::Ptr& sourceVertex, const Vertex::Ptr& targetVertex) const
+{
+    if(mEdgeTable.classes.empty())
+    {
+        return compressed::DirectedGraph::createEdge(edgeId, sourceVertex, targetVertex);
+    }
+    return EdgeTypeManager::getInstance()->createEdge(getClassName(mEdgeTable.classes[edgeId]), sourceVertex, targetVertex, getLabel(mEdgeTable, edgeId));
+}
+
+void DirectedGraph::write(const std::string& filename, const BaseGraph& graph)
+{
+    // Number the vertices in iteration order
+    std::map<std::string, uint32_t> classIds;
+    ElementTableWriter vertexTable(classIds);
+    PropertyMap<GraphElementId> positions(0, graph.getVertexIdUpperBound());
+    GraphElementId numberOfVertices = 0;
+    VertexIterator::Ptr vertexIt = graph.getVertexIterator();
+    while(vertexIt->next())
+    {
+        const Vertex::Ptr& vertex = vertexIt->current();
+        positions.set(graph.getVertexId(vertex), numberOfVertices++);
+        vertexTable.append(*vertex);
+    }
+
+    std::vector<Edge::Ptr> edges;
+    std::vector<EdgeIds> edgeVertexIds;
+    graph_analysis::EdgeIterator::Ptr edgeIt = graph.getEdgeIterator();
+    while(edgeIt->next())
+    {
+        const Edge::Ptr& edge = edgeIt->current();
+        edges.push_back(edge);
+        edgeVertexIds.push_back(EdgeIds( positions.get(graph.getVertexId(edge->getSourceVertex())),
+                    positions.get(graph.getVertexId(edge->getTargetVertex())) ));
+    }
+
+    DirectedGraph encoder;
+    std::vector<GraphElementId> edgeIds = encoder.build(numberOfVertices, edgeVertexIds);
+    const Adjacency& adjacency = encoder.getAdjacency();
+
+    // The edge table is ordered by the id of the encoded edges
+    std::vector<const Edge*> edgesById(edges.size());
+    for(size_t i = 0; i < edges.size(); ++i)
+    {
+        edgesById[ edgeIds[i] ] = edges[i].get();
+    }
+    ElementTableWriter edgeTable(classIds);
+    for(size_t e = 0; e < edgesById.size(); ++e)
+    {
+        edgeTable.append(*edgesById[e]);
+    }
+
+    std::vector<std::string> classNames(classIds.size());
+    for(std::map<std::string, uint32_t>::const_iterator cit = classIds.begin(); cit != classIds.end(); ++cit)
+    {
+        classNames[cit->second] = cit->first;
+    }
+    std::vector<uint64_t> classNameOffsets(1, 0);
+    std::string classNameData;
+    for(size_t i = 0; i < classNames.size(); ++i)
+    {
+        classNameData += classNames[i];
+        classNameOffsets.push_back(classNameData.size());
+    }
+
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!out)
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph::write: failed to open file '" + filename + "'");
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.elementIdSize = sizeof(GraphElementId);
+    header.numberOfVertices = numberOfVertices;
+    header.numberOfEdges = edges.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    writeSection(out, header, OUT_OFFSETS, adjacency.outOffsets);
+    writeSection(out, header, EDGE_OFFSETS, adjacency.edgeOffsets);
+    writeSection(out, header, OUT_DATA, adjacency.outData);
+    writeSection(out, header, IN_OFFSETS, adjacency.inOffsets);
+    writeSection(out, header, IN_DATA, adjacency.inData);
+    writeSection(out, header, CLASS_NAME_OFFSETS, classNameOffsets);
+    writeSection(out, header, CLASS_NAMES, classNameData.data(), classNameData.size());
+    vertexTable.write(out, header, VERTEX_CLASSES, VERTEX_LABEL_OFFSETS, VERTEX_LABELS);
+    edgeTable.write(out, header, EDGE_CLASSES, EDGE_LABEL_OFFSETS, EDGE_LABELS);
+
+    // Complete the header with the section locations
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    if(!out)
+    {
+        throw std::runtime_error("graph_analysis::mapped::DirectedGraph::write: failed to write file '" + filename + "'");
+    }
+}
+
+} // end namespace mapped
+} // end namespace graph_analysis
@@ -0,0 +1,119 @@
+#ifndef GRAPH_ANALYSIS_MAPPED_DIRECTED_GRAPH_HPP
+#define GRAPH_ANALYSIS_MAPPED_DIRECTED_GRAPH_HPP
+
+#include <string>
+#include <vector>
+#include "../compressed/DirectedGraph.hpp"
+
+namespace graph_analysis {
+namespace mapped {
+
+/**
+ * \class DirectedGraph
+ * \brief Immutable directed graph, which is stored in a memory-mapped file
+ * \details
+ * The file contains the encoded adjacency of a compressed::DirectedGraph
+ * along with the element tables, i.e. the class and label of every vertex
+ * and edge, where each distinct class name is stored once. Opening a file only maps it into memory, the data is read by
+ * the operating system once it is accessed. Thus graphs which exceed the
+ * physical memory can be traversed, where iterating over all vertices or
+ * edges reads the file sequentially.
+ *
+ * Opening validates the header and the section bounds in constant time. The
+ * offsets, encoded lists and labels of an element are validated when they
+ * are accessed, so that reading a corrupt file throws a std::runtime_error
+ * instead of accessing memory outside of the mapped region.
+ *
+ * Vertices and edges are materialized as for compressed::DirectedGraph, i.e.
+ * they are held only while they are in use, the elements are created via the
+ * VertexTypeManager and EdgeTypeManager from their stored class and label.
+ *
+ * The file can be produced with write, or via io::GraphIO using the
+ * representation::MAPPED format. It uses the byte order of the
+ * writing machine
+ */
+class DirectedGraph : public compressed::DirectedGraph
+{
+public:
+    typedef shared_ptr<DirectedGraph> Ptr;
+
+    /**
+     * \brief Create an empty graph
+     */
+    DirectedGraph();
+
+    /**
+     * \brief Open a graph file
+     * \throw std::runtime_error if the file cannot be mapped or is not a
+     * valid graph file
+     */
+    explicit DirectedGraph(const std::string& filename);
+
+    /**
+     * \brief Create a copy which shares the mapped file
+     */
+    DirectedGraph(const DirectedGraph& other);
+
+    BaseGraph::Ptr copy() const;
+
+    BaseGraph::Ptr newInstance() const;
+
+    /**
+     * Get the name of the mapped file, empty if no file is mapped
+     */
+    const std::string& getFilename() const { return mFilename; }
+
+    /**
+     * \brief Write the given graph to a file which can be opened as mapped
+     * graph
+     * \details Vertices are numbered in the iteration order of the given
+     * graph. Only the class and label of vertices and edges are stored
+     * \throw std::runtime_error if the file cannot be written
+     */
+    static void write(const std::string& filename, const BaseGraph& graph);
+
+protected:
+    /**
+     * Create the vertex from the class and label in the vertex table
+     */
+    Vertex::Ptr createVertex(GraphElementId vertexId) const;
+
+    /**
+     * Create the edge from the class and label in the edge table
+     */
+    Edge::Ptr createEdge(GraphElementId edgeId, const Vertex::Ptr& sourceVertex, const Vertex::Ptr& targetVertex) const;
+
+private:
+    /**
+     * \brief Table of the class and label of the elements
+     */
+    struct ElementTable
+    {
+        /// Index into the class names per element id
+        Span<uint32_t> classes;
+        /// Start of the label per element id in the label data
+        Span<uint64_t> labelOffsets;
+        Span<char> labels;
+    };
+
+    /**
+     * Get the class name with the given index
+     * \throw std::runtime_error if the index is invalid
+     */
+    const std::string& getClassName(uint32_t classIndex) const;
+
+    /**
+     * Get the label of the element with the given id
+     * \throw std::runtime_error if the label offsets are invalid
+     */
+    std::string getLabel(const ElementTable& table, GraphElementId id) const;
+
+    std::string mFilename;
+    std::vector<std::string> mClassNames;
+    ElementTable mVertexTable;
+    ElementTable mEdgeTable;
+};
+
+} // end namespace mapped
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_MAPPED_DIRECTED_GRAPH_HPP
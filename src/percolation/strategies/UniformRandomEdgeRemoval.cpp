@@ -20,7 +20,7 @@ EventList UniformRandomEdgeRemoval::apply(SubGraph::Ptr subgraph)
     EdgeIterator::Ptr edgeIterator = subgraph->getEdgeIterator();
     while(edgeIterator->next())
     {
-        Edge::Ptr edge = edgeIterator->current();
+        const Edge::Ptr& edge = edgeIterator->current();
 
         if(mOccupationProbability > mpRandomNumberGenerator->getUniformPositiveNumber())
         {
@@ -19,7 +19,7 @@ EventList UniformRandomVertexRemoval::apply(SubGraph::Ptr subgraph)
     VertexIterator::Ptr vertexIterator = subgraph->getVertexIterator();
     while(vertexIterator->next())
     {
-        Vertex::Ptr vertex = vertexIterator->current();
+        const Vertex::Ptr& vertex = vertexIterator->current();
 
         if(mOccupationProbability > mpRandomNumberGenerator->getUniformPositiveNumber())
         {
@@ -1,28 +1,41 @@
 #include "DirectedGraph.hpp"
 #include <base-logging/Logging.hpp>
+#include <algorithm>
 
 namespace graph_analysis {
 namespace snap {
 
 DirectedGraph::DirectedGraph()
-    : TypedGraph<SnapDigraph, BaseGraph>(BaseGraph::SNAP_DIRECTED_GRAPH, true)
+    : CopyOnWriteGraph<SnapDigraph, BaseGraph>(BaseGraph::SNAP_DIRECTED_GRAPH, true)
 {
 }
 
+DirectedGraph::DirectedGraph(const DirectedGraph& other)
+    : CopyOnWriteGraph<SnapDigraph, BaseGraph>(BaseGraph::SNAP_DIRECTED_GRAPH, true)
+    , mVertexIds(other.mVertexIds)
+    , mEdgeIds(other.mEdgeIds)
+{
+    shareRaw(other);
+
+    const graph_t& graph = other.raw();
+    for(graph_t::TNodeI nodeIt = graph.BegNI(); nodeIt != graph.EndNI(); nodeIt++)
+    {
+        graph.GetNDat(nodeIt.GetId()).value->associate(getId(), nodeIt.GetId());
+    }
+
+    for(graph_t::TEdgeI edgeIt = graph.BegEI(); edgeIt != graph.EndEI(); edgeIt++)
+    {
+        graph.GetEDat(edgeIt.GetId()).value->associate(getId(), edgeIt.GetId());
+    }
+    setEdgeIndexEnabled(other.isEdgeIndexEnabled());
+}
+
 DirectedGraph::~DirectedGraph()
 {}
 
 BaseGraph::Ptr DirectedGraph::copy() const
 {
-    // TODO: use snap internal copy
-    BaseGraph::Ptr baseGraph(new DirectedGraph());
-
-    graph_analysis::EdgeIterator::Ptr edgeIt = getEdgeIterator();
-    while(edgeIt->next())
-    {
-        baseGraph->addEdge(edgeIt->current());
-    }
-    return baseGraph;
+    return BaseGraph::Ptr(new DirectedGraph(*this));
 }
 
 BaseGraph::Ptr DirectedGraph::newInstance() const
@@ -32,57 +45,172 @@ BaseGraph::Ptr DirectedGraph::newInstance() const
 
 GraphElementId DirectedGraph::addVertexInternal(const Vertex::Ptr& vertex)
 {
-    TInt nodeId = mGraph.AddNode();
+    TInt nodeId = raw().AddNode(mVertexIds.allocate(), Serializable<Vertex::Ptr>(vertex));
     vertex->associate(getId(), nodeId);
-
-    mGraph.SetNDat(nodeId, Serializable<Vertex::Ptr>(vertex));
     return nodeId;
 }
 
 void DirectedGraph::removeVertexInternal(const Vertex::Ptr& vertex)
 {
+    graph_t& graph = raw();
     int nodeId = getVertexId( vertex );
-    mGraph.DelNode(nodeId);
+    graph.DelNode(nodeId);
+    mVertexIds.release(nodeId);
 }
 
 GraphElementId DirectedGraph::addEdgeInternal(const Edge::Ptr& edge, GraphElementId sourceVertexId, GraphElementId targetVertexId)
 {
-    TInt edgeId = mGraph.AddEdge(sourceVertexId,targetVertexId);
+    TInt edgeId = raw().AddEdge(sourceVertexId, targetVertexId, mEdgeIds.allocate(), Serializable<Edge::Ptr>(edge));
     edge->associate(getId(), edgeId);
-
-    mGraph.SetEDat(edgeId, Serializable<Edge::Ptr>(edge));
     return edgeId;
 }
 
 void DirectedGraph::removeEdgeInternal(const Edge::Ptr& edge)
 {
+    graph_t& graph = raw();
     int edgeId = getEdgeId( edge );
-    mGraph.DelEdge(edgeId);
+    graph.DelEdge(edgeId);
+    mEdgeIds.release(edgeId);
+}
+
+void DirectedGraph::reserveInternal(size_t numberOfVertices, size_t numberOfEdges)
+{
+    graph_t& graph = raw();
+    // Node and edge table are generated separately, so that a bulk load of
+    // edges after a bulk load of vertices is reserved as well
+    if(graph.GetNodes() == 0 && numberOfVertices > 0)
+    {
+        graph.Reserve(numberOfVertices, 0);
+    }
+    if(graph.GetEdges() == 0 && numberOfEdges > 0)
+    {
+        graph.Reserve(0, numberOfEdges);
+    }
+}
+
+std::vector<GraphElementId> DirectedGraph::addVerticesInternal(const std::vector<Vertex::Ptr>& vertices)
+{
+    graph_t& graph = raw();
+    std::vector<GraphElementId> vertexIds;
+    vertexIds.reserve(vertices.size());
+
+    std::vector<Vertex::Ptr>::const_iterator cit = vertices.begin();
+    for(; cit != vertices.end(); ++cit)
+    {
+        TInt nodeId = graph.AddNode(mVertexIds.allocate(), Serializable<Vertex::Ptr>(*cit));
+        (*cit)->associate(getId(), nodeId);
+        vertexIds.push_back(nodeId);
+    }
+    return vertexIds;
+}
+
+std::vector<GraphElementId> DirectedGraph::addEdgesInternal(const std::vector<Edge::Ptr>& edges, const std::vector<GraphElementId>& sourceVertexIds, const std::vector<GraphElementId>& targetVertexIds)
+{
+    graph_t& graph = raw();
+    std::vector<GraphElementId> edgeIds;
+    edgeIds.reserve(edges.size());
+
+    for(size_t i = 0; i < edges.size(); ++i)
+    {
+        TInt edgeId = graph.AddEdge(sourceVertexIds[i], targetVertexIds[i], mEdgeIds.allocate(), Serializable<Edge::Ptr>(edges[i]));
+        edges[i]->associate(getId(), edgeId);
+        edgeIds.push_back(edgeId);
+    }
+    return edgeIds;
 }
 
 Vertex::Ptr DirectedGraph::getVertex(GraphElementId id) const
 {
-    return mGraph.GetNDat(id).value;
+    return raw().GetNDat(id).value;
 }
 
 Edge::Ptr DirectedGraph::getEdge(GraphElementId id) const
 {
     // Serializable<Edge::Ptr>.value
-    return mGraph.GetEDat(id).value;
+    return raw().GetEDat(id).value;
 }
 
 Vertex::Ptr DirectedGraph::getSourceVertex(const Edge::Ptr& e) const
 {
-    TInt nodeId = mGraph.GetEI( getEdgeId(e) ).GetSrcNId();
+    TInt nodeId = raw().GetEI( getEdgeId(e) ).GetSrcNId();
     return getVertex(nodeId);
 }
 
 Vertex::Ptr DirectedGraph::getTargetVertex(const Edge::Ptr& e) const
 {
-    TInt nodeId = mGraph.GetEI( getEdgeId(e) ).GetDstNId();
+    TInt nodeId = raw().GetEI( getEdgeId(e) ).GetDstNId();
     return getVertex(nodeId);
 }
 
+GraphElementId DirectedGraph::getVertexIdUpperBound() const
+{
+    return raw().GetMxNId();
+}
+
+GraphElementId DirectedGraph::getEdgeIdUpperBound() const
+{
+    return raw().GetMxEId();
+}
+
+size_t DirectedGraph::getStorageSize() const
+{
+    const graph_t& graph = raw();
+    // A hash table slot stores the key, the hash code and the link to the
+    // next slot along with the node or edge, and each edge is listed as out
+    // edge of its source and in edge of its target
+    size_t slotSize = 3*sizeof(int);
+    return graph.GetMxNId()*(slotSize + sizeof(graph_t::TNode))
+        + graph.GetMxEId()*(slotSize + sizeof(graph_t::TEdge))
+        + graph.GetEdges()*2*sizeof(int);
+}
+
+IdRemapping DirectedGraph::compactInternal()
+{
+    graph_t& current = raw();
+    IdRemapping remapping(current.GetMxNId(), current.GetMxEId());
+
+    // Assign new ids in the order of the old ids
+    std::vector<int> nodeIds;
+    nodeIds.reserve(current.GetNodes());
+    for(graph_t::TNodeI nodeIt = current.BegNI(); nodeIt != current.EndNI(); nodeIt++)
+    {
+        nodeIds.push_back(nodeIt.GetId());
+    }
+    std::sort(nodeIds.begin(), nodeIds.end());
+
+    std::vector<int> edgeIds;
+    edgeIds.reserve(current.GetEdges());
+    for(graph_t::TEdgeI edgeIt = current.BegEI(); edgeIt != current.EndEI(); edgeIt++)
+    {
+        edgeIds.push_back(edgeIt.GetId());
+    }
+    std::sort(edgeIds.begin(), edgeIds.end());
+
+    graph_t graph;
+    graph.Reserve(nodeIds.size(), edgeIds.size());
+    for(size_t i = 0; i < nodeIds.size(); ++i)
+    {
+        const Serializable<Vertex::Ptr>& data = current.GetNDat(nodeIds[i]);
+        graph.AddNode(i, data);
+        data.value->associate(getId(), i);
+        remapping.setVertexId(nodeIds[i], i);
+    }
+
+    for(size_t i = 0; i < edgeIds.size(); ++i)
+    {
+        graph_t::TEdgeI edgeIt = current.GetEI(edgeIds[i]);
+        const Serializable<Edge::Ptr>& data = current.GetEDat(edgeIds[i]);
+        graph.AddEdge(remapping.getVertexId(edgeIt.GetSrcNId()), remapping.getVertexId(edgeIt.GetDstNId()), i, data);
+        data.value->associate(getId(), i);
+        remapping.setEdgeId(edgeIds[i], i);
+    }
+
+    current = graph;
+    mVertexIds.reset(nodeIds.size());
+    mEdgeIds.reset(edgeIds.size());
+    return remapping;
+}
+
 /**
  * Get the vertex iterator for this implementation
  */
@@ -3,7 +3,8 @@
 
 #include "../VertexIterator.hpp"
 #include "../EdgeIterator.hpp"
-#include "../TypedGraph.hpp"
+#include "../CopyOnWriteGraph.hpp"
+#include "../IdPool.hpp"
 
 // FIXME: when not including "sstream" here, the snap header will fail due to
 // some "min"/"max" defines. this looks like a bug in their headers?
@@ -43,7 +44,7 @@ typedef TNodeEdgeNet< Serializable<Vertex::Ptr>, Serializable<Edge::Ptr> > SnapD
  * \brief Directed graph implementation based on SNAP library
  * \see
  */
-class DirectedGraph : public graph_analysis::TypedGraph<SnapDigraph, BaseGraph>
+class DirectedGraph : public graph_analysis::CopyOnWriteGraph<SnapDigraph, BaseGraph>
 {
 public:
     typedef shared_ptr<DirectedGraph> Ptr;
@@ -60,6 +61,12 @@ public:
 
     ~DirectedGraph();
 
+    /**
+     * Create a copy of the graph, which shares the underlying snap graph
+     * with the other graph until either of them is modified, see
+     * CopyOnWriteGraph for the costs
+     * Vertices and edges keep their ids in the copy
+     */
     DirectedGraph(const DirectedGraph& other);
 
     BaseGraph::Ptr copy() const;
@@ -81,6 +88,15 @@ public:
      */
     Vertex::Ptr getTargetVertex(const Edge::Ptr& e) const;
 
+    GraphElementId getVertexIdUpperBound() const;
+    GraphElementId getEdgeIdUpperBound() const;
+
+    /**
+     * Estimate the storage of the node and edge hash tables including the
+     * slots of deleted nodes and edges
+     */
+    size_t getStorageSize() const;
+
     /**
      * Get the vertex iterator for this implementation
      */
@@ -120,7 +136,37 @@ protected:
      */
     virtual void removeEdgeInternal(const Edge::Ptr& edge);
 
+    /**
+     * Reserve storage for the given number of nodes and edges
+     * SNAP regenerates its hash tables on Reserve, thus the reservation
+     * is only applied to an empty node or edge table
+     */
+    virtual void reserveInternal(size_t numberOfVertices, size_t numberOfEdges);
+
+    /**
+     * \brief Add a list of vertices, inserting each node along with its data
+     * \return the ids of the created vertices
+     */
+    virtual std::vector<GraphElementId> addVerticesInternal(const std::vector<Vertex::Ptr>& vertices);
+
+    /**
+     * \brief Add a list of edges, inserting each edge along with its data
+     * \return the ids of the created edges
+     */
+    virtual std::vector<GraphElementId> addEdgesInternal(const std::vector<Edge::Ptr>& edges, const std::vector<GraphElementId>& sourceVertexIds, const std::vector<GraphElementId>& targetVertexIds);
+
+    /**
+     * Renumber nodes and edges to dense ids by rebuilding the SNAP graph
+     */
+    virtual IdRemapping compactInternal();
+
     virtual SubGraph::Ptr createSubGraph(const BaseGraph::Ptr& baseGraph) const;
+
+private:
+    /// Node ids with recycling of the ids of removed nodes
+    IdPool mVertexIds;
+    /// Edge ids with recycling of the ids of removed edges
+    IdPool mEdgeIds;
 };
 
 } // end namespace snap
@@ -31,6 +31,25 @@ public:
         return false;
     }
 
+    size_t nextBatch(Edge::Ptr* out, size_t max)
+    {
+        size_t count = 0;
+        for(; count < max && mEdgeIt != mGraph.raw().EndEI(); mEdgeIt++)
+        {
+            Edge::Ptr edge = mGraph.getEdge(mEdgeIt.GetId());
+            if(skip(edge))
+            {
+                continue;
+            }
+            out[count++] = edge;
+        }
+        if(count > 0)
+        {
+            setNext(out[count - 1]);
+        }
+        return count;
+    }
+
 protected:
     const T& mGraph;
     typename T::graph_t::TEdgeI mEdgeIt;
@@ -31,6 +31,25 @@ public:
         return false;
     }
 
+    size_t nextBatch(Vertex::Ptr* out, size_t max)
+    {
+        size_t count = 0;
+        for(; count < max && mNodeIt != mGraph.raw().EndNI(); mNodeIt++)
+        {
+            Vertex::Ptr vertex = mGraph.getVertex(mNodeIt.GetId());
+            if(skip(vertex))
+            {
+                continue;
+            }
+            out[count++] = vertex;
+        }
+        if(count > 0)
+        {
+            setNext(out[count - 1]);
+        }
+        return count;
+    }
+
 protected:
     const T& mGraph;
     typename T::graph_t::TNodeI mNodeIt;
@@ -0,0 +1,184 @@
+#include "Parallel.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace graph_analysis {
+namespace utils {
+
+namespace {
+
+/**
+ * Worker threads which are started once and process the chunks of all
+ * calls of Parallel::forEachChunk
+ */
+class ThreadPool
+{
+public:
+    typedef std::function<void()> Task;
+
+    explicit ThreadPool(size_t numberOfThreads)
+        : mStopped(false)
+    {
+        for(size_t i = 0; i < numberOfThreads; ++i)
+        {
+            mThreads.push_back( std::thread(&ThreadPool::work, this) );
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopped = true;
+        }
+        mCondition.notify_all();
+        for(std::thread& thread : mThreads)
+        {
+            thread.join();
+        }
+    }
+
+    void post(const Task& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTasks.push_back(task);
+        }
+        mCondition.notify_one();
+    }
+
+    /**
+     * Run a pending task on the calling thread
+     * \return false if no task was pending
+     */
+    bool runPending()
+    {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if(mTasks.empty())
+            {
+                return false;
+            }
+            task = mTasks.front();
+            mTasks.pop_front();
+        }
+        task();
+        return true;
+    }
+
+private:
+    void work()
+    {
+        while(true)
+        {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this]{ return mStopped || !mTasks.empty(); });
+                if(mTasks.empty())
+                {
+                    return;
+                }
+                task = mTasks.front();
+                mTasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<Task> mTasks;
+    std::vector<std::thread> mThreads;
+    bool mStopped;
+};
+
+ThreadPool& getThreadPool()
+{
+    // The calling thread processes a chunk as well
+    static ThreadPool threadPool(Parallel::getNumberOfThreads() - 1);
+    return threadPool;
+}
+
+} // end anonymous namespace
+
+size_t Parallel::getNumberOfThreads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void Parallel::forEachChunk(size_t size, const RangeFunction& function, size_t minChunkSize)
+{
+    if(size == 0)
+    {
+        return;
+    }
+
+    size_t numberOfChunks = std::min(getNumberOfThreads(), (size + minChunkSize - 1)/std::max<size_t>(minChunkSize,1));
+    if(numberOfChunks <= 1)
+    {
+        function(0, size);
+        return;
+    }
+
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t chunkSize = (size + numberOfChunks - 1)/numberOfChunks;
+    size_t pendingChunks = (size - 1)/chunkSize;
+    RangeFunction guardedFunction = [&](size_t begin, size_t end)
+    {
+        try {
+            function(begin, end);
+        } catch(...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    ThreadPool& threadPool = getThreadPool();
+    for(size_t begin = chunkSize; begin < size; begin += chunkSize)
+    {
+        size_t end = std::min(size, begin + chunkSize);
+        threadPool.post([&, begin, end]()
+        {
+            guardedFunction(begin, end);
+            // Notify while holding the lock, since the waiting call returns
+            // as soon as the last chunk has been counted
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--pendingChunks == 0)
+            {
+                finished.notify_all();
+            }
+        });
+    }
+    guardedFunction(0, std::min(size, chunkSize));
+
+    // Help with pending chunks, which also allows to call forEachChunk from
+    // within a chunk without waiting for a busy pool
+    while(threadPool.runPending())
+    {
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&]{ return pendingChunks == 0; });
+    }
+
+    if(error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+} // end namespace utils
+} // end namespace graph_analysis
@@ -0,0 +1,41 @@
+#ifndef GRAPH_ANALYSIS_UTILS_PARALLEL_HPP
+#define GRAPH_ANALYSIS_UTILS_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace graph_analysis {
+namespace utils {
+
+class Parallel
+{
+public:
+    /**
+     * Function processing the index range [begin, end)
+     */
+    typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+
+    /**
+     * Get the number of threads used for parallel processing, i.e. the
+     * number of hardware threads
+     */
+    static size_t getNumberOfThreads();
+
+    /**
+     * \brief Split the index range [0, size) into contiguous chunks and
+     * process them concurrently
+     * \details The calling thread processes one of the chunks, the others
+     * are processed by a pool of getNumberOfThreads() - 1 worker threads,
+     * which is started by the first call and shared by all calls. Chunks
+     * are not smaller than minChunkSize, so that small ranges are processed
+     * by the calling thread only. While waiting, the calling thread
+     * processes pending chunks, so forEachChunk can be called from within a
+     * chunk. The first exception thrown by any chunk is rethrown after all
+     * chunks have been processed
+     */
+    static void forEachChunk(size_t size, const RangeFunction& function, size_t minChunkSize = 1024);
+};
+
+} // end namespace utils
+} // end namespace graph_analysis
+#endif // GRAPH_ANALYSIS_UTILS_PARALLEL_HPP
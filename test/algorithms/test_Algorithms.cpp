@@ -1,5 +1,8 @@
 #include <boost/test/unit_test.hpp>
 #include <graph_analysis/BaseGraph.hpp>
+#include <graph_analysis/WeightedEdge.hpp>
+#include <graph_analysis/algorithms/VertexOrdering.hpp>
+#include <limits>
 
 using namespace graph_analysis;
 
@@ -24,6 +27,163 @@ BOOST_AUTO_TEST_CASE(connected)
 
 }
 
+BOOST_AUTO_TEST_CASE(boost_native)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance(BaseGraph::BOOST_DIRECTED_GRAPH);
+
+    std::vector<Vertex::Ptr> vertices;
+    for(int i = 0; i < 6; ++i)
+    {
+        vertices.push_back(Vertex::Ptr(new Vertex()));
+    }
+    graph->addVertices(vertices);
+
+    // two cycles 0 -> 1 -> 2 -> 0 and 3 -> 4 -> 3 connected by 2 -> 3
+    WeightedEdge::Ptr e01(new WeightedEdge(vertices[0], vertices[1], 1.0));
+    WeightedEdge::Ptr e12(new WeightedEdge(vertices[1], vertices[2], 2.0));
+    WeightedEdge::Ptr e20(new WeightedEdge(vertices[2], vertices[0], 1.0));
+    WeightedEdge::Ptr e02(new WeightedEdge(vertices[0], vertices[2], 5.0));
+    WeightedEdge::Ptr e23(new WeightedEdge(vertices[2], vertices[3], 1.0));
+    WeightedEdge::Ptr e34(new WeightedEdge(vertices[3], vertices[4], 1.0));
+    WeightedEdge::Ptr e43(new WeightedEdge(vertices[4], vertices[3], 1.0));
+    graph->addEdge(e01);
+    graph->addEdge(e12);
+    graph->addEdge(e20);
+    graph->addEdge(e02);
+    graph->addEdge(e23);
+    graph->addEdge(e34);
+    graph->addEdge(e43);
+
+    Algorithms::EdgeWeightFunction weight = [](const Edge::Ptr& edge)
+    {
+        return dynamic_pointer_cast<WeightedEdge>(edge)->getWeight();
+    };
+
+    // remove an edge from within the edge_index range
+    graph->removeEdge(e01);
+    std::vector<double> distances = graph->computeShortestPathDistances(vertices[0], weight);
+    BOOST_REQUIRE_EQUAL(distances[ graph->getVertexId(vertices[0]) ], 0.0);
+    BOOST_REQUIRE_EQUAL(distances[ graph->getVertexId(vertices[2]) ], 5.0);
+    BOOST_REQUIRE_EQUAL(distances[ graph->getVertexId(vertices[4]) ], 7.0);
+    BOOST_REQUIRE_EQUAL(distances[ graph->getVertexId(vertices[1]) ], std::numeric_limits<double>::infinity());
+
+    graph->addEdge(e01);
+    distances = graph->computeShortestPathDistances(vertices[0], weight);
+    BOOST_REQUIRE_EQUAL(distances[ graph->getVertexId(vertices[2]) ], 3.0);
+
+    std::vector< std::vector<Vertex::Ptr> > components = graph->identifyStronglyConnectedComponents();
+    BOOST_REQUIRE_EQUAL(components.size(), 3);
+    for(size_t i = 0; i < components.size(); ++i)
+    {
+        BOOST_REQUIRE(components[i].size() == 1 || components[i].size() == 2 || components[i].size() == 3);
+    }
+
+    BOOST_REQUIRE_THROW(graph->topologicalSort(), std::runtime_error);
+
+    // renumbering after removing a vertex
+    graph->removeVertex(vertices[1]);
+    graph->removeEdge(e20);
+    graph->removeEdge(e43);
+    std::vector<Vertex::Ptr> order = graph->topologicalSort();
+    BOOST_REQUIRE_EQUAL(order.size(), 5);
+    std::vector<Vertex::Ptr>::const_iterator first = std::find(order.begin(), order.end(), vertices[0]);
+    std::vector<Vertex::Ptr>::const_iterator last = std::find(order.begin(), order.end(), vertices[4]);
+    BOOST_REQUIRE(first < std::find(order.begin(), order.end(), vertices[2]));
+    BOOST_REQUIRE(std::find(order.begin(), order.end(), vertices[3]) < last);
+
+    distances = graph->computeShortestPathDistances(vertices[0], weight);
+    BOOST_REQUIRE_EQUAL(distances[ graph->getVertexId(vertices[4]) ], 7.0);
+
+    WeightedEdge::Ptr negative(new WeightedEdge(vertices[4], vertices[5], -1.0));
+    graph->addEdge(negative);
+    BOOST_REQUIRE_THROW(graph->computeShortestPathDistances(vertices[0], weight), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(vertex_ordering)
+{
+    using namespace graph_analysis::algorithms;
+
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        // path 0 - 1 - 2 - 3 - 4 - 5 inserted in scrambled order
+        std::vector<Vertex::Ptr> path;
+        for(int v = 0; v < 6; ++v)
+        {
+            path.push_back(Vertex::Ptr(new Vertex()));
+        }
+        int insertOrder[6] = { 3, 0, 5, 1, 4, 2 };
+        for(int v = 0; v < 6; ++v)
+        {
+            graph->addVertex(path[ insertOrder[v] ]);
+        }
+        for(int v = 0; v < 5; ++v)
+        {
+            graph->addEdge(Edge::Ptr(new Edge(path[v + 1], path[v])));
+        }
+
+        VertexOrdering::Strategy strategies[3] = { VertexOrdering::DEGREE_DESCENDING, VertexOrdering::REVERSE_CUTHILL_MCKEE, VertexOrdering::BREADTH_FIRST };
+        for(int s = 0; s < 3; ++s)
+        {
+            std::vector<Vertex::Ptr> order = VertexOrdering::compute(graph, strategies[s]);
+            BOOST_REQUIRE_EQUAL(order.size(), 6);
+            for(int v = 0; v < 6; ++v)
+            {
+                BOOST_REQUIRE(std::count(order.begin(), order.end(), path[v]) == 1);
+            }
+        }
+
+        // Reverse Cuthill-McKee numbers the path consecutively
+        BaseGraph::Ptr frozen = VertexOrdering::freeze(graph, VertexOrdering::REVERSE_CUTHILL_MCKEE);
+        BOOST_REQUIRE(frozen->getImplementationType() == BaseGraph::CSR_DIRECTED_GRAPH);
+        BOOST_REQUIRE_EQUAL(frozen->getEdgeCount(), 5);
+        for(int v = 0; v < 5; ++v)
+        {
+            GraphElementId id = frozen->getVertexId(path[v]);
+            GraphElementId nextId = frozen->getVertexId(path[v + 1]);
+            BOOST_REQUIRE_MESSAGE(std::max(id, nextId) - std::min(id, nextId) == 1, "Path vertices " << v << " and " << v + 1 << " have ids " << id << " and " << nextId);
+            BOOST_REQUIRE_EQUAL(frozen->getEdges(path[v + 1], path[v]).size(), 1);
+        }
+
+        // Add a hub which is linked to several path vertices
+        Vertex::Ptr hub(new Vertex());
+        graph->addVertex(hub);
+        graph->addEdge(Edge::Ptr(new Edge(hub, path[0])));
+        graph->addEdge(Edge::Ptr(new Edge(path[5], hub)));
+        graph->addEdge(Edge::Ptr(new Edge(hub, path[2])));
+        graph->addEdge(Edge::Ptr(new Edge(path[4], hub)));
+
+        std::vector<Vertex::Ptr> order = VertexOrdering::compute(graph, VertexOrdering::DEGREE_DESCENDING);
+        BOOST_REQUIRE(order[0] == hub);
+        BOOST_REQUIRE(order[1] == path[2] || order[1] == path[4]);
+        BOOST_REQUIRE(order[2] == path[2] || order[2] == path[4]);
+
+        order = VertexOrdering::compute(graph, VertexOrdering::BREADTH_FIRST);
+        BOOST_REQUIRE(order[0] == hub);
+        std::vector<Vertex::Ptr> firstLevel(order.begin() + 1, order.begin() + 5);
+        BOOST_REQUIRE(std::count(firstLevel.begin(), firstLevel.end(), path[0]) == 1);
+        BOOST_REQUIRE(std::count(firstLevel.begin(), firstLevel.end(), path[2]) == 1);
+        BOOST_REQUIRE(std::count(firstLevel.begin(), firstLevel.end(), path[4]) == 1);
+        BOOST_REQUIRE(std::count(firstLevel.begin(), firstLevel.end(), path[5]) == 1);
+
+        frozen = graph->freeze(order);
+        for(size_t v = 0; v < order.size(); ++v)
+        {
+            BOOST_REQUIRE_EQUAL(frozen->getVertexId(order[v]), v);
+        }
+
+        order.pop_back();
+        BOOST_REQUIRE_THROW(graph->freeze(order), std::invalid_argument);
+        order.push_back(hub);
+        BOOST_REQUIRE_THROW(graph->freeze(order), std::invalid_argument);
+        // A vertex which does not belong to the graph
+        order.back() = Vertex::Ptr(new Vertex());
+        BOOST_REQUIRE_THROW(graph->freeze(order), std::invalid_argument);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
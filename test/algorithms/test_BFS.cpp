@@ -1,6 +1,12 @@
 #include <boost/test/unit_test.hpp>
 #include <graph_analysis/WeightedEdge.hpp>
 #include <graph_analysis/algorithms/BFS.hpp>
+#include <graph_analysis/algorithms/BidirectionalBFS.hpp>
+#include <graph_analysis/algorithms/MultiSourceBFS.hpp>
+#include <graph_analysis/algorithms/ParallelBFS.hpp>
+#include <graph_analysis/algorithms/StaticBFS.hpp>
+#include <queue>
+#include <map>
 
 using namespace graph_analysis;
 using namespace graph_analysis::algorithms;
@@ -51,6 +57,110 @@ BOOST_AUTO_TEST_CASE(simple_bfs_1)
 
 }
 
+BOOST_AUTO_TEST_CASE(visitor_status)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance();
+    Vertex::Ptr v0(new Vertex("0"));
+    Vertex::Ptr v1(new Vertex("1"));
+    Edge::Ptr e0(new Edge(v0, v1));
+    graph->addEdge(e0);
+
+    // The status can be used without binding the visitor to a graph
+    BFSVisitor::Ptr visitor(new BFSVisitor());
+    visitor->setStatus(v1, Visitor::VISITED);
+    visitor->setStatus(e0, Visitor::REGISTERED);
+    BOOST_REQUIRE_EQUAL(visitor->getStatus(v0), Visitor::UNKNOWN);
+    BOOST_REQUIRE_EQUAL(visitor->getStatus(v1), Visitor::VISITED);
+
+    // and is carried over, when the visitor is bound
+    visitor->setGraph(graph);
+    BOOST_REQUIRE_EQUAL(visitor->getStatus(v1), Visitor::VISITED);
+    BOOST_REQUIRE_EQUAL(visitor->getStatus(e0), Visitor::REGISTERED);
+
+    // The visitor does not own the graph it is bound to
+    long useCount = graph.use_count();
+    BFS bfs(graph, visitor);
+    bfs.run(v0);
+    BOOST_REQUIRE_EQUAL(graph.use_count(), useCount + 1);
+}
+
+class DiscoveryVisitor : public BFSVisitor
+{
+public:
+    std::map<Vertex*, int> discoveries;
+    int forwardOrCrossEdges;
+
+    DiscoveryVisitor() : forwardOrCrossEdges(0) {}
+
+    virtual void discoverVertex(const Vertex::Ptr& vertex) { ++discoveries[vertex.get()]; }
+    virtual void forwardOrCrossEdge(const Edge::Ptr& edge) { ++forwardOrCrossEdges; }
+};
+
+BOOST_AUTO_TEST_CASE(visitor_reuse)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        Vertex::Ptr v0(new Vertex("0"));
+        Vertex::Ptr v1(new Vertex("1"));
+        Vertex::Ptr v2(new Vertex("2"));
+        Vertex::Ptr v3(new Vertex("3"));
+        graph->addEdge(Edge::Ptr(new Edge(v0, v1)));
+        graph->addEdge(Edge::Ptr(new Edge(v1, v2)));
+        graph->addEdge(Edge::Ptr(new Edge(v3, v1)));
+
+        // A second run with the same visitor continues from its status, so
+        // that the vertices visited by the first run are not discovered again
+        shared_ptr<DiscoveryVisitor> visitor(new DiscoveryVisitor());
+        BFS bfs(graph, visitor);
+        bfs.run(v0);
+        bfs.run(v3);
+        BOOST_REQUIRE_EQUAL(visitor->discoveries.size(), 2);
+        BOOST_REQUIRE_EQUAL(visitor->discoveries[v1.get()], 1);
+        BOOST_REQUIRE_EQUAL(visitor->discoveries[v2.get()], 1);
+        BOOST_REQUIRE_EQUAL(visitor->forwardOrCrossEdges, 1);
+        BOOST_REQUIRE_EQUAL(visitor->getStatus(v3), Visitor::VISITED);
+    }
+}
+
+class UseCountVisitor : public BFSVisitor
+{
+public:
+    std::map<Vertex*, long> useCounts;
+
+    virtual void discoverVertex(const Vertex::Ptr& vertex) { useCounts[vertex.get()] = vertex.use_count(); }
+};
+
+BOOST_AUTO_TEST_CASE(borrowed_bfs)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+
+        std::vector<Vertex::Ptr> vertices;
+        for(size_t v = 0; v < 10; ++v)
+        {
+            vertices.push_back( Vertex::Ptr(new Vertex()) );
+            if(v > 0)
+            {
+                Edge::Ptr edge(new Edge(vertices[(v-1)/2], vertices[v]));
+                graph->addEdge(edge);
+            }
+        }
+
+        std::map<Vertex*, long> expectedUseCounts;
+        for(size_t v = 1; v < vertices.size(); ++v)
+        {
+            expectedUseCounts[vertices[v].get()] = vertices[v].use_count();
+        }
+
+        shared_ptr<UseCountVisitor> visitor(new UseCountVisitor());
+        BFS bfs(graph, visitor);
+        bfs.run(vertices[0]);
+
+        BOOST_REQUIRE_MESSAGE(visitor->useCounts == expectedUseCounts, "BFS should not copy vertex pointers while traversing graph of type " << i);
+    }
+}
 
 BOOST_AUTO_TEST_CASE(simple_bfs_2)
 {
@@ -143,4 +253,266 @@ BOOST_AUTO_TEST_CASE(simple_bfs_2)
     bfs.run(v0);
 
 }
+
+class DiscoverCountVisitor : public BFSVisitor
+{
+public:
+    DiscoverCountVisitor() : discovered(0), finished(0) {}
+
+    virtual void discoverVertex(const Vertex::Ptr& vertex) { ++discovered; }
+    virtual void finishVertex(const Vertex::Ptr& vertex) { ++finished; }
+
+    size_t discovered;
+    size_t finished;
+};
+
+BOOST_AUTO_TEST_CASE(parallel_bfs)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance(BaseGraph::LEMON_DIRECTED_GRAPH);
+    std::vector<Vertex::Ptr> vertices;
+    for(size_t v = 0; v < 5000; ++v)
+    {
+        vertices.push_back( Vertex::Ptr(new Vertex()) );
+        graph->addVertex(vertices.back());
+    }
+    // Random graph with a few hubs and an unreachable vertex
+    srand(42);
+    for(size_t i = 0; i < 20000; ++i)
+    {
+        size_t source = (i % 10 == 0) ? rand() % 10 : rand() % (vertices.size() - 1);
+        size_t target = rand() % (vertices.size() - 1);
+        graph->addEdge( Edge::Ptr(new Edge(vertices[source], vertices[target])) );
+    }
+
+    // Reference depths of a sequential search
+    std::map<Vertex*, uint32_t> expectedDepths;
+    std::queue<Vertex::Ptr> queue;
+    expectedDepths[vertices[0].get()] = 0;
+    queue.push(vertices[0]);
+    while(!queue.empty())
+    {
+        Vertex::Ptr vertex = queue.front();
+        queue.pop();
+        EdgeIterator::Ptr edgeIt = graph->getOutEdgeIterator(vertex);
+        while(edgeIt->next())
+        {
+            Vertex::Ptr target = edgeIt->current()->getTargetVertex();
+            if(!expectedDepths.count(target.get()))
+            {
+                expectedDepths[target.get()] = expectedDepths[vertex.get()] + 1;
+                queue.push(target);
+            }
+        }
+    }
+
+    // Force top-down only, bottom-up only and the default switching
+    double alphas[] = { 1e-9, 1e9, 15.0 };
+    for(double alpha : alphas)
+    {
+        ParallelBFS bfs(graph);
+        bfs.setDirectionThresholds(alpha, 18.0);
+        bfs.run(vertices[0]);
+
+        if(alpha < 1)
+        {
+            BOOST_REQUIRE_EQUAL(bfs.getBottomUpLevelCount(), 0);
+        } else {
+            BOOST_REQUIRE(bfs.getBottomUpLevelCount() > 0);
+        }
+
+        for(const Vertex::Ptr& vertex : vertices)
+        {
+            GraphElementId id = graph->getVertexId(vertex);
+            uint32_t depth = bfs.getDepths().get(id);
+            GraphElementId parentId = bfs.getParents().get(id);
+            if(!expectedDepths.count(vertex.get()))
+            {
+                BOOST_REQUIRE_EQUAL(depth, ParallelBFS::Unreachable);
+                BOOST_REQUIRE_EQUAL(parentId, ParallelBFS::NoParent);
+                continue;
+            }
+
+            BOOST_REQUIRE_EQUAL(depth, expectedDepths[vertex.get()]);
+            if(vertex == vertices[0])
+            {
+                BOOST_REQUIRE_EQUAL(parentId, id);
+            } else {
+                Vertex::Ptr parent = graph->getVertex(parentId);
+                BOOST_REQUIRE_EQUAL(bfs.getDepths().get(parentId) + 1, depth);
+                BOOST_REQUIRE(!graph->getEdges(parent, vertex).empty());
+            }
+        }
+    }
+
+    // Callbacks are optional
+    shared_ptr<DiscoverCountVisitor> visitor(new DiscoverCountVisitor());
+    ParallelBFS bfs(graph);
+    bfs.setVisitor(visitor);
+    bfs.run(vertices[0]);
+    BOOST_REQUIRE_EQUAL(visitor->discovered, expectedDepths.size() - 1);
+    BOOST_REQUIRE_EQUAL(visitor->finished, expectedDepths.size());
+}
+
+class DiscoverOrderVisitor : public BFSVisitor
+{
+public:
+    std::vector<Vertex::Ptr> order;
+
+    virtual void discoverVertex(const Vertex::Ptr& vertex) { order.push_back(vertex); }
+};
+
+struct StaticDiscoverOrderVisitor : public StaticVisitor
+{
+    std::vector<Vertex::Ptr> order;
+    size_t leafs;
+
+    StaticDiscoverOrderVisitor() : leafs(0) {}
+    void discoverVertex(const Vertex::Ptr& vertex) { order.push_back(vertex); }
+    void leafVertex(const Vertex::Ptr& vertex) { ++leafs; }
+};
+
+BOOST_AUTO_TEST_CASE(static_bfs)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance();
+    std::vector<Vertex::Ptr> vertices;
+    for(size_t v = 0; v < 15; ++v)
+    {
+        vertices.push_back( Vertex::Ptr(new Vertex()) );
+        if(v > 0)
+        {
+            graph->addEdge( Edge::Ptr(new Edge(vertices[(v-1)/2], vertices[v])) );
+        }
+    }
+
+    StaticDiscoverOrderVisitor staticVisitor;
+    StaticBFS<StaticDiscoverOrderVisitor> staticBFS(graph, staticVisitor);
+    staticBFS.run(vertices[0]);
+    BOOST_REQUIRE_EQUAL(staticVisitor.order.size(), vertices.size() - 1);
+    BOOST_REQUIRE_EQUAL(staticVisitor.leafs, 8);
+    for(const Vertex::Ptr& vertex : vertices)
+    {
+        BOOST_REQUIRE_EQUAL(staticBFS.getStatus(vertex), Visitor::VISITED);
+    }
+
+    // The virtual interface is an adapter to the same search
+    shared_ptr<DiscoverOrderVisitor> visitor(new DiscoverOrderVisitor());
+    BFS bfs(graph, visitor);
+    bfs.run(vertices[0]);
+    BOOST_REQUIRE(visitor->order == staticVisitor.order);
+    for(const Vertex::Ptr& vertex : vertices)
+    {
+        BOOST_REQUIRE_EQUAL(visitor->getStatus(vertex), Visitor::VISITED);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(multi_source_bfs)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance(BaseGraph::BOOST_DIRECTED_GRAPH);
+    std::vector<Vertex::Ptr> vertices;
+    for(size_t v = 0; v < 500; ++v)
+    {
+        vertices.push_back( Vertex::Ptr(new Vertex()) );
+        graph->addVertex(vertices.back());
+    }
+    srand(7);
+    for(size_t i = 0; i < 700; ++i)
+    {
+        graph->addEdge( Edge::Ptr(new Edge(vertices[rand() % vertices.size()], vertices[rand() % vertices.size()])) );
+    }
+
+    // More than one batch of sources
+    std::vector<Vertex::Ptr> sources;
+    for(size_t i = 0; i < 100; ++i)
+    {
+        sources.push_back(vertices[(i*7) % vertices.size()]);
+    }
+
+    MultiSourceBFS msbfs(graph);
+    msbfs.run(sources);
+    BOOST_REQUIRE_EQUAL(msbfs.getNumberOfSources(), sources.size());
+    for(size_t s = 0; s < sources.size(); ++s)
+    {
+        ParallelBFS bfs(graph);
+        bfs.run(sources[s]);
+
+        size_t reachable = 0;
+        for(const Vertex::Ptr& vertex : vertices)
+        {
+            uint32_t depth = bfs.getDepths().get(graph->getVertexId(vertex));
+            BOOST_REQUIRE_EQUAL(msbfs.getDepth(s, vertex), depth);
+            BOOST_REQUIRE_EQUAL(msbfs.isReachable(s, vertex), depth != ParallelBFS::Unreachable);
+            if(depth != ParallelBFS::Unreachable)
+            {
+                ++reachable;
+            }
+        }
+        BOOST_REQUIRE_EQUAL(msbfs.getReachableVertices(s).size(), reachable);
+    }
+
+    // Reachability within two hops only
+    msbfs.run(sources, 2, false);
+    BOOST_REQUIRE_THROW(msbfs.getDepth(0, sources[0]), std::runtime_error);
+    BOOST_REQUIRE_THROW(msbfs.isReachable(sources.size(), sources[0]), std::out_of_range);
+    ParallelBFS bfs(graph);
+    bfs.run(sources[0]);
+    for(const Vertex::Ptr& vertex : vertices)
+    {
+        BOOST_REQUIRE_EQUAL(msbfs.isReachable(0, vertex), bfs.getDepths().get(graph->getVertexId(vertex)) <= 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bidirectional_bfs)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        std::vector<Vertex::Ptr> vertices;
+        for(size_t v = 0; v < 300; ++v)
+        {
+            vertices.push_back( Vertex::Ptr(new Vertex()) );
+            graph->addVertex(vertices.back());
+        }
+        srand(3);
+        for(size_t e = 0; e < 450; ++e)
+        {
+            graph->addEdge( Edge::Ptr(new Edge(vertices[rand() % vertices.size()], vertices[rand() % vertices.size()])) );
+        }
+
+        BidirectionalBFS query(graph);
+        for(size_t s = 0; s < 20; ++s)
+        {
+            const Vertex::Ptr& source = vertices[s*11];
+            ParallelBFS bfs(graph);
+            bfs.run(source);
+            for(const Vertex::Ptr& target : vertices)
+            {
+                uint32_t depth = bfs.getDepths().get(graph->getVertexId(target));
+                BOOST_REQUIRE_EQUAL(query.getHopDistance(source, target), depth);
+                if(depth != ParallelBFS::Unreachable && depth > 0)
+                {
+                    BOOST_REQUIRE_EQUAL(query.getHopDistance(source, target, depth), depth);
+                    BOOST_REQUIRE(!query.isReachable(source, target, depth - 1));
+                }
+            }
+        }
+    }
+
+    // Skipped edges are not followed
+    BaseGraph::Ptr graph = BaseGraph::getInstance();
+    Vertex::Ptr a(new Vertex("a"));
+    Vertex::Ptr b(new Vertex("b"));
+    Vertex::Ptr c(new Vertex("c"));
+    graph->addEdge( Edge::Ptr(new Edge(a, b, "skip")) );
+    graph->addEdge( Edge::Ptr(new Edge(a, c)) );
+    graph->addEdge( Edge::Ptr(new Edge(c, b)) );
+
+    struct SkipLabel
+    {
+        bool operator()(const Edge::Ptr& edge) const { return edge->getLabel() == "skip"; }
+    };
+    BOOST_REQUIRE_EQUAL(BidirectionalBFS(graph).getHopDistance(a, b), 1);
+    BOOST_REQUIRE_EQUAL(BidirectionalBFS(graph, SkipLabel()).getHopDistance(a, b), 2);
+    BOOST_REQUIRE(!BidirectionalBFS(graph).isReachable(b, a));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
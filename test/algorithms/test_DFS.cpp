@@ -1,6 +1,8 @@
 #include <boost/test/unit_test.hpp>
 #include <graph_analysis/WeightedEdge.hpp>
 #include <graph_analysis/algorithms/DFS.hpp>
+#include <graph_analysis/algorithms/StaticDFS.hpp>
+#include <map>
 
 using namespace graph_analysis;
 using namespace graph_analysis::algorithms;
@@ -143,4 +145,73 @@ BOOST_AUTO_TEST_CASE(simple_dfs_2)
     dfs.run(v0);
 
 }
+class DFSDiscoveryVisitor : public DFSVisitor
+{
+public:
+    std::map<Vertex*, int> discoveries;
+
+    virtual void discoverVertex(const Vertex::Ptr& vertex) { ++discoveries[vertex.get()]; }
+};
+
+BOOST_AUTO_TEST_CASE(visitor_reuse)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance();
+    Vertex::Ptr v0(new Vertex("0"));
+    Vertex::Ptr v1(new Vertex("1"));
+    Vertex::Ptr v2(new Vertex("2"));
+    Vertex::Ptr v3(new Vertex("3"));
+    graph->addEdge(Edge::Ptr(new Edge(v0, v1)));
+    graph->addEdge(Edge::Ptr(new Edge(v1, v2)));
+    graph->addEdge(Edge::Ptr(new Edge(v3, v1)));
+
+    // A second run with the same visitor does not discover the vertices of
+    // the first run again
+    shared_ptr<DFSDiscoveryVisitor> visitor(new DFSDiscoveryVisitor());
+    DFS dfs(graph, visitor);
+    dfs.run(v0);
+    dfs.run(v3);
+    BOOST_REQUIRE_EQUAL(visitor->discoveries.size(), 2);
+    BOOST_REQUIRE_EQUAL(visitor->discoveries[v1.get()], 1);
+    BOOST_REQUIRE_EQUAL(visitor->discoveries[v2.get()], 1);
+}
+
+class FinishOrderVisitor : public DFSVisitor
+{
+public:
+    std::vector<Vertex::Ptr> order;
+
+    virtual void finishVertex(const Vertex::Ptr& vertex) { order.push_back(vertex); }
+};
+
+struct StaticFinishOrderVisitor : public StaticVisitor
+{
+    std::vector<Vertex::Ptr> order;
+
+    void finishVertex(const Vertex::Ptr& vertex) { order.push_back(vertex); }
+};
+
+BOOST_AUTO_TEST_CASE(static_dfs)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance();
+    std::vector<Vertex::Ptr> vertices;
+    for(size_t v = 0; v < 15; ++v)
+    {
+        vertices.push_back( Vertex::Ptr(new Vertex()) );
+        if(v > 0)
+        {
+            graph->addEdge( Edge::Ptr(new Edge(vertices[(v-1)/2], vertices[v])) );
+        }
+    }
+
+    StaticFinishOrderVisitor staticVisitor;
+    StaticDFS<StaticFinishOrderVisitor> staticDFS(graph, staticVisitor);
+    staticDFS.run(vertices[0]);
+    BOOST_REQUIRE_EQUAL(staticVisitor.order.size(), vertices.size());
+
+    shared_ptr<FinishOrderVisitor> visitor(new FinishOrderVisitor());
+    DFS dfs(graph, visitor);
+    dfs.run(vertices[0]);
+    BOOST_REQUIRE(visitor->order == staticVisitor.order);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+#include <boost/test/unit_test.hpp>
+#include <graph_analysis/WeightedEdge.hpp>
+#include <graph_analysis/algorithms/FloydWarshall.hpp>
+#include <graph_analysis/algorithms/ShortestPaths.hpp>
+#include <graph_analysis/lemon/Graph.hpp>
+#include <limits>
+#include <set>
+
+using namespace graph_analysis;
+using namespace graph_analysis::algorithms;
+
+namespace {
+
+double getEdgeWeight(Edge::Ptr edge)
+{
+    WeightedEdge::Ptr weightedEdge = dynamic_pointer_cast<WeightedEdge>(edge);
+    return weightedEdge->getWeight();
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(algorithms_shortest_paths)
+
+BOOST_AUTO_TEST_CASE(single_source_shortest_paths)
+{
+    graph_analysis::BaseGraph::Ptr graph(new graph_analysis::lemon::DirectedGraph());
+    std::vector<Vertex::Ptr> vertices;
+    for(size_t v = 0; v < 60; ++v)
+    {
+        vertices.push_back( Vertex::Ptr(new Vertex()) );
+        graph->addVertex(vertices.back());
+    }
+
+    // Integral weights including zero, without parallel edges
+    srand(11);
+    std::set< std::pair<size_t, size_t> > pairs;
+    while(pairs.size() < 200)
+    {
+        std::pair<size_t, size_t> pair(rand() % vertices.size(), rand() % vertices.size());
+        if(pair.first == pair.second || !pairs.insert(pair).second)
+        {
+            continue;
+        }
+        WeightedEdge::Ptr edge(new WeightedEdge(rand() % 10));
+        edge->setSourceVertex(vertices[pair.first]);
+        edge->setTargetVertex(vertices[pair.second]);
+        graph->addEdge(edge);
+    }
+
+    DistanceMatrix distanceMatrix = FloydWarshall::allShortestPaths(graph, getEdgeWeight);
+    ShortestPaths shortestPaths(graph, getEdgeWeight);
+    ShortestPaths::Method methods[] = { ShortestPaths::DIJKSTRA, ShortestPaths::DELTA_STEPPING };
+    double deltas[] = { 0, 0.5, 3 };
+    for(ShortestPaths::Method method : methods)
+    {
+        for(double delta : deltas)
+        {
+            for(size_t s = 0; s < vertices.size(); s += 7)
+            {
+                const Vertex::Ptr& source = vertices[s];
+                shortestPaths.run(source, method, delta);
+                for(const Vertex::Ptr& vertex : vertices)
+                {
+                    GraphElementId id = graph->getVertexId(vertex);
+                    double distance = shortestPaths.getDistances().get(id);
+                    BOOST_REQUIRE_EQUAL(distance, (distanceMatrix[std::pair<Vertex::Ptr, Vertex::Ptr>(source, vertex)]));
+
+                    GraphElementId predecessorId = shortestPaths.getPredecessors().get(id);
+                    if(distance == std::numeric_limits<double>::infinity())
+                    {
+                        BOOST_REQUIRE_EQUAL(predecessorId, ShortestPaths::NoPredecessor);
+                    } else if(vertex == source)
+                    {
+                        BOOST_REQUIRE_EQUAL(predecessorId, id);
+                    } else {
+                        Vertex::Ptr predecessor = graph->getVertex(predecessorId);
+                        std::vector<Edge::Ptr> edges = graph->getEdges(predecessor, vertex);
+                        BOOST_REQUIRE_EQUAL(edges.size(), 1);
+                        BOOST_REQUIRE_EQUAL(shortestPaths.getDistances().get(predecessorId) + getEdgeWeight(edges[0]), distance);
+                    }
+                }
+            }
+        }
+    }
+
+    WeightedEdge::Ptr negativeEdge(new WeightedEdge(-1.0));
+    negativeEdge->setSourceVertex(vertices[0]);
+    negativeEdge->setTargetVertex(vertices[0]);
+    graph->addEdge(negativeEdge);
+    BOOST_REQUIRE_THROW(ShortestPaths(graph, getEdgeWeight), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(large_distances)
+{
+    // The distances exceed any bucket index for the given delta
+    graph_analysis::BaseGraph::Ptr graph(new graph_analysis::lemon::DirectedGraph());
+    std::vector<Vertex::Ptr> vertices;
+    for(size_t v = 0; v < 5; ++v)
+    {
+        vertices.push_back( Vertex::Ptr(new Vertex()) );
+        graph->addVertex(vertices.back());
+    }
+    double weights[] = { 1e300, 1e-300, 2e300, 1.0 };
+    for(size_t v = 1; v < vertices.size(); ++v)
+    {
+        WeightedEdge::Ptr edge(new WeightedEdge(weights[v - 1]));
+        edge->setSourceVertex(vertices[v - 1]);
+        edge->setTargetVertex(vertices[v]);
+        graph->addEdge(edge);
+    }
+    WeightedEdge::Ptr shortcut(new WeightedEdge(3e300));
+    shortcut->setSourceVertex(vertices[0]);
+    shortcut->setTargetVertex(vertices[3]);
+    graph->addEdge(shortcut);
+
+    ShortestPaths shortestPaths(graph, getEdgeWeight);
+    shortestPaths.run(vertices[0], ShortestPaths::DIJKSTRA);
+    PropertyMap<double> distances = shortestPaths.getDistances();
+    shortestPaths.run(vertices[0], ShortestPaths::DELTA_STEPPING, 1e-300);
+    for(const Vertex::Ptr& vertex : vertices)
+    {
+        GraphElementId id = graph->getVertexId(vertex);
+        BOOST_REQUIRE_EQUAL(shortestPaths.getDistances().get(id), distances.get(id));
+    }
+    BOOST_REQUIRE(distances.get(graph->getVertexId(vertices[4])) < std::numeric_limits<double>::infinity());
+}
+BOOST_AUTO_TEST_SUITE_END()
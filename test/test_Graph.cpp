@@ -1,10 +1,24 @@
 #include <boost/test/unit_test.hpp>
+#include <thread>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
 #include <graph_analysis/lemon/Graph.hpp>
 #include <graph_analysis/snap/Graph.hpp>
+#include <graph_analysis/boost_graph/DirectedGraph.hpp>
+#include <graph_analysis/csr/DirectedGraph.hpp>
+#include <graph_analysis/compressed/DirectedGraph.hpp>
+#include <graph_analysis/mapped/DirectedGraph.hpp>
+#include <graph_analysis/algorithms/BFS.hpp>
+#include <graph_analysis/algorithms/DFS.hpp>
+#include <graph_analysis/PropertyMap.hpp>
 #include <graph_analysis/filters/CommonFilters.hpp>
 #include <graph_analysis/BipartiteGraph.hpp>
 
 #include <graph_analysis/GraphIO.hpp>
+#include <graph_analysis/WeightedEdge.hpp>
 
 using namespace graph_analysis;
 
@@ -104,6 +118,51 @@ BOOST_AUTO_TEST_CASE(clone)
     }
 }
 
+BOOST_AUTO_TEST_CASE(clone_large)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        // enough elements to be cloned in multiple chunks
+        std::vector<Vertex::Ptr> vertices;
+        std::vector<Edge::Ptr> edges;
+        for(int v = 0; v < 5000; ++v)
+        {
+            vertices.push_back(Vertex::Ptr(new Vertex(std::to_string(v))));
+        }
+        for(int v = 1; v < 4000; ++v)
+        {
+            edges.push_back(Edge::Ptr(new Edge(vertices[v-1], vertices[v], std::to_string(v))));
+        }
+        graph->addVertices(vertices);
+        graph->addEdges(edges);
+        // leave a gap in the vertex ids
+        graph->removeVertex(vertices[4500]);
+
+        BaseGraph::Ptr graph_clone = graph->clone();
+        BOOST_REQUIRE_EQUAL(graph_clone->getVertexCount(), graph->getVertexCount());
+        BOOST_REQUIRE_EQUAL(graph_clone->getEdgeCount(), graph->getEdgeCount());
+
+        EdgeIterator::Ptr edgeIterator = graph_clone->getEdgeIterator();
+        while(edgeIterator->next())
+        {
+            Edge::Ptr edge = edgeIterator->current();
+            int label = std::stoi(edge->getLabel());
+            BOOST_REQUIRE(!graph->contains(edge));
+            BOOST_REQUIRE(graph_clone->contains(edge->getSourceVertex()));
+            BOOST_REQUIRE(graph_clone->contains(edge->getTargetVertex()));
+            BOOST_REQUIRE_EQUAL(edge->getSourceVertex()->getLabel(), std::to_string(label - 1));
+            BOOST_REQUIRE_EQUAL(edge->getTargetVertex()->getLabel(), std::to_string(label));
+        }
+
+        BaseGraph::Ptr sequentialClone = graph->clone(false);
+        BOOST_REQUIRE_EQUAL(sequentialClone->getVertexCount(), graph->getVertexCount());
+        BOOST_REQUIRE_EQUAL(sequentialClone->getEdgeCount(), graph->getEdgeCount());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(clone_edges)
 {
     for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
@@ -382,4 +441,977 @@ BOOST_AUTO_TEST_CASE(bipartite_graph)
 
 }
 
+BOOST_AUTO_TEST_CASE(bulk_add_remove)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        graph->reserve(100, 200);
+
+        std::vector<Vertex::Ptr> vertices;
+        for(int v = 0; v < 100; ++v)
+        {
+            vertices.push_back( Vertex::Ptr(new Vertex()) );
+        }
+
+        // A batch which lists an element twice is rejected as a whole
+        std::vector<Vertex::Ptr> duplicateVertices(2, vertices[0]);
+        BOOST_REQUIRE_THROW(graph->addVertices(duplicateVertices), std::runtime_error);
+        BOOST_REQUIRE(graph->empty());
+        BOOST_REQUIRE(!graph->contains(vertices[0]));
+
+        std::vector<GraphElementId> vertexIds = graph->addVertices(vertices);
+        BOOST_REQUIRE_EQUAL(vertexIds.size(), vertices.size());
+        for(size_t v = 0; v < vertices.size(); ++v)
+        {
+            BOOST_REQUIRE(graph->getVertex(vertexIds[v]) == vertices[v]);
+        }
+        BOOST_REQUIRE_THROW(graph->addVertices(vertices), std::runtime_error);
+
+        // Edges with existing and new vertices
+        std::vector<Edge::Ptr> edges;
+        Vertex::Ptr hub(new Vertex());
+        for(int v = 0; v < 100; ++v)
+        {
+            edges.push_back( Edge::Ptr(new Edge(vertices[v], vertices[(v+1) % 100])) );
+            edges.push_back( Edge::Ptr(new Edge(hub, vertices[v])) );
+        }
+
+        std::vector<Edge::Ptr> duplicateEdges(2, edges[0]);
+        BOOST_REQUIRE_THROW(graph->addEdges(duplicateEdges), std::runtime_error);
+        BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), 0);
+
+        std::vector<GraphElementId> edgeIds = graph->addEdges(edges);
+        BOOST_REQUIRE_EQUAL(edgeIds.size(), edges.size());
+        for(size_t e = 0; e < edges.size(); ++e)
+        {
+            BOOST_REQUIRE(graph->getEdge(edgeIds[e]) == edges[e]);
+        }
+        BOOST_REQUIRE(graph->contains(hub));
+        BOOST_REQUIRE_EQUAL(graph->getVertexCount(), 101);
+        BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), 200);
+        BOOST_REQUIRE_THROW(graph->addEdges(edges), std::runtime_error);
+
+        // Remove every second ring edge
+        std::vector<Edge::Ptr> removedEdges;
+        for(size_t e = 0; e < edges.size(); e += 4)
+        {
+            removedEdges.push_back(edges[e]);
+        }
+        BOOST_REQUIRE_THROW(graph->removeEdges(duplicateEdges), std::runtime_error);
+        BOOST_REQUIRE_THROW(graph->removeVertices(duplicateVertices), std::runtime_error);
+        BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), 200);
+        graph->removeEdges(removedEdges);
+        BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), 150);
+        for(size_t e = 0; e < edges.size(); ++e)
+        {
+            BOOST_REQUIRE_EQUAL(graph->contains(edges[e]), e % 4 != 0);
+        }
+        BOOST_REQUIRE_THROW(graph->removeEdges(removedEdges), std::runtime_error);
+
+        // Removing the hub removes all its edges
+        graph->removeVertices(std::vector<Vertex::Ptr>(1, hub));
+        BOOST_REQUIRE(!graph->contains(hub));
+        BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), 50);
+        BOOST_REQUIRE(!graph->contains(edges[1]));
+        BOOST_REQUIRE_EQUAL(graph->getOutEdges(vertices[1]).size(), 1);
+
+        // Edges behind the removed vertices remain accessible
+        graph->removeVertex(vertices[10]);
+        graph->removeVertices(std::vector<Vertex::Ptr>(1, vertices[3]));
+        BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), 48);
+        for(int v = 11; v < 99; v += 2)
+        {
+            const Edge::Ptr& edge = edges[2*v];
+            BOOST_REQUIRE(graph->getEdge(graph->getEdgeId(edge)) == edge);
+            BOOST_REQUIRE_EQUAL(graph->getOutEdges(vertices[v]).size(), 1);
+            BOOST_REQUIRE_EQUAL(graph->getInEdges(vertices[v+1]).size(), 1);
+        }
+        graph->removeEdge(edges[2*51]);
+        BOOST_REQUIRE(!graph->contains(edges[2*51]));
+        BOOST_REQUIRE(graph->getOutEdges(vertices[51]).empty());
+        BOOST_REQUIRE_EQUAL(graph->getOutEdges(vertices[53]).size(), 1);
+
+        graph->clear();
+        BOOST_REQUIRE(graph->empty());
+        BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), 0);
+        BOOST_REQUIRE(!graph->contains(vertices[0]));
+        BOOST_REQUIRE(!graph->contains(edges[2]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(freeze)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        std::vector<Vertex::Ptr> vertices;
+        for(int v = 0; v < 4; ++v)
+        {
+            Vertex::Ptr vertex(new Vertex());
+            vertices.push_back(vertex);
+            graph->addVertex(vertex);
+        }
+
+        // 0 -> 1, 0 -> 2, 2 -> 1, 1 -> 3, 0 -> 1 (parallel)
+        int links[5][2] = { {0,1}, {0,2}, {2,1}, {1,3}, {0,1} };
+        for(int e = 0; e < 5; ++e)
+        {
+            Edge::Ptr edge(new Edge(vertices[ links[e][0] ], vertices[ links[e][1] ]));
+            graph->addEdge(edge);
+        }
+
+        BaseGraph::Ptr frozen = graph->freeze();
+        BOOST_REQUIRE(frozen->getImplementationType() == BaseGraph::CSR_DIRECTED_GRAPH);
+        BOOST_REQUIRE_MESSAGE(frozen->getVertexCount() == 4, "Frozen graph: expected 4 vertices but was " << frozen->getVertexCount());
+        BOOST_REQUIRE_MESSAGE(frozen->getEdgeCount() == 5, "Frozen graph: expected 5 edges but was " << frozen->getEdgeCount());
+        BOOST_REQUIRE(frozen->order() == graph->order());
+        BOOST_REQUIRE(frozen->size() == graph->size());
+
+        csr::DirectedGraph::Ptr csrGraph = dynamic_pointer_cast<csr::DirectedGraph>(frozen);
+        BOOST_REQUIRE(csrGraph);
+
+        for(int v = 0; v < 4; ++v)
+        {
+            const Vertex::Ptr& vertex = vertices[v];
+            BOOST_REQUIRE(frozen->contains(vertex));
+            GraphElementId vertexId = frozen->getVertexId(vertex);
+            BOOST_REQUIRE(frozen->getVertex(vertexId) == vertex);
+
+            std::vector<Edge::Ptr> outEdges = frozen->getOutEdges(vertex);
+            std::vector<Edge::Ptr> inEdges = frozen->getInEdges(vertex);
+            BOOST_REQUIRE_EQUAL(outEdges.size(), graph->getOutEdges(vertex).size());
+            BOOST_REQUIRE_EQUAL(inEdges.size(), graph->getInEdges(vertex).size());
+
+            Span<GraphElementId> outNeighbours = csrGraph->getOutNeighbours(vertexId);
+            BOOST_REQUIRE_EQUAL(outNeighbours.size(), outEdges.size());
+            for(size_t n = 0; n < outEdges.size(); ++n)
+            {
+                BOOST_REQUIRE(outEdges[n]->getSourceVertex() == vertex);
+                BOOST_REQUIRE(frozen->getVertex(outNeighbours[n]) == outEdges[n]->getTargetVertex());
+            }
+
+            Span<GraphElementId> inNeighbours = csrGraph->getInNeighbours(vertexId);
+            Span<GraphElementId> inEdgeIds = csrGraph->getInEdgeIds(vertexId);
+            BOOST_REQUIRE_EQUAL(inNeighbours.size(), inEdges.size());
+            for(size_t n = 0; n < inEdges.size(); ++n)
+            {
+                BOOST_REQUIRE(frozen->getEdge(inEdgeIds[n]) == inEdges[n]);
+                BOOST_REQUIRE(frozen->getVertex(inNeighbours[n]) == inEdges[n]->getSourceVertex());
+            }
+        }
+
+        std::vector<Edge::Ptr> parallel = frozen->getEdges(vertices[0], vertices[1]);
+        BOOST_REQUIRE_EQUAL(parallel.size(), 2);
+
+        BOOST_REQUIRE_THROW(frozen->addVertex(Vertex::Ptr(new Vertex())), std::runtime_error);
+        BOOST_REQUIRE_THROW(frozen->removeEdge(parallel[0]), std::runtime_error);
+        BOOST_REQUIRE(frozen->contains(parallel[0]));
+
+        // The snapshot is not affected by changes of the original graph
+        graph->removeEdge(parallel[0]);
+        BOOST_REQUIRE(frozen->getEdgeCount() == 5);
+
+        SubGraph::Ptr subGraph = BaseGraph::getSubGraph(frozen);
+        subGraph->disable(vertices[3]);
+        BOOST_REQUIRE(subGraph->getVertexCount() == 3);
+    }
+
+    BaseGraph::Ptr graph = BaseGraph::getInstance(BaseGraph::CSR_DIRECTED_GRAPH);
+    BOOST_REQUIRE(graph->empty());
+    BOOST_REQUIRE(graph->getEdgeCount() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(snapshot)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        Vertex::Ptr v0(new Vertex());
+        Vertex::Ptr v1(new Vertex());
+        Edge::Ptr e0(new Edge(v0, v1));
+        graph->addEdge(e0);
+
+        BaseGraph::Ptr snapshot = graph->snapshot();
+        BOOST_REQUIRE(snapshot->getImplementationType() == BaseGraph::CSR_DIRECTED_GRAPH);
+        BOOST_REQUIRE(snapshot == graph->snapshot());
+        BOOST_REQUIRE(snapshot->contains(v0));
+        BOOST_REQUIRE(snapshot->contains(e0));
+        BOOST_REQUIRE(snapshot->getVertex( snapshot->getVertexId(v1) ) == v1);
+        // vertices and edges are not associated with a snapshot
+        BOOST_REQUIRE_EQUAL(v0->getGraphAssociations().size(), 1);
+
+        uint64_t version = graph->getVersion();
+        Edge::Ptr e1(new Edge(v1, v0));
+        graph->addEdge(e1);
+        BOOST_REQUIRE(graph->getVersion() > version);
+        BOOST_REQUIRE(!snapshot->contains(e1));
+        BOOST_REQUIRE(snapshot->getEdgeCount() == 1);
+
+        weak_ptr<BaseGraph> outdated = snapshot;
+        snapshot = graph->snapshot();
+        BOOST_REQUIRE(outdated.expired());
+        BOOST_REQUIRE(snapshot->getEdgeCount() == 2);
+        BOOST_REQUIRE(snapshot->getEdges(v1, v0).size() == 1);
+
+        SubGraph::Ptr subGraph = BaseGraph::getSubGraph(snapshot);
+        subGraph->disable(e0);
+        BOOST_REQUIRE(subGraph->getEdgeCount() == 1);
+
+        // readers traverse snapshots while the graph is being modified
+        std::thread writer([graph, v0, v1]()
+                {
+                    for(int e = 0; e < 500; ++e)
+                    {
+                        graph->addEdge(Edge::Ptr(new Edge(v0, v1)));
+                    }
+                });
+        std::atomic<bool> consistent(true);
+        std::vector<std::thread> readers;
+        for(int r = 0; r < 2; ++r)
+        {
+            readers.push_back(std::thread([graph, v0, &consistent]()
+                    {
+                        for(int s = 0; s < 50; ++s)
+                        {
+                            BaseGraph::Ptr snapshot = graph->snapshot();
+                            if(snapshot->getEdgeCount() != snapshot->getOutEdges(v0).size() + 1)
+                            {
+                                consistent = false;
+                            }
+                        }
+                    }));
+        }
+        writer.join();
+        for(size_t r = 0; r < readers.size(); ++r)
+        {
+            readers[r].join();
+        }
+        BOOST_REQUIRE(consistent);
+        BOOST_REQUIRE(graph->snapshot()->getEdgeCount() == 502);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(property_map)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        std::vector<Vertex::Ptr> vertices;
+        for(int v = 0; v < 100; ++v)
+        {
+            vertices.push_back(Vertex::Ptr(new Vertex()));
+        }
+        graph->addVertices(vertices);
+        Edge::Ptr edge(new Edge(vertices[0], vertices[99]));
+        graph->addEdge(edge);
+
+        BOOST_REQUIRE(graph->getVertexIdUpperBound() >= 100);
+        BOOST_REQUIRE(graph->getEdgeIdUpperBound() > graph->getEdgeId(edge));
+
+        VertexPropertyMap<double> weights(graph, -1.0);
+        VertexPropertyMap<bool> flags(graph);
+        for(int v = 0; v < 100; v += 3)
+        {
+            weights.set(vertices[v], v);
+            flags.set(vertices[v], true);
+        }
+        for(int v = 0; v < 100; ++v)
+        {
+            BOOST_REQUIRE_EQUAL(weights.get(vertices[v]), v % 3 == 0 ? v : -1.0);
+            BOOST_REQUIRE_EQUAL(flags.get(vertices[v]), v % 3 == 0);
+        }
+
+        EdgePropertyMap<int> edgeMap(graph, 0);
+        edgeMap.set(edge, 7);
+        BOOST_REQUIRE_EQUAL(edgeMap.get(edge), 7);
+
+        // grows when ids are assigned after creating the map
+        Vertex::Ptr vertex(new Vertex());
+        graph->addVertex(vertex);
+        BOOST_REQUIRE(!flags.get(vertex));
+        flags.set(vertex, true);
+        BOOST_REQUIRE(flags.get(vertex));
+
+        BOOST_REQUIRE_THROW(weights.get(Vertex::Ptr(new Vertex())), std::runtime_error);
+    }
+
+    PropertyMap<bool> bitmap(true);
+    bitmap.set(130, false);
+    BOOST_REQUIRE(bitmap.get(129) && !bitmap.get(130) && bitmap.get(131));
+    BOOST_REQUIRE_EQUAL(bitmap.size(), 131);
+}
+
+class RemappingObserver : public BaseGraphObserver
+{
+public:
+    RemappingObserver() : notifications(0) {}
+
+    void notify(const Vertex::Ptr& vertex, const EventType& event, const GraphId& origin) {}
+    void notify(const Edge::Ptr& edge, const EventType& event, const GraphId& origin) {}
+    void notify(const IdRemapping& remapping, const GraphId& origin) { ++notifications; }
+
+    int notifications;
+};
+
+BOOST_AUTO_TEST_CASE(compact)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        shared_ptr<RemappingObserver> observer(new RemappingObserver());
+        graph->addObserver(observer);
+
+        std::vector<Vertex::Ptr> vertices;
+        std::vector<Edge::Ptr> edges;
+        for(int v = 0; v < 10; ++v)
+        {
+            vertices.push_back(Vertex::Ptr(new Vertex()));
+        }
+        for(int v = 0; v < 9; ++v)
+        {
+            edges.push_back(Edge::Ptr(new Edge(vertices[v], vertices[v+1])));
+        }
+        graph->addEdges(edges);
+
+        std::vector<Vertex::Ptr> removedVertices;
+        removedVertices.push_back(vertices[2]);
+        removedVertices.push_back(vertices[5]);
+        graph->removeVertices(removedVertices);
+
+        std::vector<GraphElementId> oldIds;
+        for(int v = 0; v < 10; ++v)
+        {
+            oldIds.push_back( graph->contains(vertices[v]) ? graph->getVertexId(vertices[v]) : IdRemapping::InvalidId);
+        }
+
+        IdRemapping remapping = graph->compact();
+        if(graph->getImplementationType() == BaseGraph::LEMON_DIRECTED_GRAPH)
+        {
+            // lemon recycles its ids natively
+            BOOST_REQUIRE(remapping.empty());
+            continue;
+        }
+
+        BOOST_REQUIRE_EQUAL(observer->notifications, 1);
+        BOOST_REQUIRE_EQUAL(graph->getVertexIdUpperBound(), 8);
+        BOOST_REQUIRE_EQUAL(graph->getEdgeIdUpperBound(), 5);
+        for(int v = 0; v < 10; ++v)
+        {
+            if(v == 2 || v == 5)
+            {
+                BOOST_REQUIRE_EQUAL(remapping.getVertexId(oldIds[v]), IdRemapping::InvalidId);
+                continue;
+            }
+            GraphElementId vertexId = graph->getVertexId(vertices[v]);
+            BOOST_REQUIRE_EQUAL(remapping.getVertexId(oldIds[v]), vertexId);
+            BOOST_REQUIRE(graph->getVertex(vertexId) == vertices[v]);
+        }
+        for(size_t e = 0; e < edges.size(); ++e)
+        {
+            if(graph->contains(edges[e]))
+            {
+                BOOST_REQUIRE(graph->getEdge( graph->getEdgeId(edges[e]) ) == edges[e]);
+            }
+        }
+        BOOST_REQUIRE_EQUAL(graph->getOutEdges(vertices[6]).size(), 1);
+        BOOST_REQUIRE(graph->getOutEdges(vertices[6])[0]->getTargetVertex() == vertices[7]);
+
+        // ids of removed elements are recycled
+        graph->removeVertex(vertices[9]);
+        Vertex::Ptr vertex(new Vertex());
+        BOOST_REQUIRE_EQUAL(graph->addVertex(vertex), 7);
+    }
+}
+
+class TypedVertex : public Vertex
+{
+public:
+    virtual std::string getClassName() const { return "TypedVertex"; }
+};
+
+class DerivedTypedVertex : public TypedVertex
+{
+public:
+    virtual std::string getClassName() const { return "DerivedTypedVertex"; }
+};
+
+BOOST_AUTO_TEST_CASE(class_index)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        std::vector<Vertex::Ptr> vertices;
+        for(int v = 0; v < 3; ++v)
+        {
+            vertices.push_back(Vertex::Ptr(new Vertex()));
+            vertices.push_back(Vertex::Ptr(new TypedVertex()));
+            vertices.push_back(Vertex::Ptr(new DerivedTypedVertex()));
+        }
+        graph->addVertices(vertices);
+
+        Edge::Ptr edge(new Edge(vertices[0], vertices[1]));
+        WeightedEdge::Ptr weightedEdge0(new WeightedEdge(vertices[1], vertices[2], 1.0));
+        WeightedEdge::Ptr weightedEdge1(new WeightedEdge(vertices[2], vertices[3], 2.0));
+        graph->addEdge(edge);
+        graph->addEdge(weightedEdge0);
+
+        BOOST_REQUIRE_EQUAL(graph->getVertices<Vertex>().size(), 9);
+        BOOST_REQUIRE_EQUAL(graph->getVertices<TypedVertex>().size(), 6);
+        BOOST_REQUIRE_EQUAL(graph->getVertices<DerivedTypedVertex>().size(), 3);
+        BOOST_REQUIRE_EQUAL(graph->getEdges<WeightedEdge>().size(), 1);
+
+        // The index is maintained once it has been built
+        graph->addEdge(weightedEdge1);
+        graph->addVertex(Vertex::Ptr(new DerivedTypedVertex()));
+        BOOST_REQUIRE_EQUAL(graph->getVertices<DerivedTypedVertex>().size(), 4);
+        BOOST_REQUIRE_EQUAL(graph->getEdges<WeightedEdge>().size(), 2);
+        BOOST_REQUIRE_EQUAL(graph->getEdges<Edge>().size(), 3);
+
+        // Removing a vertex drops its incident edges
+        graph->removeVertex(vertices[2]);
+        BOOST_REQUIRE_EQUAL(graph->getVertices<DerivedTypedVertex>().size(), 3);
+        BOOST_REQUIRE_EQUAL(graph->getVertices<TypedVertex>().size(), 6);
+        BOOST_REQUIRE_EQUAL(graph->getEdges<WeightedEdge>().size(), 0);
+
+        std::vector< shared_ptr<TypedVertex> > typedVertices = graph->getVertices<TypedVertex>();
+        for(size_t v = 0; v < typedVertices.size(); ++v)
+        {
+            BOOST_REQUIRE(typedVertices[v]);
+            BOOST_REQUIRE(graph->contains(typedVertices[v]));
+        }
+
+        graph->compact();
+        BOOST_REQUIRE_EQUAL(graph->getVertices<Vertex>().size(), 9);
+        BOOST_REQUIRE_EQUAL(graph->getEdges<Edge>().size(), 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(edge_index)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        BOOST_REQUIRE(!graph->isEdgeIndexEnabled());
+        graph->setEdgeIndexEnabled(true);
+        BOOST_REQUIRE(graph->isEdgeIndexEnabled());
+
+        Vertex::Ptr hub(new Vertex());
+        std::vector<Vertex::Ptr> vertices;
+        std::vector<Edge::Ptr> edges;
+        for(int v = 0; v < 100; ++v)
+        {
+            vertices.push_back(Vertex::Ptr(new Vertex()));
+            edges.push_back(Edge::Ptr(new Edge(vertices[v], hub)));
+        }
+        graph->addEdges(edges);
+
+        // parallel edges and an edge in the opposite direction
+        Edge::Ptr parallelEdge(new Edge(vertices[0], hub));
+        Edge::Ptr reverseEdge(new Edge(hub, vertices[0]));
+        graph->addEdge(parallelEdge);
+        graph->addEdge(reverseEdge);
+
+        BOOST_REQUIRE_EQUAL(graph->getEdges(vertices[0], hub).size(), 2);
+        BOOST_REQUIRE_EQUAL(graph->getEdges(hub, vertices[0]).size(), 1);
+        BOOST_REQUIRE(graph->getEdges(hub, vertices[0])[0] == reverseEdge);
+        BOOST_REQUIRE(graph->getEdges(vertices[1], vertices[2]).empty());
+        for(int v = 1; v < 100; ++v)
+        {
+            std::vector<Edge::Ptr> found = graph->getEdges(vertices[v], hub);
+            BOOST_REQUIRE_EQUAL(found.size(), 1);
+            BOOST_REQUIRE(found[0] == edges[v]);
+        }
+
+        graph->removeEdge(parallelEdge);
+        BOOST_REQUIRE_EQUAL(graph->getEdges(vertices[0], hub).size(), 1);
+
+        BOOST_REQUIRE_EQUAL(graph->removeEdges(vertices[0], hub), 2);
+        BOOST_REQUIRE(graph->getEdges(vertices[0], hub).empty());
+        BOOST_REQUIRE(graph->getEdges(hub, vertices[0]).empty());
+
+        // incident edges are dropped along with the vertex
+        graph->removeVertex(vertices[1]);
+        Vertex::Ptr vertex(new Vertex());
+        Edge::Ptr edge(new Edge(vertex, hub));
+        graph->addEdge(edge);
+        BOOST_REQUIRE_EQUAL(graph->getEdges(vertex, hub).size(), 1);
+        BOOST_REQUIRE(graph->getEdges(vertex, hub)[0] == edge);
+
+        // the index is rebuilt after the ids have changed
+        graph->compact();
+        for(int v = 2; v < 100; ++v)
+        {
+            BOOST_REQUIRE(graph->getEdges(vertices[v], hub) == std::vector<Edge::Ptr>(1, edges[v]));
+        }
+
+        // a copy keeps the index enabled
+        BaseGraph::Ptr graphCopy = graph->copy();
+        BOOST_REQUIRE(graphCopy->isEdgeIndexEnabled());
+        BOOST_REQUIRE(graphCopy->getEdges(vertex, hub) == std::vector<Edge::Ptr>(1, edge));
+
+        graph->setEdgeIndexEnabled(false);
+        BOOST_REQUIRE(graphCopy->isEdgeIndexEnabled());
+        BOOST_REQUIRE(graph->getEdges(vertices[2], hub) == std::vector<Edge::Ptr>(1, edges[2]));
+        BOOST_REQUIRE(graph->getEdges(vertex, hub) == std::vector<Edge::Ptr>(1, edge));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(copy_on_write)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        Vertex::Ptr v0(new Vertex());
+        Vertex::Ptr v1(new Vertex());
+        Vertex::Ptr isolated(new Vertex());
+        Edge::Ptr e0(new Edge(v0, v1));
+        graph->addEdge(e0);
+        graph->addVertex(isolated);
+
+        BaseGraph::Ptr copy = graph->copy();
+        BOOST_REQUIRE(copy->getId() != graph->getId());
+        BOOST_REQUIRE_EQUAL(copy->order(), 3);
+        BOOST_REQUIRE_EQUAL(copy->size(), 1);
+        BOOST_REQUIRE(copy->contains(isolated));
+        BOOST_REQUIRE(copy->getVertex(copy->getVertexId(v0)) == v0);
+        BOOST_REQUIRE(copy->getEdge(copy->getEdgeId(e0)) == e0);
+        if(graph->getImplementationType() != BaseGraph::LEMON_DIRECTED_GRAPH)
+        {
+            // the copy-on-write graphs keep the ids, while lemon's
+            // digraphCopy assigns new ones
+            BOOST_REQUIRE_EQUAL(copy->getVertexId(v0), graph->getVertexId(v0));
+            BOOST_REQUIRE_EQUAL(copy->getEdgeId(e0), graph->getEdgeId(e0));
+        }
+
+        // modifying the copy does not affect the original
+        Vertex::Ptr v2(new Vertex());
+        Edge::Ptr e1(new Edge(v1, v2));
+        copy->addEdge(e1);
+        copy->removeVertex(isolated);
+        BOOST_REQUIRE_EQUAL(copy->order(), 3);
+        BOOST_REQUIRE_EQUAL(copy->size(), 2);
+        BOOST_REQUIRE_EQUAL(graph->order(), 3);
+        BOOST_REQUIRE_EQUAL(graph->size(), 1);
+        BOOST_REQUIRE(graph->contains(isolated));
+        BOOST_REQUIRE(!graph->contains(v2));
+        BOOST_REQUIRE(copy->getEdges(v1, v2) == std::vector<Edge::Ptr>(1, e1));
+
+        // modifying the original does not affect the copy
+        BaseGraph::Ptr secondCopy = graph->copy();
+        graph->removeEdge(e0);
+        BOOST_REQUIRE_EQUAL(graph->size(), 0);
+        BOOST_REQUIRE_EQUAL(secondCopy->size(), 1);
+        BOOST_REQUIRE(secondCopy->getEdges(v0, v1) == std::vector<Edge::Ptr>(1, e0));
+        BOOST_REQUIRE_EQUAL(copy->size(), 2);
+        BOOST_REQUIRE(copy->getEdges(v0, v1) == std::vector<Edge::Ptr>(1, e0));
+    }
+
+    {
+        boost_graph::DirectedGraph graph;
+        Vertex::Ptr v0(new Vertex());
+        Vertex::Ptr v1(new Vertex());
+        graph.addEdge(Edge::Ptr(new Edge(v0, v1)));
+
+        boost_graph::DirectedGraph copy(graph);
+        BOOST_REQUIRE(graph.isRawShared());
+        BOOST_REQUIRE(copy.isRawShared());
+        copy.addVertex(Vertex::Ptr(new Vertex()));
+        BOOST_REQUIRE(!graph.isRawShared());
+        BOOST_REQUIRE(!copy.isRawShared());
+        BOOST_REQUIRE_EQUAL(graph.order(), 2);
+        BOOST_REQUIRE_EQUAL(copy.order(), 3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(snap_bulk_load)
+{
+    snap::DirectedGraph::Ptr graph(new snap::DirectedGraph());
+
+    std::vector<Vertex::Ptr> vertices;
+    std::vector<Edge::Ptr> edges;
+    for(int v = 0; v < 10000; ++v)
+    {
+        vertices.push_back(Vertex::Ptr(new Vertex()));
+        if(v > 0)
+        {
+            edges.push_back(Edge::Ptr(new Edge(vertices[v-1], vertices[v])));
+        }
+    }
+
+    // vertices and edges are loaded as separate batches
+    std::vector<GraphElementId> vertexIds = graph->addVertices(vertices);
+    std::vector<GraphElementId> edgeIds = graph->addEdges(edges);
+    BOOST_REQUIRE_EQUAL(graph->getVertexCount(), vertices.size());
+    BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), edges.size());
+    for(size_t v = 0; v < vertices.size(); ++v)
+    {
+        BOOST_REQUIRE(graph->getVertex(vertexIds[v]) == vertices[v]);
+    }
+    for(size_t e = 0; e < edges.size(); ++e)
+    {
+        BOOST_REQUIRE(graph->getEdge(edgeIds[e]) == edges[e]);
+        BOOST_REQUIRE(graph->getSourceVertex(edges[e]) == vertices[e]);
+        BOOST_REQUIRE(graph->getTargetVertex(edges[e]) == vertices[e+1]);
+    }
+
+    // a second batch extends the populated graph
+    Vertex::Ptr vertex(new Vertex());
+    graph->addEdges(std::vector<Edge::Ptr>(1, Edge::Ptr(new Edge(vertices.back(), vertex))));
+    BOOST_REQUIRE_EQUAL(graph->getVertexCount(), vertices.size() + 1);
+    BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), edges.size() + 1);
+}
+
+BOOST_AUTO_TEST_CASE(defragment)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+        BOOST_REQUIRE_EQUAL(graph->getHoleRatio(), 0.0);
+
+        std::vector<Vertex::Ptr> vertices;
+        std::vector<Edge::Ptr> edges;
+        for(int v = 0; v < 1000; ++v)
+        {
+            vertices.push_back(Vertex::Ptr(new Vertex()));
+            if(v > 0)
+            {
+                edges.push_back(Edge::Ptr(new Edge(vertices[v-1], vertices[v])));
+            }
+        }
+        graph->addEdges(edges);
+
+        // keep only every tenth pair of vertices along with the edge in
+        // between
+        std::vector<Vertex::Ptr> removedVertices;
+        std::vector<Edge::Ptr> removedEdges;
+        for(size_t v = 0; v < vertices.size(); ++v)
+        {
+            if(v % 10 > 1)
+            {
+                removedVertices.push_back(vertices[v]);
+            }
+        }
+        for(size_t e = 0; e < edges.size(); ++e)
+        {
+            if(e % 10)
+            {
+                removedEdges.push_back(edges[e]);
+            }
+        }
+        graph->removeEdges(removedEdges);
+        graph->removeVertices(removedVertices);
+        BOOST_REQUIRE_EQUAL(graph->getVertexCount(), 200);
+        BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), 100);
+        BOOST_REQUIRE(graph->getHoleRatio() > 0.8);
+
+        std::vector<Vertex::Ptr> remainingVertices = graph->getAllVertices();
+        std::vector<Edge::Ptr> remainingEdges = graph->getAllEdges();
+
+        BOOST_REQUIRE_EQUAL(graph->defragment(0.99), 0);
+        size_t storageSize = graph->getStorageSize();
+        size_t reclaimed = graph->defragment(0.5);
+        BOOST_REQUIRE(reclaimed > 0);
+        BOOST_REQUIRE_EQUAL(graph->getStorageSize(), storageSize - reclaimed);
+        BOOST_REQUIRE_EQUAL(graph->getHoleRatio(), 0.0);
+
+        // the iteration order is kept
+        BOOST_REQUIRE(graph->getAllVertices() == remainingVertices);
+        BOOST_REQUIRE(graph->getAllEdges() == remainingEdges);
+        for(size_t e = 0; e < remainingEdges.size(); ++e)
+        {
+            const Edge::Ptr& edge = remainingEdges[e];
+            BOOST_REQUIRE(graph->getEdges(edge->getSourceVertex(), edge->getTargetVertex()) == std::vector<Edge::Ptr>(1, edge));
+        }
+
+        Vertex::Ptr vertex(new Vertex());
+        graph->addEdge(Edge::Ptr(new Edge(remainingVertices[0], vertex)));
+        BOOST_REQUIRE_EQUAL(graph->getVertexCount(), 201);
+    }
+}
+
+class DiscoveryCountVisitor : public algorithms::BFSVisitor
+{
+public:
+    DiscoveryCountVisitor() : discovered(0) {}
+    size_t discovered;
+
+    virtual void discoverVertex(const Vertex::Ptr& vertex) { (void) vertex; ++discovered; }
+};
+
+class DFSDiscoveryCountVisitor : public algorithms::DFSVisitor
+{
+public:
+    DFSDiscoveryCountVisitor() : discovered(0) {}
+    size_t discovered;
+
+    virtual void discoverVertex(const Vertex::Ptr& vertex) { (void) vertex; ++discovered; }
+};
+
+BOOST_AUTO_TEST_CASE(compressed_graph)
+{
+    BaseGraph::Ptr empty = BaseGraph::getInstance(BaseGraph::COMPRESSED_DIRECTED_GRAPH);
+    BOOST_REQUIRE(empty->empty());
+    BOOST_REQUIRE_THROW(empty->addVertex(Vertex::Ptr(new Vertex())), std::runtime_error);
+
+    // binary tree with 1000 vertices plus a long edge back to the root and
+    // a duplicate edge
+    std::vector<compressed::DirectedGraph::EdgeIds> edges;
+    for(GraphElementId v = 999; v > 0; --v)
+    {
+        edges.push_back(compressed::DirectedGraph::EdgeIds((v - 1)/2, v));
+    }
+    edges.push_back(compressed::DirectedGraph::EdgeIds(998, 0));
+    edges.push_back(compressed::DirectedGraph::EdgeIds(0, 1));
+
+    std::vector<compressed::DirectedGraph::EdgeIds> invalidEdges(1, compressed::DirectedGraph::EdgeIds(0, 1000));
+    BOOST_REQUIRE_THROW(compressed::DirectedGraph(1000, invalidEdges), std::invalid_argument);
+
+    compressed::DirectedGraph::Ptr graph(new compressed::DirectedGraph(1000, edges));
+    BOOST_REQUIRE_EQUAL(graph->getVertexCount(), 1000);
+    BOOST_REQUIRE_EQUAL(graph->getEdgeCount(), 1001);
+    BOOST_REQUIRE_MESSAGE(graph->getStorageSize() < graph->getEdgeCount()*sizeof(Edge), "Compressed graph should require less storage than the edge objects, but requires " << graph->getStorageSize() << " bytes");
+
+    std::vector<GraphElementId> neighbours = graph->getOutNeighbours(0);
+    BOOST_REQUIRE_EQUAL(neighbours.size(), 3);
+    BOOST_REQUIRE_EQUAL(neighbours[0], 1);
+    BOOST_REQUIRE_EQUAL(neighbours[1], 1);
+    BOOST_REQUIRE_EQUAL(neighbours[2], 2);
+    neighbours = graph->getInNeighbours(0);
+    BOOST_REQUIRE_EQUAL(neighbours.size(), 1);
+    BOOST_REQUIRE_EQUAL(neighbours[0], 998);
+    neighbours = graph->getInNeighbours(1);
+    BOOST_REQUIRE_EQUAL(neighbours.size(), 2);
+    BOOST_REQUIRE_EQUAL(neighbours[0], 0);
+
+    // Elements are created on demand and keep their identity
+    Vertex::Ptr root = graph->getVertex(0);
+    BOOST_REQUIRE(graph->getVertex(0) == root);
+    BOOST_REQUIRE_EQUAL(graph->getVertexId(root), 0);
+    BOOST_REQUIRE(graph->contains(root));
+
+    size_t edgeCount = 0;
+    EdgeIterator::Ptr edgeIt = graph->getEdgeIterator();
+    while(edgeIt->next())
+    {
+        const Edge::Ptr& edge = edgeIt->current();
+        GraphElementId edgeId = graph->getEdgeId(edge);
+        BOOST_REQUIRE(graph->getEdge(edgeId) == edge);
+        BOOST_REQUIRE_EQUAL(graph->getSourceVertexId(edgeId), graph->getVertexId(edge->getSourceVertex()));
+        BOOST_REQUIRE_EQUAL(graph->getTargetVertexId(edgeId), graph->getVertexId(edge->getTargetVertex()));
+        ++edgeCount;
+    }
+    BOOST_REQUIRE_EQUAL(edgeCount, 1001);
+
+    edgeCount = 0;
+    edgeIt = graph->getInEdgeIterator(graph->getVertex(1));
+    while(edgeIt->next())
+    {
+        BOOST_REQUIRE(edgeIt->current()->getSourceVertex() == root);
+        ++edgeCount;
+    }
+    BOOST_REQUIRE_EQUAL(edgeCount, 2);
+    BOOST_REQUIRE_EQUAL(graph->getEdges(root, graph->getVertex(1)).size(), 2);
+
+    shared_ptr<DiscoveryCountVisitor> visitor(new DiscoveryCountVisitor());
+    algorithms::BFS bfs(graph, visitor);
+    bfs.run(root);
+    BOOST_REQUIRE_EQUAL(visitor->discovered, 999);
+
+    shared_ptr<DFSDiscoveryCountVisitor> dfsVisitor(new DFSDiscoveryCountVisitor());
+    algorithms::DFS dfs(graph, dfsVisitor);
+    dfs.run(root);
+    BOOST_REQUIRE_EQUAL(dfsVisitor->discovered, 999);
+
+    // Materialized elements are only held while a retention is active
+    size_t retainedStorageSize = 0;
+    {
+        BaseGraph::ElementRetention retention(*graph);
+        edgeIt = graph->getEdgeIterator();
+        while(edgeIt->next())
+        {
+        }
+        retainedStorageSize = graph->getStorageSize();
+    }
+    edgeIt.reset();
+    BOOST_REQUIRE_LE(graph->getStorageSize() + graph->getEdgeCount()*sizeof(Edge), retainedStorageSize);
+
+    SubGraph::Ptr subGraph = BaseGraph::getSubGraph(graph);
+    subGraph->disable(graph->getVertex(1));
+    size_t vertexCount = 0;
+    VertexIterator::Ptr vertexIt = subGraph->getVertexIterator();
+    while(vertexIt->next())
+    {
+        ++vertexCount;
+    }
+    BOOST_REQUIRE_EQUAL(vertexCount, 999);
+
+    // Compress another graph, the data of the vertices is restored by the
+    // factory
+    BaseGraph::Ptr lemonGraph = BaseGraph::getInstance(BaseGraph::LEMON_DIRECTED_GRAPH);
+    Vertex::Ptr v0(new Vertex("v0"));
+    Vertex::Ptr v1(new Vertex("v1"));
+    lemonGraph->addEdge(Edge::Ptr(new Edge(v0, v1)));
+    std::vector<Vertex::Ptr> lemonVertices = lemonGraph->getAllVertices();
+    compressed::DirectedGraph compressedGraph(*lemonGraph, [&lemonVertices](GraphElementId id)
+            {
+                return Vertex::Ptr(new Vertex(lemonVertices[id]->getLabel()));
+            });
+    BOOST_REQUIRE_EQUAL(compressedGraph.getVertexCount(), 2);
+    BOOST_REQUIRE_EQUAL(compressedGraph.getEdgeCount(), 1);
+    Edge::Ptr edge = compressedGraph.getEdge(0);
+    BOOST_REQUIRE_EQUAL(edge->getSourceVertex()->getLabel(), "v0");
+    BOOST_REQUIRE_EQUAL(edge->getTargetVertex()->getLabel(), "v1");
+
+    // The factory may access the graph it creates the vertex for
+    const compressed::DirectedGraph* factoryGraph = NULL;
+    compressed::DirectedGraph reentrantGraph(*lemonGraph, [&factoryGraph](GraphElementId id)
+            {
+                if(id == 1)
+                {
+                    return Vertex::Ptr(new Vertex(factoryGraph->getVertex(0)->getLabel() + "'"));
+                }
+                return Vertex::Ptr(new Vertex("v0"));
+            });
+    factoryGraph = &reentrantGraph;
+    BOOST_REQUIRE_EQUAL(reentrantGraph.getVertex(1)->getLabel(), "v0'");
+
+    graph->releaseElements();
+    BOOST_REQUIRE(!graph->contains(root));
+    BOOST_REQUIRE(graph->getVertex(0) != root);
+}
+
+BOOST_AUTO_TEST_CASE(mapped_graph)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance(BaseGraph::LEMON_DIRECTED_GRAPH);
+    std::vector<Vertex::Ptr> vertices;
+    for(int v = 0; v < 100; ++v)
+    {
+        std::stringstream ss;
+        ss << "v" << v;
+        vertices.push_back(Vertex::Ptr(new Vertex(ss.str())));
+    }
+    graph->addVertices(vertices);
+    for(int v = 1; v < 100; ++v)
+    {
+        std::stringstream ss;
+        ss << "e" << v;
+        graph->addEdge(Edge::Ptr(new Edge(vertices[(v - 1)/2], vertices[v], ss.str())));
+    }
+    graph->addEdge(Edge::Ptr(new WeightedEdge(vertices[99], vertices[0], 1.0)));
+
+    std::string filename = "/tmp/test-mapped-graph.mapped";
+    mapped::DirectedGraph::write(filename, *graph);
+
+    mapped::DirectedGraph::Ptr mappedGraph(new mapped::DirectedGraph(filename));
+    BOOST_REQUIRE(mappedGraph->getImplementationType() == BaseGraph::MAPPED_DIRECTED_GRAPH);
+    BOOST_REQUIRE_EQUAL(mappedGraph->getVertexCount(), 100);
+    BOOST_REQUIRE_EQUAL(mappedGraph->getEdgeCount(), 100);
+
+    // Vertices are numbered in the iteration order of the written graph,
+    // elements are restored from their class and label
+    std::vector<Vertex::Ptr> graphVertices = graph->getAllVertices();
+    for(size_t v = 0; v < graphVertices.size(); ++v)
+    {
+        BOOST_REQUIRE_EQUAL(mappedGraph->getVertex(v)->getLabel(), graphVertices[v]->getLabel());
+    }
+
+    size_t weightedEdges = 0;
+    EdgeIterator::Ptr edgeIt = mappedGraph->getEdgeIterator();
+    while(edgeIt->next())
+    {
+        const Edge::Ptr& edge = edgeIt->current();
+        std::string sourceLabel = edge->getSourceVertex()->getLabel();
+        std::string targetLabel = edge->getTargetVertex()->getLabel();
+        if(edge->getClassName() == WeightedEdge().getClassName())
+        {
+            ++weightedEdges;
+            BOOST_REQUIRE_EQUAL(sourceLabel, "v99");
+            BOOST_REQUIRE_EQUAL(targetLabel, "v0");
+        } else {
+            BOOST_REQUIRE_EQUAL("e" + targetLabel.substr(1), edge->getLabel());
+        }
+    }
+    BOOST_REQUIRE_EQUAL(weightedEdges, 1);
+
+    shared_ptr<DiscoveryCountVisitor> visitor(new DiscoveryCountVisitor());
+    algorithms::BFS bfs(mappedGraph, visitor);
+    bfs.run(mappedGraph->getVertex(0));
+    BOOST_REQUIRE_EQUAL(visitor->discovered, 99);
+
+    // Copies share the mapped file
+    BaseGraph::Ptr copy = mappedGraph->copy();
+    mappedGraph.reset();
+    BOOST_REQUIRE_EQUAL(copy->getEdgeCount(), 100);
+    BOOST_REQUIRE_EQUAL(copy->getVertex(1)->getLabel(), graphVertices[1]->getLabel());
+
+    std::string invalidFilename = "/tmp/test-mapped-graph-invalid.mapped";
+    {
+        std::ofstream out(invalidFilename.c_str());
+        out << "not a graph file";
+    }
+    BOOST_REQUIRE_THROW(mapped::DirectedGraph invalid(invalidFilename), std::runtime_error);
+    BOOST_REQUIRE_THROW(mapped::DirectedGraph missing("/tmp/test-mapped-graph-does-not-exist"), std::runtime_error);
+
+    // Corrupt encoded lists and offsets are detected on access
+    std::string corruptFilename = "/tmp/test-mapped-graph-corrupt.mapped";
+    {
+        std::ifstream in(filename.c_str(), std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        // The header starts with magic, version, id size, order and size,
+        // followed by the offsets and sizes of the 13 sections
+        const size_t sectionOffsets = 32;
+        const size_t sectionSizes = sectionOffsets + 13*sizeof(uint64_t);
+        uint64_t outDataOffset, outDataSize, inOffsetsOffset;
+        memcpy(&outDataOffset, data.data() + sectionOffsets + 2*sizeof(uint64_t), sizeof(uint64_t));
+        memcpy(&outDataSize, data.data() + sectionSizes + 2*sizeof(uint64_t), sizeof(uint64_t));
+        memcpy(&inOffsetsOffset, data.data() + sectionOffsets + 3*sizeof(uint64_t), sizeof(uint64_t));
+        // Unterminated varints and an in list exceeding the in data
+        std::fill(data.begin() + outDataOffset, data.begin() + outDataOffset + outDataSize, '\xff');
+        uint64_t invalidOffset = std::numeric_limits<uint64_t>::max();
+        memcpy(&data[inOffsetsOffset + sizeof(uint64_t)], &invalidOffset, sizeof(uint64_t));
+
+        std::ofstream out(corruptFilename.c_str(), std::ios::binary);
+        out << data;
+    }
+    mapped::DirectedGraph corrupt(corruptFilename);
+    BOOST_REQUIRE_EQUAL(corrupt.getVertexCount(), 100);
+    EdgeIterator::Ptr corruptEdgeIt = corrupt.getEdgeIterator();
+    BOOST_REQUIRE_THROW(while(corruptEdgeIt->next()) {}, std::runtime_error);
+    BOOST_REQUIRE_THROW(corrupt.getInEdgeIterator(corrupt.getVertex(0)), std::runtime_error);
+    BOOST_REQUIRE_THROW(corrupt.getInNeighbours(0), std::runtime_error);
+
+    // An order or size which would wrap the expected section sizes is
+    // rejected when opening
+    for(size_t field = 16; field <= 24; field += 8)
+    {
+        std::ifstream in(filename.c_str(), std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        uint64_t invalidCount = std::numeric_limits<uint64_t>::max();
+        memcpy(&data[field], &invalidCount, sizeof(uint64_t));
+        {
+            std::ofstream out(corruptFilename.c_str(), std::ios::binary);
+            out << data;
+        }
+        BOOST_REQUIRE_THROW(mapped::DirectedGraph wrapped(corruptFilename), std::runtime_error);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,7 @@
 #include <boost/test/unit_test.hpp>
 #include <graph_analysis/GraphElement.hpp>
 #include <graph_analysis/Vertex.hpp>
+#include <thread>
 
 using namespace graph_analysis;
 
@@ -31,4 +32,90 @@ BOOST_AUTO_TEST_CASE(registration)
     BOOST_REQUIRE_THROW(GraphElement::fromUuid(uuid0), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(graph_associations)
+{
+    Vertex::Ptr v0 = make_shared<Vertex>("v0");
+    BOOST_REQUIRE(v0->getGraphAssociations().empty());
+    BOOST_REQUIRE_THROW(v0->getId(0), std::runtime_error);
+
+    // inline slots and spilled associations
+    for(GraphId graph = 0; graph < 5; ++graph)
+    {
+        v0->associate(graph, 10 + graph);
+    }
+    v0->associate(3, 42);
+
+    BOOST_REQUIRE_EQUAL(v0->getGraphAssociations().size(), 5);
+    BOOST_REQUIRE_EQUAL(v0->getId(0), 10);
+    BOOST_REQUIRE_EQUAL(v0->getId(3), 42);
+    BOOST_REQUIRE_EQUAL(v0->getId(4), 14);
+
+    v0->disassociate(0);
+    BOOST_REQUIRE(!v0->associated(0));
+    BOOST_REQUIRE_THROW(v0->getId(0), std::runtime_error);
+    for(GraphId graph = 1; graph < 5; ++graph)
+    {
+        BOOST_REQUIRE(v0->associated(graph));
+    }
+    BOOST_REQUIRE_EQUAL(v0->getId(3), 42);
+
+    GraphIdList graphs = v0->getGraphAssociations();
+    BOOST_REQUIRE_EQUAL(graphs.size(), 4);
+    BOOST_REQUIRE_EQUAL(graphs.front(), 1);
+    BOOST_REQUIRE_EQUAL(graphs.back(), 4);
+
+    // Removing inline associations refills them from the spilled ones
+    v0->disassociate(1);
+    v0->disassociate(4);
+    BOOST_REQUIRE_EQUAL(v0->getGraphAssociations().size(), 2);
+    BOOST_REQUIRE_EQUAL(v0->getId(2), 12);
+    BOOST_REQUIRE_EQUAL(v0->getId(3), 42);
+    v0->associate(1, 11);
+    BOOST_REQUIRE_EQUAL(v0->getId(1), 11);
+    BOOST_REQUIRE_EQUAL(v0->getGraphAssociations().size(), 3);
+
+    Vertex::Ptr v1 = v0->clone();
+    BOOST_REQUIRE(v1->getGraphAssociations().empty());
+    BOOST_REQUIRE(v0->associated(2));
+}
+
+BOOST_AUTO_TEST_CASE(lazy_uuid)
+{
+    Vertex::Ptr v0 = make_shared<Vertex>("v0");
+    GraphElementUuid uuid0 = v0->getUuid();
+    BOOST_REQUIRE(!uuid0.is_nil());
+    BOOST_REQUIRE(v0->getUuid() == uuid0);
+    BOOST_REQUIRE(GraphElement::fromUuid(uuid0) == v0);
+
+    {
+        // a clone shares the uuid, but must not unregister the original
+        Vertex::Ptr v1 = v0->clone();
+        BOOST_REQUIRE(v1->getUuid() == uuid0);
+    }
+    BOOST_REQUIRE(GraphElement::fromUuid(uuid0) == v0);
+
+    // elements on the stack cannot be retrieved
+    Vertex v2("v2");
+    BOOST_REQUIRE(!v2.getUuid().is_nil());
+    BOOST_REQUIRE_THROW(GraphElement::fromUuid(v2.getUuid()), std::invalid_argument);
+
+    // concurrent first requests agree on a single uuid
+    Vertex::Ptr v3 = make_shared<Vertex>("v3");
+    std::vector<GraphElementUuid> uuids(8);
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < uuids.size(); ++t)
+    {
+        threads.push_back(std::thread([&uuids, &v3, t]() { uuids[t] = v3->getUuid(); }));
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    for(const GraphElementUuid& uuid : uuids)
+    {
+        BOOST_REQUIRE(uuid == v3->getUuid());
+    }
+    BOOST_REQUIRE(GraphElement::fromUuid(uuids.front()) == v3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
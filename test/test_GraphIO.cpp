@@ -827,9 +827,30 @@ BOOST_AUTO_TEST_CASE(graphml)
     }
 }
 
+BOOST_AUTO_TEST_CASE(mapped)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance();
+    Vertex::Ptr v0 = make_shared<Vertex>("v0");
+    Vertex::Ptr v1 = make_shared<Vertex>("v1");
+    Edge::Ptr e0 = make_shared<Edge>(v0, v1, "e0");
+    graph->addEdge(e0);
+
+    std::string filename = io::GraphIO::write("/tmp/graph_analysis-test-graph_io", graph, representation::MAPPED);
+
+    BaseGraph::Ptr readGraph = BaseGraph::getInstance();
+    io::GraphIO::read(filename, readGraph);
+    BOOST_REQUIRE_EQUAL(readGraph->order(), 2);
+    BOOST_REQUIRE_EQUAL(readGraph->size(), 1);
+
+    EdgeIterator::Ptr edgeIt = readGraph->getEdgeIterator();
+    BOOST_REQUIRE(edgeIt->next());
+    BOOST_REQUIRE_EQUAL(edgeIt->current()->getLabel(), "e0");
+    BOOST_REQUIRE_EQUAL(edgeIt->current()->getSourceVertex()->getLabel(), "v0");
+}
+
 BOOST_AUTO_TEST_CASE(identify_file_type)
 {
-    std::vector<std::string> suffixes = { "dot", "gexf", "graphml" };
+    std::vector<std::string> suffixes = { "dot", "gexf", "graphml", "mapped" };
     for(const std::string& suffix : suffixes)
     {
         representation::Type representationType = io::GraphIO::getTypeFromSuffix(suffix);
@@ -1,6 +1,7 @@
 #include <boost/test/unit_test.hpp>
 #include <graph_analysis/BaseGraph.hpp>
 #include <graph_analysis/DirectedGraphInterface.hpp>
+#include <set>
 
 using namespace graph_analysis;
 
@@ -167,5 +168,71 @@ BOOST_AUTO_TEST_CASE(stl_like)
     }
 }
 
+BOOST_AUTO_TEST_CASE(batch)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+
+        size_t numberOfVertices = 600;
+        std::vector<Vertex::Ptr> vertices;
+        for(size_t v = 0; v < numberOfVertices; ++v)
+        {
+            Vertex::Ptr vertex(new Vertex());
+            graph->addVertex(vertex);
+            vertices.push_back(vertex);
+        }
+        for(size_t v = 1; v < numberOfVertices; ++v)
+        {
+            Edge::Ptr edge(new Edge(vertices[v-1], vertices[v]));
+            graph->addEdge(edge);
+        }
+
+        {
+            std::set<Vertex::Ptr> seen;
+            std::vector<Vertex::Ptr> batch(256);
+            VertexIterator::Ptr vertexIt = graph->getVertexIterator();
+            size_t count = 0;
+            while( (count = vertexIt->nextBatch(&batch[0], batch.size())) != 0)
+            {
+                BOOST_REQUIRE_MESSAGE(count == 256 || seen.size() + count == numberOfVertices, "Batch of size " << count << " for graph type " << i);
+                BOOST_REQUIRE_MESSAGE(vertexIt->current() == batch[count - 1], "Current vertex should be the last of the batch");
+                seen.insert(batch.begin(), batch.begin() + count);
+            }
+            BOOST_REQUIRE_MESSAGE(seen.size() == numberOfVertices, "Expected " << numberOfVertices << " vertices, but got " << seen.size());
+        }
+
+        {
+            std::set<Edge::Ptr> seen;
+            std::vector<Edge::Ptr> batch(100);
+            EdgeIterator::Ptr edgeIt = graph->getEdgeIterator();
+            size_t count = 0;
+            while( (count = edgeIt->nextBatch(&batch[0], batch.size())) != 0)
+            {
+                seen.insert(batch.begin(), batch.begin() + count);
+            }
+            BOOST_REQUIRE_MESSAGE(seen.size() == numberOfVertices - 1, "Expected " << numberOfVertices - 1 << " edges, but got " << seen.size());
+        }
+
+        {
+            size_t vertexCount = 0;
+            for(Vertex::Ptr vertex : graph->vertices())
+            {
+                BOOST_REQUIRE(vertex);
+                ++vertexCount;
+            }
+            BOOST_REQUIRE_EQUAL(vertexCount, numberOfVertices);
+
+            size_t edgeCount = 0;
+            for(Edge::Ptr edge : graph->edges())
+            {
+                BOOST_REQUIRE(edge);
+                ++edgeCount;
+            }
+            BOOST_REQUIRE_EQUAL(edgeCount, numberOfVertices - 1);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -1,10 +1,59 @@
 #include <boost/test/unit_test.hpp>
 #include <graph_analysis/TransactionObserver.hpp>
+#include <graph_analysis/BaseGraph.hpp>
+#include <graph_analysis/BackendMirror.hpp>
 
 using namespace graph_analysis;
 
 BOOST_AUTO_TEST_SUITE(observer)
 
+class CountingObserver : public BaseGraphObserver
+{
+public:
+    CountingObserver()
+        : vertexNotifications(0)
+        , edgeNotifications(0)
+        , vertexBatchNotifications(0)
+        , edgeBatchNotifications(0)
+        , vertices(0)
+        , edges(0)
+    {}
+
+    void notify(const Vertex::Ptr& vertex, const EventType& event, const GraphId& origin)
+    {
+        ++vertexNotifications;
+        vertices += (event == EVENT_TYPE_ADDED ? 1 : -1);
+    }
+
+    void notify(const Edge::Ptr& edge, const EventType& event, const GraphId& origin)
+    {
+        ++edgeNotifications;
+        edges += (event == EVENT_TYPE_ADDED ? 1 : -1);
+    }
+
+    void notify(const std::vector<Vertex::Ptr>& batch, const EventType& event, const GraphId& origin)
+    {
+        ++vertexBatchNotifications;
+        vertices += (event == EVENT_TYPE_ADDED ? 1 : -1)*static_cast<int>(batch.size());
+    }
+
+    void notify(const std::vector<Edge::Ptr>& batch, const EventType& event, const GraphId& origin)
+    {
+        ++edgeBatchNotifications;
+        edges += (event == EVENT_TYPE_ADDED ? 1 : -1)*static_cast<int>(batch.size());
+    }
+
+    void notify(const TransactionType& event, const GraphId& origin)
+    {}
+
+    int vertexNotifications;
+    int edgeNotifications;
+    int vertexBatchNotifications;
+    int edgeBatchNotifications;
+    int vertices;
+    int edges;
+};
+
 BOOST_AUTO_TEST_CASE(transactionObserver)
 {
     BaseGraphObserver::Ptr ptr( new BaseGraphObserver() );
@@ -13,4 +62,94 @@ BOOST_AUTO_TEST_CASE(transactionObserver)
     // TODO do some actual testing
 }
 
+BOOST_AUTO_TEST_CASE(batch_notification)
+{
+    for(int i = BaseGraph::BOOST_DIRECTED_GRAPH; i < BaseGraph::IMPLEMENTATION_TYPE_END; ++i)
+    {
+        BaseGraph::Ptr graph = BaseGraph::getInstance(static_cast<BaseGraph::ImplementationType>(i));
+        BOOST_TEST_MESSAGE("BaseGraph implementation: " << graph->getImplementationTypeName());
+
+        shared_ptr<CountingObserver> observer(new CountingObserver());
+        graph->addObserver(observer);
+
+        std::vector<Edge::Ptr> edges;
+        for(int e = 0; e < 10; ++e)
+        {
+            edges.push_back( Edge::Ptr(new Edge(Vertex::Ptr(new Vertex()), Vertex::Ptr(new Vertex()))) );
+        }
+
+        graph->addEdges(edges);
+        BOOST_REQUIRE_EQUAL(observer->vertexBatchNotifications, 1);
+        BOOST_REQUIRE_EQUAL(observer->edgeBatchNotifications, 1);
+        BOOST_REQUIRE_EQUAL(observer->vertices, 20);
+        BOOST_REQUIRE_EQUAL(observer->edges, 10);
+
+        graph->clear();
+        BOOST_REQUIRE_EQUAL(observer->vertexBatchNotifications, 2);
+        BOOST_REQUIRE_EQUAL(observer->edgeBatchNotifications, 2);
+        BOOST_REQUIRE_EQUAL(observer->vertexNotifications, 0);
+        BOOST_REQUIRE_EQUAL(observer->edgeNotifications, 0);
+        BOOST_REQUIRE_EQUAL(observer->vertices, 0);
+        BOOST_REQUIRE_EQUAL(observer->edges, 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(backend_mirror)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance(BaseGraph::BOOST_DIRECTED_GRAPH);
+    Vertex::Ptr v0(new Vertex());
+    Vertex::Ptr v1(new Vertex());
+    Edge::Ptr e0(new Edge(v0, v1));
+    graph->addEdge(e0);
+
+    BackendMirror::Ptr lemonMirror = BackendMirror::getInstance(graph, BaseGraph::LEMON_DIRECTED_GRAPH);
+    BackendMirror::Ptr csrMirror = BackendMirror::getInstance(graph, BaseGraph::CSR_DIRECTED_GRAPH);
+    const BaseGraph::Ptr& mirror = lemonMirror->getMirror();
+    BOOST_REQUIRE_EQUAL(mirror->getImplementationType(), BaseGraph::LEMON_DIRECTED_GRAPH);
+    BOOST_REQUIRE_EQUAL(mirror->getVertexCount(), 2);
+    BOOST_REQUIRE_EQUAL(mirror->getEdgeCount(), 1);
+    BOOST_REQUIRE(mirror->contains(e0));
+
+    BaseGraph::Ptr csr = csrMirror->getMirror();
+    BOOST_REQUIRE_EQUAL(csr->getImplementationType(), BaseGraph::CSR_DIRECTED_GRAPH);
+    BOOST_REQUIRE_EQUAL(csr->getEdgeCount(), 1);
+    BOOST_REQUIRE(csrMirror->getMirror() == csr);
+
+    // single and batch modifications are forwarded
+    Edge::Ptr e1(new Edge(v1, v0));
+    graph->addEdge(e1);
+    BOOST_REQUIRE(mirror->contains(e1));
+    BOOST_REQUIRE(mirror->isConnected());
+
+    std::vector<Vertex::Ptr> vertices;
+    std::vector<Edge::Ptr> edges;
+    for(int i = 0; i < 10; ++i)
+    {
+        vertices.push_back(Vertex::Ptr(new Vertex()));
+        edges.push_back(Edge::Ptr(new Edge(v0, vertices.back())));
+    }
+    graph->addEdges(edges);
+    BOOST_REQUIRE_EQUAL(mirror->getVertexCount(), 12);
+    BOOST_REQUIRE_EQUAL(mirror->getEdgeCount(), 12);
+
+    graph->removeEdges(edges);
+    graph->removeVertices(vertices);
+    graph->removeEdge(e0);
+    BOOST_REQUIRE_EQUAL(mirror->getVertexCount(), 2);
+    BOOST_REQUIRE_EQUAL(mirror->getEdgeCount(), 1);
+    BOOST_REQUIRE(!mirror->contains(e0));
+    BOOST_REQUIRE(lemonMirror->getMirror() == mirror);
+
+    // the read-only mirror is rebuilt on demand
+    BaseGraph::Ptr updatedCsr = csrMirror->getMirror();
+    BOOST_REQUIRE(updatedCsr != csr);
+    BOOST_REQUIRE_EQUAL(updatedCsr->getVertexCount(), 2);
+    BOOST_REQUIRE_EQUAL(updatedCsr->getEdgeCount(), 1);
+    BOOST_REQUIRE(updatedCsr->contains(e1));
+
+    graph->removeObserver(lemonMirror);
+    graph->removeVertex(v0);
+    BOOST_REQUIRE(mirror->contains(v0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
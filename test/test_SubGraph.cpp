@@ -1,8 +1,30 @@
 #include <boost/test/unit_test.hpp>
 #include <graph_analysis/BaseGraph.hpp>
+#include <graph_analysis/filters/RegexFilters.hpp>
 
 using namespace graph_analysis;
 
+namespace {
+
+class TypedVertex : public Vertex
+{
+public:
+    virtual std::string getClassName() const { return "TypedVertex"; }
+};
+
+size_t countVertices(const SubGraph::Ptr& subgraph)
+{
+    size_t count = 0;
+    VertexIterator::Ptr vertexIterator = subgraph->getVertexIterator();
+    while(vertexIterator->next())
+    {
+        ++count;
+    }
+    return count;
+}
+
+} // end anonymous namespace
+
 BOOST_AUTO_TEST_SUITE(subgraph_test_suite)
 
 BOOST_AUTO_TEST_CASE(create_sub_graph)
@@ -88,4 +110,37 @@ BOOST_AUTO_TEST_CASE(create_sub_graph)
     }
 }
 
+BOOST_AUTO_TEST_CASE(class_filter)
+{
+    BaseGraph::Ptr graph = BaseGraph::getInstance(BaseGraph::LEMON_DIRECTED_GRAPH);
+    for(int v = 0; v < 3; ++v)
+    {
+        graph->addVertex(Vertex::Ptr(new Vertex()));
+        graph->addVertex(Vertex::Ptr(new TypedVertex()));
+    }
+    graph->addVertex(Vertex::Ptr(new TypedVertex()));
+
+    Filter<Vertex::Ptr>::Ptr classFilter(new filters::VertexRegexFilter("TypedVertex", filters::CLASS, false));
+    Filter<Vertex::Ptr>::Ptr invertedFilter(new filters::VertexRegexFilter("TypedVertex", filters::CLASS, true));
+    Filter<Vertex::Ptr>::Ptr contentFilter(new filters::VertexRegexFilter(".*", filters::CONTENT, false));
+    BOOST_REQUIRE(classFilter->dependsOnClassOnly());
+    BOOST_REQUIRE(!contentFilter->dependsOnClassOnly());
+
+    // The result does not depend on whether the class index is available
+    for(int indexed = 0; indexed < 2; ++indexed)
+    {
+        if(indexed)
+        {
+            BOOST_REQUIRE_EQUAL(graph->getVertices<TypedVertex>().size(), 4);
+        }
+
+        SubGraph::Ptr subgraph = BaseGraph::getSubGraph(graph);
+        subgraph->applyFilters(classFilter, Filter<Edge::Ptr>::Null());
+        BOOST_REQUIRE_EQUAL(countVertices(subgraph), 3);
+
+        subgraph->applyFilters(invertedFilter, Filter<Edge::Ptr>::Null());
+        BOOST_REQUIRE_EQUAL(countVertices(subgraph), 4);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
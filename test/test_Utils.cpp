@@ -3,6 +3,11 @@
 
 #include <boost/test/unit_test.hpp>
 #include <graph_analysis/utils/MD5.hpp>
+#include <graph_analysis/utils/Parallel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
 #include "test_utils.hpp"
 
 BOOST_AUTO_TEST_SUITE(utils)
@@ -16,6 +21,43 @@ BOOST_AUTO_TEST_CASE(md5sum)
             "Md5Sum should be available was '" << md5sum << "'");
 }
 
+BOOST_AUTO_TEST_CASE(parallel_chunks)
+{
+    using namespace graph_analysis::utils;
+
+    std::vector<int> visits(10000, 0);
+    std::atomic<size_t> chunks(0);
+    Parallel::forEachChunk(visits.size(), [&](size_t begin, size_t end)
+    {
+        ++chunks;
+        for(size_t i = begin; i < end; ++i)
+        {
+            ++visits[i];
+        }
+    }, 100);
+    BOOST_REQUIRE(chunks <= Parallel::getNumberOfThreads());
+    BOOST_REQUIRE(std::count(visits.begin(), visits.end(), 1) == static_cast<int>(visits.size()));
+
+    BOOST_REQUIRE_THROW(Parallel::forEachChunk(visits.size(), [&](size_t begin, size_t end)
+    {
+        if(end == visits.size())
+        {
+            throw std::runtime_error("last chunk failed");
+        }
+    }, 100), std::runtime_error);
+
+    // chunks can be processed in parallel themselves
+    std::atomic<size_t> innerVisits(0);
+    Parallel::forEachChunk(visits.size(), [&](size_t begin, size_t end)
+    {
+        Parallel::forEachChunk(end - begin, [&](size_t innerBegin, size_t innerEnd)
+        {
+            innerVisits += innerEnd - innerBegin;
+        }, 10);
+    }, 100);
+    BOOST_REQUIRE_EQUAL(innerVisits, visits.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 #endif
 